@@ -47,9 +47,14 @@ task.h is included from an application file. */
 
 #include "FreeRTOS.h"
 #include "task.h"
+#include "heap_infinitime.h"
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#if( configHEAP_PROFILER == 1 )
+ #include <libraries/log/nrf_log.h>
+#endif
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
  #error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -113,6 +118,27 @@ application.  When the bit is free the block is still part of the free heap
 space. */
 static size_t xBlockAllocatedBit = 0;
 
+#if( configHEAP_PROFILER == 1 )
+ /* The tag of an allocated block is kept in the bits 24 to 30 of its size,
+ the heap being much smaller than 16MB. */
+ #define heapTAG_SHIFT 24
+ #define heapTAG_MASK ( ( size_t ) HEAP_TAG_MAX << heapTAG_SHIFT )
+
+ static HeapTagStats_t xTagStats[ HEAP_PROFILER_MAX_TAGS ];
+ static size_t xNbTags = 0;
+
+ /* Cleared by main() when the content of the .noinit section is not valid */
+ static HeapFailure_t xLastFailure __attribute__((section(".noinit")));
+
+ static uint8_t prvGetCurrentTag( void );
+ static HeapTagStats_t *prvGetTagStats( uint8_t ucTag );
+#else
+ #define heapTAG_MASK ( ( size_t ) 0 )
+#endif
+
+/* Size of a block, without the allocated bit and the tag */
+#define heapBLOCK_SIZE( xBlockSize ) ( ( xBlockSize ) & ~( xBlockAllocatedBit | heapTAG_MASK ) )
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
@@ -229,6 +255,20 @@ void *pvPortMalloc( size_t xWantedSize )
            mtCOVERAGE_TEST_MARKER();
          }
 
+         #if( configHEAP_PROFILER == 1 )
+         {
+           uint8_t ucTag = prvGetCurrentTag();
+           HeapTagStats_t *pxStats = prvGetTagStats( ucTag );
+           pxStats->usLiveBlocks++;
+           pxStats->ulLiveBytes += pxBlock->xBlockSize;
+           if( pxStats->ulLiveBytes > pxStats->ulPeakBytes )
+           {
+             pxStats->ulPeakBytes = pxStats->ulLiveBytes;
+           }
+           pxBlock->xBlockSize |= ( size_t ) ucTag << heapTAG_SHIFT;
+         }
+         #endif
+
          /* The block is being returned - it is allocated and owned
          by the application and has no "next" block. */
          pxBlock->xBlockSize |= xBlockAllocatedBit;
@@ -250,6 +290,18 @@ void *pvPortMalloc( size_t xWantedSize )
    }
 
    traceMALLOC( pvReturn, xWantedSize );
+
+   #if( configHEAP_PROFILER == 1 )
+   {
+     if( pvReturn == NULL )
+     {
+       xLastFailure.ulFailures++;
+       xLastFailure.ulRequestedSize = xWantedSize;
+       xLastFailure.ulTag = prvGetCurrentTag();
+       vPortGetHeapSnapshot( &xLastFailure.xSnapshot );
+     }
+   }
+   #endif
  }
  ( void ) xTaskResumeAll();
 
@@ -294,12 +346,20 @@ void vPortFree( void *pv )
    {
      if( pxLink->pxNextFreeBlock == NULL )
      {
-       /* The block is being returned to the heap - it is no longer
-       allocated. */
-       pxLink->xBlockSize &= ~xBlockAllocatedBit;
-
        vTaskSuspendAll();
        {
+         #if( configHEAP_PROFILER == 1 )
+         {
+           HeapTagStats_t *pxStats = prvGetTagStats( ( uint8_t ) ( ( pxLink->xBlockSize & heapTAG_MASK ) >> heapTAG_SHIFT ) );
+           pxStats->usLiveBlocks--;
+           pxStats->ulLiveBytes -= heapBLOCK_SIZE( pxLink->xBlockSize );
+         }
+         #endif
+
+         /* The block is being returned to the heap - it is no longer
+         allocated. */
+         pxLink->xBlockSize = heapBLOCK_SIZE( pxLink->xBlockSize );
+
          /* Add this block to the list of free blocks. */
          xFreeBytesRemaining += pxLink->xBlockSize;
          traceFREE( pv, pxLink->xBlockSize );
@@ -474,7 +534,7 @@ void* pvPortRealloc(void* pv, size_t xWantedSize) {
  // Check allocate block
  if ((pxLink->xBlockSize & xBlockAllocatedBit) != 0) {
    // The block is being returned to the heap - it is no longer allocated.
-   block_size = (pxLink->xBlockSize & ~xBlockAllocatedBit) - xHeapStructSize;
+   block_size = heapBLOCK_SIZE(pxLink->xBlockSize) - xHeapStructSize;
 
    // Allocate a new buffer
    pvReturn = pvPortMalloc(xWantedSize);
@@ -499,4 +559,126 @@ void* pvPortRealloc(void* pv, size_t xWantedSize) {
  }
 
  return pvReturn;
-}
\ No newline at end of file
+}
+
+/*-----------------------------------------------------------*/
+
+void vPortGetHeapSnapshot( HeapSnapshot_t *pxSnapshot )
+{
+ BlockLink_t *pxBlock;
+ size_t xBucket;
+
+ memset( pxSnapshot, 0, sizeof( HeapSnapshot_t ) );
+
+ vTaskSuspendAll();
+ {
+   if( pxEnd != NULL )
+   {
+     for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+     {
+       for( xBucket = 0; ( xBucket < HEAP_SNAPSHOT_BUCKETS - 1 ) && ( pxBlock->xBlockSize >= ( ( size_t ) 32 << xBucket ) ); xBucket++ )
+       {
+       }
+       pxSnapshot->usFreeBlocks[ xBucket ]++;
+
+       if( pxBlock->xBlockSize > pxSnapshot->ulLargestFreeBlock )
+       {
+         pxSnapshot->ulLargestFreeBlock = pxBlock->xBlockSize;
+       }
+     }
+   }
+
+   pxSnapshot->ulFreeBytes = xFreeBytesRemaining;
+   pxSnapshot->ulMinimumEverFreeBytes = xMinimumEverFreeBytesRemaining;
+
+   #if( configHEAP_PROFILER == 1 )
+   {
+     pxSnapshot->ulNbTags = xNbTags;
+     memcpy( pxSnapshot->xTags, xTagStats, xNbTags * sizeof( HeapTagStats_t ) );
+   }
+   #endif
+ }
+ ( void ) xTaskResumeAll();
+}
+
+void vPortGetLastHeapFailure( HeapFailure_t *pxFailure )
+{
+ #if( configHEAP_PROFILER == 1 )
+ {
+   vTaskSuspendAll();
+   {
+     *pxFailure = xLastFailure;
+   }
+   ( void ) xTaskResumeAll();
+ }
+ #else
+ {
+   memset( pxFailure, 0, sizeof( HeapFailure_t ) );
+ }
+ #endif
+}
+
+#if( configHEAP_PROFILER == 1 )
+
+/* Called by pvPortMalloc() and vPortFree() with the scheduler suspended. The
+block size includes the BlockLink_t header, as the size recorded in the
+failure snapshot. */
+void vHeapTraceMalloc( void *pvAddress, uint32_t ulBlockSize )
+{
+ NRF_LOG_INFO( "heap+ 0x%08x %u %u", ( uint32_t ) pvAddress, ulBlockSize, prvGetCurrentTag() );
+}
+
+void vHeapTraceFree( void *pvAddress, uint32_t ulBlockSize )
+{
+ NRF_LOG_INFO( "heap- 0x%08x %u", ( uint32_t ) pvAddress, ulBlockSize );
+}
+/*-----------------------------------------------------------*/
+
+/* Must be called with the scheduler suspended */
+static uint8_t prvGetCurrentTag( void )
+{
+ TaskHandle_t xTask;
+ uintptr_t uxTag;
+
+ if( xTaskGetSchedulerState() == taskSCHEDULER_NOT_STARTED )
+ {
+   return 0;
+ }
+
+ xTask = xTaskGetCurrentTaskHandle();
+ uxTag = ( uintptr_t ) xTaskGetApplicationTaskTag( xTask );
+ if( uxTag == 0 )
+ {
+   uxTag = uxTaskGetTaskNumber( xTask );
+ }
+ return ( uint8_t ) ( ( uxTag <= HEAP_TAG_MAX ) ? uxTag : 0 );
+}
+
+/* Must be called with the scheduler suspended */
+static HeapTagStats_t *prvGetTagStats( uint8_t ucTag )
+{
+ size_t x;
+
+ for( x = 0; x < xNbTags; x++ )
+ {
+   if( xTagStats[ x ].ucTag == ucTag )
+   {
+     return &xTagStats[ x ];
+   }
+ }
+
+ /* The last entry is kept for the tags that don't fit in the table */
+ if( xNbTags < HEAP_PROFILER_MAX_TAGS - 1 )
+ {
+   xTagStats[ xNbTags ].ucTag = ucTag;
+   return &xTagStats[ xNbTags++ ];
+ }
+
+ if( xNbTags == HEAP_PROFILER_MAX_TAGS - 1 )
+ {
+   xTagStats[ xNbTags++ ].ucTag = HEAP_TAG_OTHERS;
+ }
+ return &xTagStats[ HEAP_PROFILER_MAX_TAGS - 1 ];
+}
+
+#endif /* configHEAP_PROFILER */
@@ -0,0 +1,74 @@
+#ifndef HEAP_INFINITIME_H
+#define HEAP_INFINITIME_H
+
+/*
+ * Statistics of the FreeRTOS heap (heap_4_infinitime.c).
+ *
+ * The snapshot gives the free space and a histogram of the sizes of the free blocks, which shows how fragmented the heap is.
+ *
+ * When the firmware is built with configHEAP_PROFILER set to 1 (cmake -DENABLE_HEAP_PROFILER=ON), each allocated block is
+ * also tagged with the task that allocated it, and the live and peak bytes are counted per tag. The tag is stored in unused
+ * bits of the size of the block, so the layout of the heap is the same as in the normal build. A task can replace its tag by
+ * setting its application task tag (vTaskSetApplicationTaskTag()): DisplayApp uses HEAP_TAG_APP_BASE + the app being loaded,
+ * so that the memory of each screen is accounted separately. When an allocation fails, a snapshot is recorded in the .noinit
+ * RAM section, so that it can still be read after the reset that usually follows.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Free blocks of [16 << i, 16 << (i + 1)) bytes, the last bucket also holds the larger blocks */
+#define HEAP_SNAPSHOT_BUCKETS  12
+#define HEAP_PROFILER_MAX_TAGS 24
+
+/* Tags 1 to 63 are task numbers (TaskStatus_t.xTaskNumber), 0 is used before the scheduler is started */
+#define HEAP_TAG_APP_BASE 64
+#define HEAP_TAG_MAX      127
+/* Tag of the entry that holds the allocations of the tags that didn't fit in the table */
+#define HEAP_TAG_OTHERS 0xff
+
+typedef struct {
+  uint8_t ucTag;
+  uint8_t ucReserved;
+  uint16_t usLiveBlocks;
+  uint32_t ulLiveBytes;
+  uint32_t ulPeakBytes;
+} HeapTagStats_t;
+
+typedef struct {
+  uint32_t ulFreeBytes;
+  uint32_t ulMinimumEverFreeBytes;
+  uint32_t ulLargestFreeBlock;
+  uint16_t usFreeBlocks[HEAP_SNAPSHOT_BUCKETS];
+  /* Number of entries used in xTags, always 0 without the profiler */
+  uint32_t ulNbTags;
+  HeapTagStats_t xTags[HEAP_PROFILER_MAX_TAGS];
+} HeapSnapshot_t;
+
+typedef struct {
+  /* Number of failed allocations since the .noinit section was cleared */
+  uint32_t ulFailures;
+  /* Size and tag of the last failed allocation, and state of the heap at that time */
+  uint32_t ulRequestedSize;
+  uint32_t ulTag;
+  HeapSnapshot_t xSnapshot;
+} HeapFailure_t;
+
+void vPortGetHeapSnapshot(HeapSnapshot_t* pxSnapshot);
+
+/* Copies the record of the last failed allocation. ulFailures is 0 if there wasn't any, or without the profiler. */
+void vPortGetLastHeapFailure(HeapFailure_t* pxFailure);
+
+/* Hooks of traceMALLOC and traceFREE with the profiler: print "heap+ <address> <block size> <tag>" and
+ * "heap- <address> <block size>" to the log. pvAddress is NULL when the allocation failed. */
+void vHeapTraceMalloc(void* pvAddress, uint32_t ulBlockSize);
+void vHeapTraceFree(void* pvAddress, uint32_t ulBlockSize);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* HEAP_INFINITIME_H */
@@ -0,0 +1,69 @@
+#include "trace_infinitime.h"
+#include "FreeRTOS.h"
+#include "task.h"
+
+typedef struct {
+  /* Index of the next event, plus TRACE_RING_SIZE once the ring is full */
+  uint32_t ulNext;
+  TraceEvent_t xEvents[TRACE_RING_SIZE];
+} TraceRing_t;
+
+/* Cleared by main() when the content of the .noinit section is not valid */
+static TraceRing_t xTraceRing __attribute__((section(".noinit")));
+
+static uint32_t ulRunTimeHigh = 0;
+static uint32_t ulLastRtcCounter = 0;
+
+/* Must be called with the interrupts masked */
+static uint32_t prvGetRunTimeCounter(void) {
+  /* The RTC counter is 24 bits wide and counts the ticks (1024 Hz), so it wraps every 16384 s. The wrap is detected as long as
+   * the counter is read more often than that, which is the case as the idle task is switched out at least once per tickless
+   * idle period. */
+  uint32_t ulCounter = portNRF_RTC_REG->COUNTER;
+  if (ulCounter < ulLastRtcCounter) {
+    ulRunTimeHigh += (1UL << 24);
+  }
+  ulLastRtcCounter = ulCounter;
+  return ulRunTimeHigh + ulCounter;
+}
+
+void vTraceInitRunTimeCounter(void) {
+  ulRunTimeHigh = 0;
+  ulLastRtcCounter = 0;
+}
+
+uint32_t ulTraceGetRunTimeCounter(void) {
+  UBaseType_t uxMask = portSET_INTERRUPT_MASK_FROM_ISR();
+  uint32_t ulCounter = prvGetRunTimeCounter();
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxMask);
+  return ulCounter;
+}
+
+void vTraceRecord(uint8_t ucEvent, const void* pvObject) {
+  UBaseType_t uxMask = portSET_INTERRUPT_MASK_FROM_ISR();
+  uint32_t ulNext = xTraceRing.ulNext % (2 * TRACE_RING_SIZE);
+  uint32_t ulIndex = ulNext % TRACE_RING_SIZE;
+  TraceEvent_t* pxEvent = &xTraceRing.xEvents[ulIndex];
+  pxEvent->ulTimestamp = prvGetRunTimeCounter();
+  pxEvent->ucEvent = ucEvent;
+  pxEvent->ucTask = (uint8_t) uxTaskGetTaskNumber(xTaskGetCurrentTaskHandle());
+  pxEvent->usObject = (uint16_t) ((uintptr_t) pvObject & 0xffff);
+  xTraceRing.ulNext = (ulNext < TRACE_RING_SIZE - 1) ? ulNext + 1 : TRACE_RING_SIZE + (ulIndex + 1) % TRACE_RING_SIZE;
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxMask);
+}
+
+uint32_t ulTraceGetEvents(TraceEvent_t* pxEvents, uint32_t ulMaxEvents) {
+  UBaseType_t uxMask = portSET_INTERRUPT_MASK_FROM_ISR();
+  uint32_t ulNext = xTraceRing.ulNext % (2 * TRACE_RING_SIZE);
+  uint32_t ulCount = (ulNext < TRACE_RING_SIZE) ? ulNext : TRACE_RING_SIZE;
+  uint32_t ulFirst = (ulNext < TRACE_RING_SIZE) ? 0 : ulNext - TRACE_RING_SIZE;
+  if (ulCount > ulMaxEvents) {
+    ulFirst = (ulFirst + ulCount - ulMaxEvents) % TRACE_RING_SIZE;
+    ulCount = ulMaxEvents;
+  }
+  for (uint32_t i = 0; i < ulCount; i++) {
+    pxEvents[i] = xTraceRing.xEvents[(ulFirst + i) % TRACE_RING_SIZE];
+  }
+  portCLEAR_INTERRUPT_MASK_FROM_ISR(uxMask);
+  return ulCount;
+}
@@ -0,0 +1,58 @@
+#ifndef TRACE_INFINITIME_H
+#define TRACE_INFINITIME_H
+
+/*
+ * Run time counter and trace ring used by the FreeRTOS run time stats and trace hooks (see FreeRTOSConfig.h).
+ *
+ * The run time counter is the counter of the RTC that generates the tick, extended to 32 bits: it counts at configTICK_RATE_HZ
+ * (1024 Hz) and wraps after about 48 days. It keeps counting while the CPU sleeps, so the run time of the idle task includes the
+ * time spent in sleep mode. The run times are only as precise as a tick: a task that runs for less than a tick between two
+ * context switches is credited with 0 or 1 tick, so the load of the tasks that run in short bursts is only accurate on average
+ * over many switches. The DWT cycle counter and the TIMER peripherals are more precise, but the former stops while the CPU
+ * sleeps and the latter keep the high frequency clock running.
+ *
+ * The trace ring keeps the last context switches and queue events in the .noinit RAM section, so that they can still be read
+ * after a reset caused by the watchdog or a fault.
+ */
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define TRACE_RING_SIZE 64
+
+typedef enum {
+  eTraceTaskSwitchedIn = 1,
+  eTraceQueueSend,
+  eTraceQueueSendFailed,
+  eTraceQueueReceive,
+  eTraceQueueReceiveFailed,
+  eTraceQueueSendFromIsr,
+  eTraceQueueReceiveFromIsr
+} eTraceEvent;
+
+typedef struct {
+  /* Run time counter when the event occurred */
+  uint32_t ulTimestamp;
+  /* eTraceEvent */
+  uint8_t ucEvent;
+  /* Number of the running task (TaskStatus_t.xTaskNumber) */
+  uint8_t ucTask;
+  /* Lower half of the address of the queue (the RAM is 64KB), 0 for the context switches */
+  uint16_t usObject;
+} TraceEvent_t;
+
+void vTraceInitRunTimeCounter(void);
+uint32_t ulTraceGetRunTimeCounter(void);
+void vTraceRecord(uint8_t ucEvent, const void* pvObject);
+
+/* Copies the events of the ring, from the oldest to the newest. Returns the number of events copied. */
+uint32_t ulTraceGetEvents(TraceEvent_t* pxEvents, uint32_t ulMaxEvents);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TRACE_INFINITIME_H */
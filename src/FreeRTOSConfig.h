@@ -62,7 +62,9 @@
 #define configTICK_RATE_HZ                      1024
 #define configMAX_PRIORITIES                    (3)
 #define configMINIMAL_STACK_SIZE                (120)
-#define configTOTAL_HEAP_SIZE                   (1024 * 40)
+/* 40KB before the LVGL allocations moved to their own 12KB pool (displayapp/LvglPool.h), which still falls back to this heap.
+ * The stacks, queues and timers created at boot take ~15KB of it. Check a change with tools/heap-replay.py --heap-size. */
+#define configTOTAL_HEAP_SIZE                   (1024 * 28)
 #define configMAX_TASK_NAME_LEN                 (4)
 #define configUSE_16_BIT_TICKS                  0
 #define configIDLE_SHOULD_YIELD                 1
@@ -83,10 +85,42 @@
 #define configUSE_MALLOC_FAILED_HOOK   1
 
 /* Run time and task stats gathering related definitions. */
-#define configGENERATE_RUN_TIME_STATS        0
+#define configGENERATE_RUN_TIME_STATS        1
 #define configUSE_TRACE_FACILITY             1
 #define configUSE_STATS_FORMATTING_FUNCTIONS 0
 
+/* Run time counter and trace ring, see FreeRTOS/trace_infinitime.h */
+#if !(defined(__ASSEMBLY__) || defined(__ASSEMBLER__))
+  #include "trace_infinitime.h"
+
+  #define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() vTraceInitRunTimeCounter()
+  #define portGET_RUN_TIME_COUNTER_VALUE()         ulTraceGetRunTimeCounter()
+
+  #define traceTASK_SWITCHED_IN()                  vTraceRecord(eTraceTaskSwitchedIn, 0)
+  #define traceQUEUE_SEND(pxQueue)                 vTraceRecord(eTraceQueueSend, pxQueue)
+  #define traceQUEUE_SEND_FAILED(pxQueue)          vTraceRecord(eTraceQueueSendFailed, pxQueue)
+  #define traceQUEUE_RECEIVE(pxQueue)              vTraceRecord(eTraceQueueReceive, pxQueue)
+  #define traceQUEUE_RECEIVE_FAILED(pxQueue)       vTraceRecord(eTraceQueueReceiveFailed, pxQueue)
+  #define traceQUEUE_SEND_FROM_ISR(pxQueue)        vTraceRecord(eTraceQueueSendFromIsr, pxQueue)
+  #define traceQUEUE_RECEIVE_FROM_ISR(pxQueue)     vTraceRecord(eTraceQueueReceiveFromIsr, pxQueue)
+
+  /* The ring records uxTaskGetTaskNumber(), which is 0 until vTaskSetTaskNumber() is called: give every task the number
+   * shown in TaskStatus_t.xTaskNumber (SystemInfo, system stats service) when it is created */
+  #define traceTASK_CREATE(pxNewTCB) vTaskSetTaskNumber((TaskHandle_t) (pxNewTCB), (pxNewTCB)->uxTCBNumber)
+#endif
+
+/* Allocations tagged per task and per app, see FreeRTOS/heap_infinitime.h (cmake -DENABLE_HEAP_PROFILER=ON) */
+#ifndef configHEAP_PROFILER
+  #define configHEAP_PROFILER 0
+#endif
+#if configHEAP_PROFILER == 1
+  #define configUSE_APPLICATION_TASK_TAG 1
+
+  /* Allocation trace, printed to the log in the debug builds and replayed on the host by tools/heap-replay.py */
+  #define traceMALLOC(pvAddress, uiSize) vHeapTraceMalloc(pvAddress, uiSize)
+  #define traceFREE(pvAddress, uiSize)   vHeapTraceFree(pvAddress, uiSize)
+#endif
+
 /* Co-routine definitions. */
 #define configUSE_CO_ROUTINES           0
 #define configMAX_CO_ROUTINE_PRIORITIES (2)
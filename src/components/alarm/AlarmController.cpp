@@ -17,25 +17,24 @@
 */
 #include "components/alarm/AlarmController.h"
 #include "systemtask/SystemTask.h"
-#include "task.h"
 #include <chrono>
 
 using namespace Pinetime::Controllers;
 using namespace std::chrono_literals;
 
-AlarmController::AlarmController(Controllers::DateTime& dateTimeController) : dateTimeController {dateTimeController} {
+AlarmController::AlarmController(Controllers::DateTime& dateTimeController, Controllers::TimerWheel& timerWheel)
+  : dateTimeController {dateTimeController}, timerWheel {timerWheel} {
 }
 
 namespace {
-  void SetOffAlarm(TimerHandle_t xTimer) {
-    auto* controller = static_cast<Pinetime::Controllers::AlarmController*>(pvTimerGetTimerID(xTimer));
+  void SetOffAlarm(void* context) {
+    auto* controller = static_cast<Pinetime::Controllers::AlarmController*>(context);
     controller->SetOffAlarmNow();
   }
 }
 
 void AlarmController::Init(System::SystemTask* systemTask) {
   this->systemTask = systemTask;
-  alarmTimer = xTimerCreate("Alarm", 1, pdFALSE, this, SetOffAlarm);
 }
 
 void AlarmController::SetAlarmTime(uint8_t alarmHr, uint8_t alarmMin) {
@@ -45,7 +44,7 @@ void AlarmController::SetAlarmTime(uint8_t alarmHr, uint8_t alarmMin) {
 
 void AlarmController::ScheduleAlarm() {
   // Determine the next time the alarm needs to go off and set the timer
-  xTimerStop(alarmTimer, 0);
+  timerWheel.Cancel(TimerWheel::Events::Alarm);
 
   auto now = dateTimeController.CurrentDateTime();
   alarmTime = now;
@@ -76,8 +75,8 @@ void AlarmController::ScheduleAlarm() {
   // now can convert back to a time_point
   alarmTime = std::chrono::system_clock::from_time_t(std::mktime(tmAlarmTime));
   auto secondsToAlarm = std::chrono::duration_cast<std::chrono::seconds>(alarmTime - now).count();
-  xTimerChangePeriod(alarmTimer, secondsToAlarm * configTICK_RATE_HZ, 0);
-  xTimerStart(alarmTimer, 0);
+  // The alarm is scheduled again when the time is set (e.g. when DST starts or ends), see Messages::OnNewTime
+  timerWheel.Schedule(TimerWheel::Events::Alarm, timerWheel.Now() + secondsToAlarm * TimerWheel::ticksPerSecond, SetOffAlarm, this);
 
   state = AlarmState::Set;
 }
@@ -87,7 +86,7 @@ uint32_t AlarmController::SecondsToAlarm() const {
 }
 
 void AlarmController::DisableAlarm() {
-  xTimerStop(alarmTimer, 0);
+  timerWheel.Cancel(TimerWheel::Events::Alarm);
   state = AlarmState::Not_Set;
 }
 
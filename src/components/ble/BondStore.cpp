@@ -0,0 +1,320 @@
+#include "components/ble/BondStore.h"
+#include <cstring>
+#include <libraries/log/nrf_log.h>
+#include "components/fs/FS.h"
+
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_hs.h>
+#include <store/ram/ble_store_ram.h>
+#undef max
+#undef min
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  BondStore* instance = nullptr;
+
+  // Records are stored field by field (no padding): a type byte followed by the payload
+  constexpr size_t secRecordSize = 7 + 1 + 2 + 8 + 16 + 16 + 16 + 1;
+  constexpr size_t cccdRecordSize = 7 + 2 + 2 + 1;
+  constexpr size_t maxRecordSize = secRecordSize;
+
+  struct FileHeader {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t reserved[3];
+  };
+
+  class RecordWriter {
+  public:
+    explicit RecordWriter(uint8_t* buffer) : buffer {buffer} {
+    }
+
+    template <typename T>
+    void Put(const T& value) {
+      std::memcpy(&buffer[size], &value, sizeof(T));
+      size += sizeof(T);
+    }
+
+    void Put(const uint8_t* data, size_t length) {
+      std::memcpy(&buffer[size], data, length);
+      size += length;
+    }
+
+    size_t Size() const {
+      return size;
+    }
+
+  private:
+    uint8_t* buffer;
+    size_t size = 0;
+  };
+
+  class RecordReader {
+  public:
+    explicit RecordReader(const uint8_t* buffer) : buffer {buffer} {
+    }
+
+    template <typename T>
+    T Get() {
+      T value;
+      std::memcpy(&value, &buffer[offset], sizeof(T));
+      offset += sizeof(T);
+      return value;
+    }
+
+    void Get(uint8_t* data, size_t length) {
+      std::memcpy(data, &buffer[offset], length);
+      offset += length;
+    }
+
+  private:
+    const uint8_t* buffer;
+    size_t offset = 0;
+  };
+
+  size_t Serialize(int objType, const union ble_store_value& value, uint8_t* buffer) {
+    RecordWriter writer {buffer};
+    if (objType == BLE_STORE_OBJ_TYPE_CCCD) {
+      writer.Put(value.cccd.peer_addr.type);
+      writer.Put(value.cccd.peer_addr.val, sizeof(value.cccd.peer_addr.val));
+      writer.Put(value.cccd.chr_val_handle);
+      writer.Put(value.cccd.flags);
+      writer.Put(static_cast<uint8_t>(value.cccd.value_changed));
+    } else {
+      const auto& sec = value.sec;
+      writer.Put(sec.peer_addr.type);
+      writer.Put(sec.peer_addr.val, sizeof(sec.peer_addr.val));
+      writer.Put(sec.key_size);
+      writer.Put(sec.ediv);
+      writer.Put(sec.rand_num);
+      writer.Put(sec.ltk, sizeof(sec.ltk));
+      writer.Put(sec.irk, sizeof(sec.irk));
+      writer.Put(sec.csrk, sizeof(sec.csrk));
+      writer.Put(static_cast<uint8_t>(sec.ltk_present | (sec.irk_present << 1) | (sec.csrk_present << 2) | (sec.authenticated << 3) |
+                                      (sec.sc << 4)));
+    }
+    return writer.Size();
+  }
+
+  void Deserialize(int objType, const uint8_t* buffer, union ble_store_value& value) {
+    RecordReader reader {buffer};
+    std::memset(&value, 0, sizeof(value));
+    if (objType == BLE_STORE_OBJ_TYPE_CCCD) {
+      value.cccd.peer_addr.type = reader.Get<uint8_t>();
+      reader.Get(value.cccd.peer_addr.val, sizeof(value.cccd.peer_addr.val));
+      value.cccd.chr_val_handle = reader.Get<uint16_t>();
+      value.cccd.flags = reader.Get<uint16_t>();
+      value.cccd.value_changed = reader.Get<uint8_t>();
+    } else {
+      auto& sec = value.sec;
+      sec.peer_addr.type = reader.Get<uint8_t>();
+      reader.Get(sec.peer_addr.val, sizeof(sec.peer_addr.val));
+      sec.key_size = reader.Get<uint8_t>();
+      sec.ediv = reader.Get<uint16_t>();
+      sec.rand_num = reader.Get<uint64_t>();
+      reader.Get(sec.ltk, sizeof(sec.ltk));
+      reader.Get(sec.irk, sizeof(sec.irk));
+      reader.Get(sec.csrk, sizeof(sec.csrk));
+      const auto flags = reader.Get<uint8_t>();
+      sec.ltk_present = flags & 0x01;
+      sec.irk_present = (flags >> 1) & 0x01;
+      sec.csrk_present = (flags >> 2) & 0x01;
+      sec.authenticated = (flags >> 3) & 0x01;
+      sec.sc = (flags >> 4) & 0x01;
+    }
+  }
+
+  size_t RecordSize(int objType) {
+    return objType == BLE_STORE_OBJ_TYPE_CCCD ? cccdRecordSize : secRecordSize;
+  }
+
+  constexpr int objTypes[] = {BLE_STORE_OBJ_TYPE_OUR_SEC, BLE_STORE_OBJ_TYPE_PEER_SEC, BLE_STORE_OBJ_TYPE_CCCD};
+
+  struct ChecksumCookie {
+    uint32_t hash;
+  };
+
+  void HashBytes(uint32_t& hash, const uint8_t* data, size_t size) {
+    for (size_t i = 0; i < size; i++) {
+      hash = (hash ^ data[i]) * 16777619u;
+    }
+  }
+
+  int ChecksumRecord(int objType, union ble_store_value* value, void* cookie) {
+    auto* checksum = static_cast<ChecksumCookie*>(cookie);
+    uint8_t record[maxRecordSize + 1];
+    record[0] = static_cast<uint8_t>(objType);
+    const size_t size = Serialize(objType, *value, &record[1]) + 1;
+    HashBytes(checksum->hash, record, size);
+    return 0;
+  }
+
+  struct WriteCookie {
+    FS* fs;
+    lfs_file_t* file;
+    bool error;
+  };
+
+  int WriteRecord(int objType, union ble_store_value* value, void* cookie) {
+    auto* write = static_cast<WriteCookie*>(cookie);
+    uint8_t record[maxRecordSize + 1];
+    record[0] = static_cast<uint8_t>(objType);
+    const size_t size = Serialize(objType, *value, &record[1]) + 1;
+    if (write->fs->FileWrite(write->file, record, size) != static_cast<int>(size)) {
+      write->error = true;
+      return 1;
+    }
+    return 0;
+  }
+}
+
+BondStore::BondStore(FS& fs) : fs {fs} {
+}
+
+void BondStore::Init() {
+  instance = this;
+
+  if (Load()) {
+    persistedChecksum = Checksum();
+    // Left by a reset between the conversion of the legacy bond and the deletion of its file
+    fs.FileDelete(legacyPath);
+  } else {
+    LoadLegacy();
+  }
+
+  ble_hs_cfg.store_read_cb = ble_store_ram_read;
+  ble_hs_cfg.store_write_cb = Write;
+  ble_hs_cfg.store_delete_cb = Delete;
+}
+
+void BondStore::Persist() {
+  if (!dirty) {
+    return;
+  }
+  // CCCD writes are frequent and often don't change anything: only rewrite the file when the content is different
+  const uint32_t checksum = Checksum();
+  if (checksum == persistedChecksum || Save()) {
+    persistedChecksum = checksum;
+    dirty = false;
+  }
+}
+
+int BondStore::Write(int objType, const union ble_store_value* value) {
+  int rc = ble_store_ram_write(objType, value);
+  if (rc == 0) {
+    instance->dirty = true;
+  }
+  return rc;
+}
+
+int BondStore::Delete(int objType, const union ble_store_key* key) {
+  int rc = ble_store_ram_delete(objType, key);
+  if (rc == 0) {
+    instance->dirty = true;
+  }
+  return rc;
+}
+
+uint32_t BondStore::Checksum() {
+  ChecksumCookie cookie {2166136261u};
+  for (const int objType : objTypes) {
+    ble_store_iterate(objType, ChecksumRecord, &cookie);
+  }
+  return cookie.hash;
+}
+
+bool BondStore::Load() {
+  lfs_file_t file;
+  if (fs.FileOpen(&file, path, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+
+  FileHeader header;
+  if (fs.FileRead(&file, reinterpret_cast<uint8_t*>(&header), sizeof(header)) != static_cast<int>(sizeof(header)) || header.magic != magic ||
+      header.version != version) {
+    fs.FileClose(&file);
+    return false;
+  }
+
+  uint8_t record[maxRecordSize];
+  uint8_t objType;
+  while (fs.FileRead(&file, &objType, 1) == 1) {
+    if (objType != BLE_STORE_OBJ_TYPE_OUR_SEC && objType != BLE_STORE_OBJ_TYPE_PEER_SEC && objType != BLE_STORE_OBJ_TYPE_CCCD) {
+      NRF_LOG_INFO("[BondStore] Invalid record type %d", objType);
+      break;
+    }
+    const size_t size = RecordSize(objType);
+    if (fs.FileRead(&file, record, size) != static_cast<int>(size)) {
+      break;
+    }
+    union ble_store_value value;
+    Deserialize(objType, record, value);
+    ble_store_ram_write(objType, &value);
+  }
+
+  fs.FileClose(&file);
+  return true;
+}
+
+void BondStore::LoadLegacy() {
+  lfs_file_t file;
+  if (fs.FileOpen(&file, legacyPath, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return;
+  }
+
+  union ble_store_value value;
+  memset(&value, 0, sizeof value);
+  fs.FileRead(&file, reinterpret_cast<uint8_t*>(&value.sec), sizeof value);
+  ble_store_ram_write(BLE_STORE_OBJ_TYPE_OUR_SEC, &value);
+
+  memset(&value, 0, sizeof value);
+  fs.FileRead(&file, reinterpret_cast<uint8_t*>(&value.sec), sizeof value);
+  ble_store_ram_write(BLE_STORE_OBJ_TYPE_PEER_SEC, &value);
+
+  uint8_t cccdCount = 0;
+  fs.FileRead(&file, &cccdCount, 1);
+  for (uint8_t i = 0; i < cccdCount; i++) {
+    memset(&value, 0, sizeof value);
+    fs.FileRead(&file, reinterpret_cast<uint8_t*>(&value.cccd), sizeof(struct ble_store_value_cccd));
+    ble_store_ram_write(BLE_STORE_OBJ_TYPE_CCCD, &value);
+  }
+
+  fs.FileClose(&file);
+
+  // The legacy file is only deleted once the bond is saved in the new format, a reset in between must not lose it
+  if (Save()) {
+    persistedChecksum = Checksum();
+    fs.FileDelete(legacyPath);
+  } else {
+    dirty = true;
+  }
+}
+
+bool BondStore::Save() {
+  // Write a temporary file and rename it, so that a reset during the write doesn't lose the existing bonds
+  lfs_file_t file;
+  if (fs.FileOpen(&file, tmpPath, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    return false;
+  }
+
+  const FileHeader header {magic, version, {}};
+  WriteCookie cookie {&fs, &file, false};
+  if (fs.FileWrite(&file, reinterpret_cast<const uint8_t*>(&header), sizeof(header)) != static_cast<int>(sizeof(header))) {
+    cookie.error = true;
+  }
+  for (const int objType : objTypes) {
+    if (!cookie.error) {
+      ble_store_iterate(objType, WriteRecord, &cookie);
+    }
+  }
+  fs.FileClose(&file);
+
+  if (cookie.error || fs.Rename(tmpPath, path) != LFS_ERR_OK) {
+    fs.FileDelete(tmpPath);
+    NRF_LOG_INFO("[BondStore] Could not save the bonds");
+    return false;
+  }
+  return true;
+}
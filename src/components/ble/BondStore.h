@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_store.h>
+#undef max
+#undef min
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+
+    /**
+     * Persistent backend for the NimBLE store.
+     *
+     * The RAM store (ble_store_ram) is still used for the lookups. BondStore wraps its write and delete callbacks to keep track
+     * of the changes, and saves every bond (our and peer security material and CCCDs) to the file system in a compact record
+     * format when Persist() is called. The file is only rewritten when its content changes.
+     */
+    class BondStore {
+    public:
+      explicit BondStore(FS& fs);
+
+      /** Loads the bonds from the file system into the RAM store and installs the store callbacks */
+      void Init();
+
+      /** Saves the bonds to the file system if they changed since the last call */
+      void Persist();
+
+    private:
+      static int Write(int objType, const union ble_store_value* value);
+      static int Delete(int objType, const union ble_store_key* key);
+
+      bool Load();
+      void LoadLegacy();
+      bool Save();
+      uint32_t Checksum();
+
+      FS& fs;
+      bool dirty = false;
+      uint32_t persistedChecksum = 0;
+
+      static constexpr const char* path = "/bonds.dat";
+      static constexpr const char* tmpPath = "/bonds.tmp";
+      // Single bond file written by older firmware versions
+      static constexpr const char* legacyPath = "/bond.dat";
+      static constexpr uint32_t magic = 0x444e4f42; // "BOND"
+      static constexpr uint8_t version = 1;
+    };
+  }
+}
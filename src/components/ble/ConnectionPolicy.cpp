@@ -0,0 +1,94 @@
+#include "components/ble/ConnectionPolicy.h"
+#include <libraries/log/nrf_log.h>
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  void TransferTimerCallback(TimerHandle_t xTimer) {
+    auto* policy = static_cast<ConnectionPolicy*>(pvTimerGetTimerID(xTimer));
+    policy->OnTransferTimeout();
+  }
+}
+
+void ConnectionPolicy::Init() {
+  transferTimer = xTimerCreate("connPolicy", transferTimeout, pdFALSE, this, TransferTimerCallback);
+}
+
+void ConnectionPolicy::OnConnected(uint16_t connectionHandle) {
+  this->connectionHandle = connectionHandle;
+  mode = Modes::Idle;
+  OnParametersUpdated();
+  xTimerChangePeriod(transferTimer, connectionSetupDelay, 0);
+}
+
+void ConnectionPolicy::OnDisconnected() {
+  connectionHandle = BLE_HS_CONN_HANDLE_NONE;
+  mode = Modes::Idle;
+  interval = 0;
+  latency = 0;
+  xTimerStop(transferTimer, 0);
+}
+
+void ConnectionPolicy::OnParametersUpdated() {
+  ble_gap_conn_desc desc;
+  if (ble_gap_conn_find(connectionHandle, &desc) == 0) {
+    interval = desc.conn_itvl;
+    latency = desc.conn_latency;
+    NRF_LOG_INFO("[ConnectionPolicy] interval=%d latency=%d events/s=%d", interval, latency, RadioEventsPerSecond());
+  }
+}
+
+void ConnectionPolicy::OnTransfer(uint16_t size) {
+  if (connectionHandle == BLE_HS_CONN_HANDLE_NONE) {
+    return;
+  }
+  lastTransfer = xTaskGetTickCount();
+  if (mode != Modes::Transfer) {
+    transferStart = lastTransfer;
+    transferBytes = 0;
+    Apply(Modes::Transfer);
+  }
+  transferBytes += size;
+  xTimerChangePeriod(transferTimer, transferTimeout, 0);
+}
+
+void ConnectionPolicy::OnTransferTimeout() {
+  if (connectionHandle == BLE_HS_CONN_HANDLE_NONE) {
+    return;
+  }
+  if (mode == Modes::Transfer) {
+    NRF_LOG_INFO("[ConnectionPolicy] transfer: %d bytes, %d B/s", transferBytes, TransferThroughput());
+  }
+  Apply(Modes::Idle);
+}
+
+void ConnectionPolicy::Apply(Modes newMode) {
+  mode = newMode;
+  const auto& params = (mode == Modes::Transfer) ? transferParams : idleParams;
+  const uint8_t phyMask = (mode == Modes::Transfer) ? BLE_GAP_LE_PHY_2M_MASK : BLE_GAP_LE_PHY_1M_MASK;
+
+  int rc = ble_gap_update_params(connectionHandle, &params);
+  if (rc != 0) {
+    NRF_LOG_INFO("[ConnectionPolicy] update params failed: %d", rc);
+  }
+  rc = ble_gap_set_prefered_le_phy(connectionHandle, phyMask, phyMask, BLE_GAP_LE_PHY_CODED_ANY);
+  if (rc != 0) {
+    NRF_LOG_INFO("[ConnectionPolicy] set PHY failed: %d", rc);
+  }
+}
+
+uint16_t ConnectionPolicy::RadioEventsPerSecond() const {
+  if (interval == 0) {
+    return 0;
+  }
+  // interval is in 1.25ms units, and the peripheral can skip up to 'latency' events when it has nothing to send
+  return 800 / (interval * (latency + 1));
+}
+
+uint32_t ConnectionPolicy::TransferThroughput() const {
+  const TickType_t duration = lastTransfer - transferStart;
+  if (duration == 0) {
+    return 0;
+  }
+  return (static_cast<uint64_t>(transferBytes) * configTICK_RATE_HZ) / duration;
+}
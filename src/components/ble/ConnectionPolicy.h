@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstdint>
+#include <FreeRTOS.h>
+#include <timers.h>
+
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_gap.h>
+#undef max
+#undef min
+
+namespace Pinetime {
+  namespace Controllers {
+    /**
+     * Chooses the connection parameters and the PHY according to the workload.
+     *
+     * While bulk transfers (DFU, file transfers) are running, it requests a short connection interval without slave latency
+     * and the 2M PHY. Once no transfer happened for transferTimeout, it falls back to a long interval with slave latency on
+     * the 1M PHY. Data Length Extension is negotiated by the link layer at connection time.
+     */
+    class ConnectionPolicy {
+    public:
+      enum class Modes : uint8_t { Idle, Transfer };
+
+      void Init();
+
+      void OnConnected(uint16_t connectionHandle);
+      void OnDisconnected();
+      /** Called when the central has updated the connection parameters */
+      void OnParametersUpdated();
+
+      /** Called by the services for each packet of a bulk transfer */
+      void OnTransfer(uint16_t size);
+
+      void OnTransferTimeout();
+
+      Modes Mode() const {
+        return mode;
+      }
+
+      /** @return the current connection interval in 1.25ms units */
+      uint16_t Interval() const {
+        return interval;
+      }
+
+      uint16_t Latency() const {
+        return latency;
+      }
+
+      /** @return the number of connection events per second in which the radio has to wake up when there is no data to send */
+      uint16_t RadioEventsPerSecond() const;
+
+      /** @return the throughput of the last (or current) transfer, in bytes per second */
+      uint32_t TransferThroughput() const;
+
+    private:
+      void Apply(Modes newMode);
+
+      uint16_t connectionHandle = BLE_HS_CONN_HANDLE_NONE;
+      Modes mode = Modes::Idle;
+      uint16_t interval = 0;
+      uint16_t latency = 0;
+
+      TickType_t transferStart = 0;
+      TickType_t lastTransfer = 0;
+      uint32_t transferBytes = 0;
+
+      TimerHandle_t transferTimer;
+      // The first switch to the idle parameters is delayed, to keep the interval chosen by the central during service discovery
+      static constexpr TickType_t connectionSetupDelay = pdMS_TO_TICKS(10000);
+      static constexpr TickType_t transferTimeout = pdMS_TO_TICKS(3000);
+
+      // Transfer: 15-30ms interval, no latency, 4s supervision timeout
+      static constexpr ble_gap_upd_params transferParams {12, 24, 0, 400, 0, 0};
+      // Idle: 90-120ms interval, up to 4 skipped events, 6s supervision timeout
+      static constexpr ble_gap_upd_params idleParams {72, 96, 4, 600, 0, 0};
+    };
+  }
+}
@@ -1,6 +1,7 @@
 #include "components/ble/DfuService.h"
 #include <cstring>
 #include "components/ble/BleController.h"
+#include "components/ble/ConnectionPolicy.h"
 #include "drivers/SpiNorFlash.h"
 #include "systemtask/SystemTask.h"
 #include <nrf_log.h>
@@ -29,9 +30,11 @@ void TimeoutTimerCallback(TimerHandle_t xTimer) {
 
 DfuService::DfuService(Pinetime::System::SystemTask& systemTask,
                        Pinetime::Controllers::Ble& bleController,
-                       Pinetime::Drivers::SpiNorFlash& spiNorFlash)
+                       Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                       ConnectionPolicy& connectionPolicy)
   : systemTask {systemTask},
     bleController {bleController},
+    connectionPolicy {connectionPolicy},
     dfuImage {spiNorFlash},
     characteristicDefinition {{
                                 .uuid = &packetCharacteristicUuid.u,
@@ -113,6 +116,7 @@ int DfuService::SendDfuRevision(os_mbuf* om) const {
 }
 
 int DfuService::WritePacketHandler(uint16_t connectionHandle, os_mbuf* om) {
+  connectionPolicy.OnTransfer(om->om_len);
   switch (state) {
     case States::Start: {
       softdeviceSize = om->om_data[0] + (om->om_data[1] << 8) + (om->om_data[2] << 16) + (om->om_data[3] << 24);
@@ -395,9 +399,9 @@ void DfuService::DfuImage::WriteMagicNumber() {
 }
 
 void DfuService::DfuImage::Erase() {
-  for (size_t erased = 0; erased < maxSize; erased += 0x1000) {
-    spiNorFlash.SectorErase(writeOffset + erased);
-  }
+  const TickType_t start = xTaskGetTickCount();
+  spiNorFlash.EraseRange(writeOffset, maxSize);
+  NRF_LOG_INFO("[DFU] Erased %d bytes in %d ms", maxSize, (xTaskGetTickCount() - start) * 1000 / configTICK_RATE_HZ);
 }
 
 bool DfuService::DfuImage::Validate() {
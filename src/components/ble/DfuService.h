@@ -20,12 +20,14 @@ namespace Pinetime {
 
   namespace Controllers {
     class Ble;
+    class ConnectionPolicy;
 
     class DfuService {
     public:
       DfuService(Pinetime::System::SystemTask& systemTask,
                  Pinetime::Controllers::Ble& bleController,
-                 Pinetime::Drivers::SpiNorFlash& spiNorFlash);
+                 Pinetime::Drivers::SpiNorFlash& spiNorFlash,
+                 ConnectionPolicy& connectionPolicy);
       void Init();
       int OnServiceData(uint16_t connectionHandle, uint16_t attributeHandle, ble_gatt_access_ctxt* context);
       void OnTimeout();
@@ -80,6 +82,7 @@ namespace Pinetime {
     private:
       Pinetime::System::SystemTask& systemTask;
       Pinetime::Controllers::Ble& bleController;
+      ConnectionPolicy& connectionPolicy;
       DfuImage dfuImage;
       NotificationManager notificationManager;
 
@@ -1,6 +1,7 @@
 #include <nrf_log.h>
 #include "FSService.h"
 #include "components/ble/BleController.h"
+#include "components/ble/ConnectionPolicy.h"
 #include "systemtask/SystemTask.h"
 
 using namespace Pinetime::Controllers;
@@ -14,9 +15,10 @@ int FSServiceCallback(uint16_t conn_handle, uint16_t attr_handle, struct ble_gat
   return fsService->OnFSServiceRequested(conn_handle, attr_handle, ctxt);
 }
 
-FSService::FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Controllers::FS& fs)
+FSService::FSService(Pinetime::System::SystemTask& systemTask, Pinetime::Controllers::FS& fs, ConnectionPolicy& connectionPolicy)
   : systemTask {systemTask},
     fs {fs},
+    connectionPolicy {connectionPolicy},
     characteristicDefinition {{.uuid = &fsVersionUuid.u,
                                .access_cb = FSServiceCallback,
                                .arg = this,
@@ -63,6 +65,7 @@ int FSService::OnFSServiceRequested(uint16_t connectionHandle, uint16_t attribut
 int FSService::FSCommandHandler(uint16_t connectionHandle, os_mbuf* om) {
   auto command = static_cast<commands>(om->om_data[0]);
   NRF_LOG_INFO("[FS_S] -> FSCommandHandler Command %d", command);
+  connectionPolicy.OnTransfer(om->om_len);
   // Just always make sure we are awake...
   systemTask.PushMessage(Pinetime::System::Messages::StartFileTransfer);
   vTaskDelay(10);
@@ -46,8 +46,6 @@ namespace {
   constexpr ble_uuid128_t msRepeatCharUuid {CharUuid(0x0b, 0x00)};
   constexpr ble_uuid128_t msShuffleCharUuid {CharUuid(0x0c, 0x00)};
 
-  constexpr uint8_t MaxStringSize {40};
-
   int MusicCallback(uint16_t /*conn_handle*/, uint16_t /*attr_handle*/, struct ble_gatt_access_ctxt* ctxt, void* arg) {
     return static_cast<Pinetime::Controllers::MusicService*>(arg)->OnCommand(ctxt);
   }
@@ -130,23 +128,27 @@ int Pinetime::Controllers::MusicService::OnCommand(struct ble_gatt_access_ctxt*
       bufferSize = MaxStringSize;
     }
 
-    char data[bufferSize + 1];
+    char data[MaxStringSize + 1] {};
     os_mbuf_copydata(ctxt->om, 0, bufferSize, data);
 
     if (notifSize > bufferSize) {
-      data[bufferSize - 1] = '.';
-      data[bufferSize - 2] = '.';
-      data[bufferSize - 3] = '.';
+      // The ellipsis follows the last character that fits in full
+      const size_t ellipsis = Utility::Utf8Prefix(data, bufferSize, bufferSize - 3);
+      std::memcpy(&data[ellipsis], "...", 3);
+      bufferSize = ellipsis + 3;
     }
     data[bufferSize] = '\0';
 
     char* s = &data[0];
     if (ble_uuid_cmp(ctxt->chr->uuid, &msArtistCharUuid.u) == 0) {
-      artistName = s;
+      artistName.Assign(s, std::strlen(s));
+      textRevision++;
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &msTrackCharUuid.u) == 0) {
-      trackName = s;
+      trackName.Assign(s, std::strlen(s));
+      textRevision++;
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &msAlbumCharUuid.u) == 0) {
-      albumName = s;
+      albumName.Assign(s, std::strlen(s));
+      textRevision++;
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &msStatusCharUuid.u) == 0) {
       playing = s[0];
       // These variables need to be updated, because the progress may not be updated immediately,
@@ -177,16 +179,20 @@ int Pinetime::Controllers::MusicService::OnCommand(struct ble_gatt_access_ctxt*
   return 0;
 }
 
-std::string Pinetime::Controllers::MusicService::getAlbum() const {
-  return albumName;
+std::string_view Pinetime::Controllers::MusicService::getAlbum() const {
+  return albumName.View();
+}
+
+std::string_view Pinetime::Controllers::MusicService::getArtist() const {
+  return artistName.View();
 }
 
-std::string Pinetime::Controllers::MusicService::getArtist() const {
-  return artistName;
+std::string_view Pinetime::Controllers::MusicService::getTrack() const {
+  return trackName.View();
 }
 
-std::string Pinetime::Controllers::MusicService::getTrack() const {
-  return trackName;
+uint32_t Pinetime::Controllers::MusicService::TextRevision() const {
+  return textRevision;
 }
 
 bool Pinetime::Controllers::MusicService::isPlaying() const {
@@ -17,14 +17,16 @@
 */
 #pragma once
 
+#include <atomic>
 #include <cstdint>
-#include <string>
+#include <string_view>
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
 #include <host/ble_gap.h>
 #include <host/ble_uuid.h>
 #undef max
 #undef min
+#include "utility/FixedString.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -40,11 +42,16 @@ namespace Pinetime {
 
       void event(char event);
 
-      std::string getArtist() const;
+      // The views are null-terminated and stay valid, but their content may change when TextRevision() changes
 
-      std::string getTrack() const;
+      std::string_view getArtist() const;
 
-      std::string getAlbum() const;
+      std::string_view getTrack() const;
+
+      std::string_view getAlbum() const;
+
+      // Incremented each time the artist, track or album is updated
+      uint32_t TextRevision() const;
 
       int getProgress() const;
 
@@ -64,15 +71,19 @@ namespace Pinetime {
 
       enum MusicStatus { NotPlaying = 0x00, Playing = 0x01 };
 
+      static constexpr size_t MaxStringSize {40};
+
     private:
       struct ble_gatt_chr_def characteristicDefinition[14];
       struct ble_gatt_svc_def serviceDefinition[2];
 
       uint16_t eventHandle {};
 
-      std::string artistName {"Waiting for"};
-      std::string albumName {};
-      std::string trackName {"track information.."};
+      Utility::FixedString<MaxStringSize> artistName {"Waiting for"};
+      Utility::FixedString<MaxStringSize> albumName {};
+      Utility::FixedString<MaxStringSize> trackName {"track information.."};
+      // Starts at 1 so that the screens, which start at 0, read the initial text
+      std::atomic<uint32_t> textRevision {1};
 
       bool playing {false};
 
@@ -17,6 +17,8 @@
 */
 
 #include "components/ble/NavigationService.h"
+#include <algorithm>
+#include <cstring>
 
 namespace {
   // 0001yyxx-78fc-48fe-8e23-433b3a1942d0
@@ -82,17 +84,20 @@ void Pinetime::Controllers::NavigationService::Init() {
 int Pinetime::Controllers::NavigationService::OnCommand(struct ble_gatt_access_ctxt* ctxt) {
 
   if (ctxt->op == BLE_GATT_ACCESS_OP_WRITE_CHR) {
-    size_t notifSize = OS_MBUF_PKTLEN(ctxt->om);
-    uint8_t data[notifSize + 1];
-    data[notifSize] = '\0';
+    // One byte more than the longest text, so that FixedString can tell whether the truncation splits a UTF-8 character
+    size_t notifSize = std::min<size_t>(OS_MBUF_PKTLEN(ctxt->om), narrativeSize + 1);
+    uint8_t data[narrativeSize + 2] {};
     os_mbuf_copydata(ctxt->om, 0, notifSize, data);
     char* s = (char*) &data[0];
     if (ble_uuid_cmp(ctxt->chr->uuid, &navFlagCharUuid.u) == 0) {
-      m_flag = s;
+      m_flag.Assign(s, std::strlen(s));
+      textRevision++;
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &navNarrativeCharUuid.u) == 0) {
-      m_narrative = s;
+      m_narrative.Assign(s, std::strlen(s));
+      textRevision++;
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &navManDistCharUuid.u) == 0) {
-      m_manDist = s;
+      m_manDist.Assign(s, std::strlen(s));
+      textRevision++;
     } else if (ble_uuid_cmp(ctxt->chr->uuid, &navProgressCharUuid.u) == 0) {
       m_progress = data[0];
     }
@@ -100,18 +105,22 @@ int Pinetime::Controllers::NavigationService::OnCommand(struct ble_gatt_access_c
   return 0;
 }
 
-std::string Pinetime::Controllers::NavigationService::getFlag() {
-  return m_flag;
+std::string_view Pinetime::Controllers::NavigationService::getFlag() {
+  return m_flag.View();
 }
 
-std::string Pinetime::Controllers::NavigationService::getNarrative() {
-  return m_narrative;
+std::string_view Pinetime::Controllers::NavigationService::getNarrative() {
+  return m_narrative.View();
 }
 
-std::string Pinetime::Controllers::NavigationService::getManDist() {
-  return m_manDist;
+std::string_view Pinetime::Controllers::NavigationService::getManDist() {
+  return m_manDist.View();
 }
 
 int Pinetime::Controllers::NavigationService::getProgress() {
   return m_progress;
 }
+
+uint32_t Pinetime::Controllers::NavigationService::TextRevision() const {
+  return textRevision;
+}
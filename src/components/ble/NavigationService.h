@@ -17,14 +17,16 @@
 */
 #pragma once
 
+#include <atomic>
 #include <cstdint>
-#include <string>
+#include <string_view>
 #define min // workaround: nimble's min/max macros conflict with libstdc++
 #define max
 #include <host/ble_gap.h>
 #include <host/ble_uuid.h>
 #undef max
 #undef min
+#include "utility/FixedString.h"
 
 namespace Pinetime {
   namespace Controllers {
@@ -37,22 +39,34 @@ namespace Pinetime {
 
       int OnCommand(struct ble_gatt_access_ctxt* ctxt);
 
-      std::string getFlag();
+      // The views are null-terminated and stay valid, but their content may change when TextRevision() changes
 
-      std::string getNarrative();
+      std::string_view getFlag();
 
-      std::string getManDist();
+      std::string_view getNarrative();
+
+      std::string_view getManDist();
 
       int getProgress();
 
+      // Incremented each time the flag, narrative or distance is updated
+      uint32_t TextRevision() const;
+
     private:
       struct ble_gatt_chr_def characteristicDefinition[5];
       struct ble_gatt_svc_def serviceDefinition[2];
 
-      std::string m_flag;
-      std::string m_narrative;
-      std::string m_manDist;
+      // Longer values are truncated
+      static constexpr size_t flagSize = 32;
+      static constexpr size_t narrativeSize = 80;
+      static constexpr size_t manDistSize = 16;
+
+      Utility::FixedString<flagSize> m_flag;
+      Utility::FixedString<narrativeSize> m_narrative;
+      Utility::FixedString<manDistSize> m_manDist;
       int m_progress;
+      // Starts at 1 so that the screen, which starts at 0, reads the initial text
+      std::atomic<uint32_t> textRevision {1};
     };
   }
 }
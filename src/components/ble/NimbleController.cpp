@@ -36,7 +36,8 @@ NimbleController::NimbleController(Pinetime::System::SystemTask& systemTask,
     dateTimeController {dateTimeController},
     spiNorFlash {spiNorFlash},
     fs {fs},
-    dfuService {systemTask, bleController, spiNorFlash},
+    bondStore {fs},
+    dfuService {systemTask, bleController, spiNorFlash, connectionPolicy},
 
     currentTimeClient {dateTimeController},
     anService {systemTask, notificationManager},
@@ -48,7 +49,8 @@ NimbleController::NimbleController(Pinetime::System::SystemTask& systemTask,
     immediateAlertService {systemTask, notificationManager},
     heartRateService {*this, heartRateController},
     motionService {*this, motionController},
-    fsService {systemTask, fs},
+    fsService {systemTask, fs, connectionPolicy},
+    systemStatsService {systemTask.Monitor()},
     serviceDiscovery({&currentTimeClient, &alertNotificationClient}) {
 }
 
@@ -82,6 +84,8 @@ void NimbleController::Init() {
   ble_hs_cfg.sync_cb = nimble_on_sync;
   ble_hs_cfg.store_status_cb = ble_store_util_status_rr;
 
+  connectionPolicy.Init();
+
   ble_svc_gap_init();
   ble_svc_gatt_init();
 
@@ -98,6 +102,7 @@ void NimbleController::Init() {
   heartRateService.Init();
   motionService.Init();
   fsService.Init();
+  systemStatsService.Init();
 
   int rc;
   rc = ble_hs_util_ensure_addr(0);
@@ -131,7 +136,7 @@ void NimbleController::Init() {
   rc = ble_gatts_start();
   ASSERT(rc == 0);
 
-  RestoreBond();
+  bondStore.Init();
 
   StartAdvertising();
 }
@@ -203,6 +208,7 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
         StartAdvertising();
       } else {
         connectionHandle = event->connect.conn_handle;
+        connectionPolicy.OnConnected(connectionHandle);
         bleController.Connect();
         systemTask.PushMessage(Pinetime::System::Messages::BleConnected);
         // Service discovery is deferred via systemtask
@@ -214,9 +220,8 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
       NRF_LOG_INFO("Disconnect event : BLE_GAP_EVENT_DISCONNECT");
       NRF_LOG_INFO("disconnect reason=%d", event->disconnect.reason);
 
-      if (event->disconnect.conn.sec_state.bonded) {
-        PersistBond(event->disconnect.conn);
-      }
+      bondStore.Persist();
+      connectionPolicy.OnDisconnected();
 
       currentTimeClient.Reset();
       alertNotificationClient.Reset();
@@ -232,6 +237,7 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
       /* The central has updated the connection parameters. */
       NRF_LOG_INFO("Update event : BLE_GAP_EVENT_CONN_UPDATE");
       NRF_LOG_INFO("update status=%0X ", event->conn_update.status);
+      connectionPolicy.OnParametersUpdated();
       break;
 
     case BLE_GAP_EVENT_CONN_UPDATE_REQ:
@@ -253,7 +259,7 @@ int NimbleController::OnGAPEvent(ble_gap_event* event) {
         struct ble_gap_conn_desc desc;
         ble_gap_conn_find(event->enc_change.conn_handle, &desc);
         if (desc.sec_state.bonded) {
-          PersistBond(desc);
+          bondStore.Persist();
         }
 
         NRF_LOG_INFO("new state: encrypted=%d authenticated=%d bonded=%d key_size=%d",
@@ -417,81 +423,3 @@ void NimbleController::DisableRadio() {
   }
 }
 
-void NimbleController::PersistBond(struct ble_gap_conn_desc& desc) {
-  union ble_store_key key;
-  union ble_store_value our_sec, peer_sec, peer_cccd_set[MYNEWT_VAL(BLE_STORE_MAX_CCCDS)] = {0};
-  int rc;
-
-  memset(&key, 0, sizeof key);
-  memset(&our_sec, 0, sizeof our_sec);
-  key.sec.peer_addr = desc.peer_id_addr;
-  rc = ble_store_read_our_sec(&key.sec, &our_sec.sec);
-
-  if (memcmp(&our_sec.sec, &bondId, sizeof bondId) == 0) {
-    return;
-  }
-
-  memcpy(&bondId, &our_sec.sec, sizeof bondId);
-
-  memset(&key, 0, sizeof key);
-  memset(&peer_sec, 0, sizeof peer_sec);
-  key.sec.peer_addr = desc.peer_id_addr;
-  rc += ble_store_read_peer_sec(&key.sec, &peer_sec.sec);
-
-  if (rc == 0) {
-    memset(&key, 0, sizeof key);
-    key.cccd.peer_addr = desc.peer_id_addr;
-    int peer_count = 0;
-    ble_store_util_count(BLE_STORE_OBJ_TYPE_CCCD, &peer_count);
-    for (int i = 0; i < peer_count; i++) {
-      key.cccd.idx = peer_count;
-      ble_store_read_cccd(&key.cccd, &peer_cccd_set[i].cccd);
-    }
-
-    /* Wakeup Spi and SpiNorFlash before accessing the file system
-     * This should be fixed in the FS driver
-     */
-    systemTask.PushMessage(Pinetime::System::Messages::GoToRunning);
-    systemTask.PushMessage(Pinetime::System::Messages::DisableSleeping);
-    vTaskDelay(10);
-
-    lfs_file_t file_p;
-
-    rc = fs.FileOpen(&file_p, "/bond.dat", LFS_O_WRONLY | LFS_O_CREAT);
-    if (rc == 0) {
-      fs.FileWrite(&file_p, reinterpret_cast<uint8_t*>(&our_sec.sec), sizeof our_sec);
-      fs.FileWrite(&file_p, reinterpret_cast<uint8_t*>(&peer_sec.sec), sizeof peer_sec);
-      fs.FileWrite(&file_p, reinterpret_cast<const uint8_t*>(&peer_count), 1);
-      for (int i = 0; i < peer_count; i++) {
-        fs.FileWrite(&file_p, reinterpret_cast<uint8_t*>(&peer_cccd_set[i].cccd), sizeof(struct ble_store_value_cccd));
-      }
-      fs.FileClose(&file_p);
-    }
-    systemTask.PushMessage(Pinetime::System::Messages::EnableSleeping);
-  }
-}
-
-void NimbleController::RestoreBond() {
-  lfs_file_t file_p;
-  union ble_store_value sec, cccd;
-  uint8_t peer_count = 0;
-
-  if (fs.FileOpen(&file_p, "/bond.dat", LFS_O_RDONLY) == 0) {
-    memset(&sec, 0, sizeof sec);
-    fs.FileRead(&file_p, reinterpret_cast<uint8_t*>(&sec.sec), sizeof sec);
-    ble_store_write_our_sec(&sec.sec);
-
-    memset(&sec, 0, sizeof sec);
-    fs.FileRead(&file_p, reinterpret_cast<uint8_t*>(&sec.sec), sizeof sec);
-    ble_store_write_peer_sec(&sec.sec);
-
-    fs.FileRead(&file_p, &peer_count, 1);
-    for (int i = 0; i < peer_count; i++) {
-      fs.FileRead(&file_p, reinterpret_cast<uint8_t*>(&cccd.cccd), sizeof(struct ble_store_value_cccd));
-      ble_store_write_cccd(&cccd.cccd);
-    }
-
-    fs.FileClose(&file_p);
-    fs.FileDelete("/bond.dat");
-  }
-}
@@ -10,6 +10,8 @@
 #include "components/ble/AlertNotificationClient.h"
 #include "components/ble/AlertNotificationService.h"
 #include "components/ble/BatteryInformationService.h"
+#include "components/ble/BondStore.h"
+#include "components/ble/ConnectionPolicy.h"
 #include "components/ble/CurrentTimeClient.h"
 #include "components/ble/CurrentTimeService.h"
 #include "components/ble/DeviceInformationService.h"
@@ -22,6 +24,7 @@
 #include "components/ble/ServiceDiscovery.h"
 #include "components/ble/MotionService.h"
 #include "components/ble/SimpleWeatherService.h"
+#include "components/ble/SystemStatsService.h"
 #include "components/fs/FS.h"
 
 namespace Pinetime {
@@ -82,15 +85,14 @@ namespace Pinetime {
       void DisableRadio();
 
     private:
-      void PersistBond(struct ble_gap_conn_desc& desc);
-      void RestoreBond();
-
       static constexpr const char* deviceName = "InfiniTime";
       Pinetime::System::SystemTask& systemTask;
       Ble& bleController;
       DateTime& dateTimeController;
       Pinetime::Drivers::SpiNorFlash& spiNorFlash;
       FS& fs;
+      BondStore bondStore;
+      ConnectionPolicy connectionPolicy;
       DfuService dfuService;
 
       DeviceInformationService deviceInformationService;
@@ -106,12 +108,12 @@ namespace Pinetime {
       HeartRateService heartRateService;
       MotionService motionService;
       FSService fsService;
+      SystemStatsService systemStatsService;
       ServiceDiscovery serviceDiscovery;
 
       uint8_t addrType;
       uint16_t connectionHandle = BLE_HS_CONN_HANDLE_NONE;
       uint8_t fastAdvCount = 0;
-      uint8_t bondId[16] = {0};
 
       ble_uuid128_t dfuServiceUuid {
         .u {.type = BLE_UUID_TYPE_128},
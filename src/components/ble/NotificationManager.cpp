@@ -1,123 +1,159 @@
 #include "components/ble/NotificationManager.h"
 #include <cstring>
 #include <algorithm>
-#include <cassert>
+#include <libraries/log/nrf_log.h>
+#include "components/fs/FS.h"
 
 using namespace Pinetime::Controllers;
 
-constexpr uint8_t NotificationManager::MessageSize;
+namespace {
+  class LockGuard {
+  public:
+    explicit LockGuard(SemaphoreHandle_t mutex) : mutex {mutex} {
+      xSemaphoreTake(mutex, portMAX_DELAY);
+    }
 
-void NotificationManager::Push(NotificationManager::Notification&& notif) {
-  notif.id = GetNextId();
-  notif.valid = true;
-  newNotification = true;
-  if (beginIdx > 0) {
-    --beginIdx;
-  } else {
-    beginIdx = notifications.size() - 1;
-  }
-  notifications[beginIdx] = std::move(notif);
-  if (size < notifications.size()) {
-    size++;
-  }
+    ~LockGuard() {
+      xSemaphoreGive(mutex);
+    }
+
+    LockGuard(const LockGuard&) = delete;
+    LockGuard& operator=(const LockGuard&) = delete;
+
+  private:
+    SemaphoreHandle_t mutex;
+  };
 }
 
-NotificationManager::Notification::Id NotificationManager::GetNextId() {
-  return nextId++;
+NotificationManager::NotificationManager(FS& fs) : fs {fs} {
 }
 
-NotificationManager::Notification NotificationManager::GetLastNotification() const {
-  if (this->IsEmpty()) {
-    return {};
+void NotificationManager::Init() {
+  mutex = xSemaphoreCreateMutex();
+
+  // The history is not restored after a reset: start with an empty log
+  lfs_file_t file;
+  logAvailable = fs.FileOpen(&file, logPath, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) == LFS_ERR_OK;
+  if (logAvailable) {
+    fs.FileClose(&file);
+  } else {
+    NRF_LOG_INFO("[NotificationManager] Could not create the log, the history is limited to the RAM");
   }
-  return this->At(0);
 }
 
-const NotificationManager::Notification& NotificationManager::At(NotificationManager::Notification::Idx idx) const {
-  if (idx >= notifications.size()) {
-    assert(false);
-    return notifications.at(beginIdx); // this should not happen
+void NotificationManager::Push(NotificationManager::Notification&& notif) {
+  LockGuard lock {mutex};
+
+  // Keep the text null-terminated, even if the service didn't
+  uint8_t size = std::min<uint8_t>(notif.size, MessageSize + 1);
+  if (size == 0) {
+    notif.message[0] = '\0';
+    size = 1;
   }
-  size_t read_idx = (beginIdx + idx) % notifications.size();
-  return notifications.at(read_idx);
-}
+  notif.message[size - 1] = '\0';
+
+  if (historyCount == historySize) {
+    // The oldest notification leaves the history, its record in the log is dropped by the next compaction
+    const Id oldest = static_cast<Id>(NextId() - historySize);
+    if (IsLive(oldest)) {
+      SetLive(oldest, false);
+      nbNotifications--;
+      if (IsInArena(oldest)) {
+        RemoveFromArena(oldest);
+        arenaOldestId = static_cast<Id>(oldest + 1);
+      }
+    }
+  } else {
+    historyCount++;
+  }
+  const Id id = static_cast<Id>(nextSerial++);
 
-NotificationManager::Notification& NotificationManager::At(NotificationManager::Notification::Idx idx) {
-  if (idx >= notifications.size()) {
-    assert(false);
-    return notifications.at(beginIdx); // this should not happen
+  while (arenaUsed + headerSize + size > arenaSize) {
+    SpillOldest();
   }
-  size_t read_idx = (beginIdx + idx) % notifications.size();
-  return notifications.at(read_idx);
+  if (arenaUsed == 0) {
+    arenaOldestId = id;
+  }
+
+  const RecordHeader header {id, notif.category, size};
+  std::memcpy(&arena[arenaUsed], &header, headerSize);
+  std::memcpy(&arena[arenaUsed + headerSize], notif.message.data(), size);
+  arenaUsed += headerSize + size;
+
+  SetLive(id, true);
+  nbNotifications++;
+  newNotification = true;
 }
 
-NotificationManager::Notification::Idx NotificationManager::IndexOf(NotificationManager::Notification::Id id) const {
-  for (NotificationManager::Notification::Idx idx = 0; idx < this->size; idx++) {
-    const NotificationManager::Notification& notification = this->At(idx);
-    if (notification.id == id) {
-      return idx;
+NotificationManager::NotificationView NotificationManager::GetLastNotification() {
+  LockGuard lock {mutex};
+  for (size_t age = 1; age <= historyCount; age++) {
+    const Id id = static_cast<Id>(NextId() - age);
+    if (IsLive(id)) {
+      return GetUnlocked(id);
     }
   }
-  return size;
+  return {};
 }
 
-NotificationManager::Notification NotificationManager::Get(NotificationManager::Notification::Id id) const {
-  NotificationManager::Notification::Idx idx = this->IndexOf(id);
-  if (idx == this->size) {
-    return {};
-  }
-  return this->At(idx);
+NotificationManager::NotificationView NotificationManager::Get(Id id) {
+  LockGuard lock {mutex};
+  return GetUnlocked(id);
 }
 
-NotificationManager::Notification NotificationManager::GetNext(NotificationManager::Notification::Id id) const {
-  NotificationManager::Notification::Idx idx = this->IndexOf(id);
-  if (idx == this->size) {
+NotificationManager::NotificationView NotificationManager::GetNext(Id id) {
+  LockGuard lock {mutex};
+  if (!IsLive(id)) {
     return {};
   }
-  if (idx == 0 || idx > notifications.size()) {
-    return {};
+  for (size_t age = Age(id) - 1; age >= 1; age--) {
+    const Id next = static_cast<Id>(NextId() - age);
+    if (IsLive(next)) {
+      return GetUnlocked(next);
+    }
   }
-  return this->At(idx - 1);
+  return {};
 }
 
-NotificationManager::Notification NotificationManager::GetPrevious(NotificationManager::Notification::Id id) const {
-  NotificationManager::Notification::Idx idx = this->IndexOf(id);
-  if (idx == this->size) {
+NotificationManager::NotificationView NotificationManager::GetPrevious(Id id) {
+  LockGuard lock {mutex};
+  if (!IsLive(id)) {
     return {};
   }
-  if (static_cast<size_t>(idx + 1) >= notifications.size()) {
-    return {};
+  for (size_t age = Age(id) + 1; age <= historyCount; age++) {
+    const Id previous = static_cast<Id>(NextId() - age);
+    if (IsLive(previous)) {
+      return GetUnlocked(previous);
+    }
   }
-  return this->At(idx + 1);
+  return {};
 }
 
-void NotificationManager::DismissIdx(NotificationManager::Notification::Idx idx) {
-  if (this->IsEmpty()) {
-    return;
-  }
-  if (idx >= size) {
-    assert(false);
-    return; // this should not happen
+NotificationManager::Idx NotificationManager::IndexOf(Id id) const {
+  LockGuard lock {mutex};
+  if (!IsLive(id)) {
+    return nbNotifications;
   }
-  if (idx == 0) { // just remove the first element, don't need to change the other elements
-    notifications.at(beginIdx).valid = false;
-    beginIdx = (beginIdx + 1) % notifications.size();
-  } else {
-    // overwrite the specified entry by moving all later messages one index to the front
-    for (size_t i = idx; i < size - 1; ++i) {
-      this->At(i) = this->At(i + 1);
+  Idx idx = 0;
+  for (size_t age = 1; age < Age(id); age++) {
+    if (IsLive(static_cast<Id>(NextId() - age))) {
+      idx++;
     }
-    this->At(size - 1).valid = false;
   }
-  --size;
+  return idx;
 }
 
-void NotificationManager::Dismiss(NotificationManager::Notification::Id id) {
-  NotificationManager::Notification::Idx idx = this->IndexOf(id);
-  if (idx == this->size) {
+void NotificationManager::Dismiss(Id id) {
+  LockGuard lock {mutex};
+  if (!IsLive(id)) {
     return;
   }
-  this->DismissIdx(idx);
+  SetLive(id, false);
+  nbNotifications--;
+  // Records in the log are only marked as dismissed, they are dropped by the next compaction
+  if (IsInArena(id)) {
+    RemoveFromArena(id);
+  }
 }
 
 bool NotificationManager::AreNewNotificationsAvailable() const {
@@ -129,22 +165,241 @@ bool NotificationManager::ClearNewNotificationFlag() {
 }
 
 size_t NotificationManager::NbNotifications() const {
-  return size;
+  return nbNotifications;
 }
 
-const char* NotificationManager::Notification::Message() const {
-  const char* itField = std::find(message.begin(), message.begin() + size - 1, '\0');
-  if (itField != message.begin() + size - 1) {
-    const char* ptr = (itField) + 1;
-    return ptr;
+bool NotificationManager::IsLive(Id id) const {
+  const Id age = Age(id);
+  if (age == 0 || age > historyCount) {
+    return false;
   }
-  return const_cast<char*>(message.data());
+  const size_t slot = id % historySize;
+  return (liveBits[slot / 8] & (1 << (slot % 8))) != 0;
 }
 
-const char* NotificationManager::Notification::Title() const {
-  const char* itField = std::find(message.begin(), message.begin() + size - 1, '\0');
-  if (itField != message.begin() + size - 1) {
-    return message.data();
+void NotificationManager::SetLive(Id id, bool live) {
+  const size_t slot = id % historySize;
+  if (live) {
+    liveBits[slot / 8] |= (1 << (slot % 8));
+  } else {
+    liveBits[slot / 8] &= ~(1 << (slot % 8));
+  }
+}
+
+bool NotificationManager::IsInArena(Id id) const {
+  return arenaUsed > 0 && Age(id) <= Age(arenaOldestId);
+}
+
+NotificationManager::NotificationView NotificationManager::GetUnlocked(Id id) {
+  if (!IsLive(id)) {
+    return {};
+  }
+  if (IsInArena(id)) {
+    return FindInArena(id);
+  }
+  return ReadSpilled(id);
+}
+
+NotificationManager::NotificationView NotificationManager::FindInArena(Id id) const {
+  size_t offset = 0;
+  while (offset < arenaUsed) {
+    RecordHeader header;
+    std::memcpy(&header, &arena[offset], headerSize);
+    if (header.id == id) {
+      NotificationView view;
+      std::memcpy(view.text.data(), &arena[offset + headerSize], header.size);
+      view.id = id;
+      view.category = header.category;
+      view.valid = true;
+      view.size = header.size;
+      return view;
+    }
+    offset += headerSize + header.size;
+  }
+  return {};
+}
+
+NotificationManager::NotificationView NotificationManager::ReadSpilled(Id id) const {
+  if (!logAvailable || logRecords == 0) {
+    return {};
+  }
+  // Start from the last indexed record that is not newer than the notification
+  const uint32_t serial = Serial(id);
+  size_t entry = (logRecords - 1) / logIndexStride;
+  while (entry > 0 && logIndex[entry].serial > serial) {
+    entry--;
+  }
+
+  lfs_file_t file;
+  if (fs.FileOpen(&file, logPath, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return {};
+  }
+  LogHeader header;
+  NotificationView view;
+  bool found = false;
+  size_t offset = logIndex[entry].offset;
+  for (size_t i = 0; i < logIndexStride && offset < logSize; i++) {
+    if (fs.FileSeek(&file, offset) < 0 ||
+        fs.FileRead(&file, reinterpret_cast<uint8_t*>(&header), sizeof(header)) != static_cast<int>(sizeof(header)) ||
+        header.serial > serial) {
+      break;
+    }
+    if (header.serial == serial) {
+      found = header.size > 0 && header.size <= view.text.size() &&
+              fs.FileRead(&file, reinterpret_cast<uint8_t*>(view.text.data()), header.size) == header.size;
+      break;
+    }
+    offset += sizeof(header) + header.size;
+  }
+  fs.FileClose(&file);
+
+  if (!found) {
+    return {};
+  }
+  view.text[header.size - 1] = '\0';
+  view.id = id;
+  view.category = header.category;
+  view.valid = true;
+  view.size = header.size;
+  return view;
+}
+
+void NotificationManager::SpillOldest() {
+  RecordHeader header;
+  std::memcpy(&header, &arena[0], headerSize);
+  const size_t recordSize = headerSize + header.size;
+
+  if (!WriteSpilled(header, &arena[headerSize])) {
+    // The notification can't be paged back in: drop it from the history
+    SetLive(header.id, false);
+    nbNotifications--;
+  }
+
+  arenaUsed -= recordSize;
+  std::memmove(&arena[0], &arena[recordSize], arenaUsed);
+  arenaOldestId = static_cast<Id>(header.id + 1);
+}
+
+bool NotificationManager::WriteSpilled(const RecordHeader& header, const uint8_t* text) {
+  if (!logAvailable) {
+    return false;
+  }
+  const size_t recordSize = sizeof(LogHeader) + header.size;
+  if ((logRecords == maxLogRecords || logSize + recordSize > maxLogSize) && !CompactLog()) {
+    return false;
+  }
+  lfs_file_t file;
+  if (fs.FileOpen(&file, logPath, LFS_O_WRONLY) != LFS_ERR_OK) {
+    return false;
+  }
+  // Each spilled notification is a single append at the end of the log
+  const LogHeader logHeader {Serial(header.id), header.category, header.size};
+  bool ok = fs.FileSeek(&file, logSize) >= 0 &&
+            fs.FileWrite(&file, reinterpret_cast<const uint8_t*>(&logHeader), sizeof(logHeader)) == static_cast<int>(sizeof(logHeader)) &&
+            fs.FileWrite(&file, text, header.size) == header.size;
+  fs.FileClose(&file);
+  if (!ok) {
+    return false;
+  }
+
+  if (logRecords % logIndexStride == 0) {
+    logIndex[logRecords / logIndexStride] = {logHeader.serial, static_cast<uint16_t>(logSize)};
+  }
+  logSize += recordSize;
+  logRecords++;
+  return true;
+}
+
+bool NotificationManager::CompactLog() {
+  lfs_file_t log;
+  if (fs.FileOpen(&log, logPath, LFS_O_RDONLY) != LFS_ERR_OK) {
+    return false;
+  }
+  lfs_file_t compacted;
+  if (fs.FileOpen(&compacted, compactedLogPath, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    fs.FileClose(&log);
+    return false;
+  }
+
+  // Copy the records that are still live and in the history, the others can't be read anymore
+  std::array<LogIndexEntry, maxLogRecords / logIndexStride> compactedIndex;
+  std::array<uint8_t, sizeof(LogHeader) + MessageSize + 1> record;
+  size_t compactedSize = 0;
+  size_t compactedRecords = 0;
+  size_t offset = 0;
+  bool ok = true;
+  for (size_t i = 0; i < logRecords && ok; i++) {
+    LogHeader header;
+    ok = fs.FileSeek(&log, offset) >= 0 &&
+         fs.FileRead(&log, reinterpret_cast<uint8_t*>(&header), sizeof(header)) == static_cast<int>(sizeof(header)) &&
+         header.size <= MessageSize + 1;
+    if (!ok) {
+      break;
+    }
+    const size_t recordSize = sizeof(header) + header.size;
+    const Id id = static_cast<Id>(header.serial);
+    if (nextSerial - header.serial <= historyCount && IsLive(id)) {
+      std::memcpy(record.data(), &header, sizeof(header));
+      ok = fs.FileRead(&log, record.data() + sizeof(header), header.size) == header.size &&
+           fs.FileWrite(&compacted, record.data(), recordSize) == static_cast<int>(recordSize);
+      if (compactedRecords % logIndexStride == 0) {
+        compactedIndex[compactedRecords / logIndexStride] = {header.serial, static_cast<uint16_t>(compactedSize)};
+      }
+      compactedSize += recordSize;
+      compactedRecords++;
+    }
+    offset += recordSize;
+  }
+  fs.FileClose(&log);
+  fs.FileClose(&compacted);
+
+  // The old log is kept until the new one is complete
+  if (!ok || fs.Rename(compactedLogPath, logPath) != LFS_ERR_OK) {
+    NRF_LOG_INFO("[NotificationManager] Could not compact the log");
+    fs.FileDelete(compactedLogPath);
+    return false;
+  }
+  logIndex = compactedIndex;
+  logSize = compactedSize;
+  logRecords = compactedRecords;
+  return true;
+}
+
+void NotificationManager::RemoveFromArena(Id id) {
+  size_t offset = 0;
+  while (offset < arenaUsed) {
+    RecordHeader header;
+    std::memcpy(&header, &arena[offset], headerSize);
+    const size_t recordSize = headerSize + header.size;
+    if (header.id == id) {
+      std::memmove(&arena[offset], &arena[offset + recordSize], arenaUsed - offset - recordSize);
+      arenaUsed -= recordSize;
+      return;
+    }
+    offset += recordSize;
+  }
+}
+
+const char* NotificationManager::NotificationView::Message() const {
+  if (size == 0) {
+    return "";
+  }
+  const char* end = text.data() + size - 1;
+  const char* itField = std::find(text.data(), end, '\0');
+  if (itField != end) {
+    return itField + 1;
+  }
+  return text.data();
+}
+
+const char* NotificationManager::NotificationView::Title() const {
+  if (size == 0) {
+    return {};
+  }
+  const char* end = text.data() + size - 1;
+  const char* itField = std::find(text.data(), end, '\0');
+  if (itField != end) {
+    return text.data();
   }
   return {};
 }
@@ -4,12 +4,28 @@
 #include <atomic>
 #include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
 
 namespace Pinetime {
   namespace Controllers {
+    class FS;
+
+    /**
+     * History of the notifications received from the companion app.
+     *
+     * The most recent notifications are stored in a small RAM arena as variable-length records (a header followed by the
+     * title and body), so that short notifications don't use a full MessageSize buffer. When the arena is full, the oldest
+     * records are appended to a log in the file system and are paged back in when they are displayed. The log is never
+     * written in the middle, which would make littlefs copy the rest of the file: when it is full, the records still in the
+     * history are copied to a new log that replaces it.
+     *
+     * Get(), GetNext(), GetPrevious() and GetLastNotification() return a copy of the text, made while the mutex is held: the
+     * arena is compacted by Push() and Dismiss(), which may run on another task while the copy is displayed.
+     */
     class NotificationManager {
     public:
-      enum class Categories {
+      enum class Categories : uint8_t {
         Unknown,
         SimpleAlert,
         Email,
@@ -24,52 +40,129 @@ namespace Pinetime {
       };
       static constexpr uint8_t MessageSize {100};
 
-      struct Notification {
-        using Id = uint8_t;
-        using Idx = uint8_t;
+      using Id = uint16_t;
+      using Idx = uint16_t;
 
+      /** Notification filled by the services and passed to Push(). message contains the title, '\0', the body and '\0'. */
+      struct Notification {
         std::array<char, MessageSize + 1> message;
-        uint8_t size;
+        uint8_t size = 0;
         Categories category = Categories::Unknown;
+      };
+
+      struct NotificationView {
         Id id = 0;
+        Categories category = Categories::Unknown;
         bool valid = false;
+        // The title, '\0', the body and '\0', only the first size bytes are set
+        std::array<char, MessageSize + 1> text;
+        uint8_t size = 0;
 
         const char* Message() const;
         const char* Title() const;
       };
 
+      explicit NotificationManager(FS& fs);
+
+      /** Clears the log of the previous session. Must be called once the file system is initialized. */
+      void Init();
+
       void Push(Notification&& notif);
-      Notification GetLastNotification() const;
-      Notification Get(Notification::Id id) const;
-      Notification GetNext(Notification::Id id) const;
-      Notification GetPrevious(Notification::Id id) const;
+      NotificationView GetLastNotification();
+      NotificationView Get(Id id);
+      NotificationView GetNext(Id id);
+      NotificationView GetPrevious(Id id);
       // Return the index of the notification with the specified id, if not found return NbNotifications()
-      Notification::Idx IndexOf(Notification::Id id) const;
+      Idx IndexOf(Id id) const;
       bool ClearNewNotificationFlag();
       bool AreNewNotificationsAvailable() const;
-      void Dismiss(Notification::Id id);
+      void Dismiss(Id id);
 
       static constexpr size_t MaximumMessageSize() {
         return MessageSize;
       };
 
       bool IsEmpty() const {
-        return size == 0;
+        return nbNotifications == 0;
       }
 
       size_t NbNotifications() const;
 
     private:
-      Notification::Id nextId {0};
-      Notification::Id GetNextId();
-      const Notification& At(Notification::Idx idx) const;
-      Notification& At(Notification::Idx idx);
-      void DismissIdx(Notification::Idx idx);
-
-      static constexpr uint8_t TotalNbNotifications = 5;
-      std::array<Notification, TotalNbNotifications> notifications;
-      size_t beginIdx = TotalNbNotifications - 1; // index of the newest notification
-      size_t size = 0;                            // number of valid notifications in buffer
+      struct RecordHeader {
+        Id id;
+        Categories category;
+        uint8_t size;
+      };
+
+      // Records of the log are identified by a serial number that doesn't wrap around, so that they stay sorted
+      struct LogHeader {
+        uint32_t serial;
+        Categories category;
+        uint8_t size;
+      };
+
+      // Offset of one record out of logIndexStride in the log
+      struct LogIndexEntry {
+        uint32_t serial;
+        uint16_t offset;
+      };
+
+      static constexpr size_t headerSize = sizeof(RecordHeader);
+      static constexpr size_t arenaSize = 384;
+      // Number of notifications kept in the history, in RAM and in the log. Must divide 2^16 so that the live bit of an id
+      // doesn't change when the ids wrap around.
+      static constexpr size_t historySize = 256;
+      // The log is compacted when it reaches either limit: twice the history, so that a compaction happens at most once
+      // every historySize notifications
+      static constexpr size_t maxLogRecords = 2 * historySize;
+      static constexpr size_t maxLogSize = 32 * 1024;
+      static constexpr size_t logIndexStride = 32;
+      static constexpr const char* logPath = "/notifs.log";
+      static constexpr const char* compactedLogPath = "/notifs.tmp";
+
+      Id NextId() const {
+        return static_cast<Id>(nextSerial);
+      }
+
+      // Age of a notification: 1 for the newest one, historyCount for the oldest one still in the history
+      Id Age(Id id) const {
+        return static_cast<Id>(NextId() - id);
+      }
+
+      uint32_t Serial(Id id) const {
+        return nextSerial - Age(id);
+      }
+
+      bool IsLive(Id id) const;
+      void SetLive(Id id, bool live);
+      bool IsInArena(Id id) const;
+      NotificationView GetUnlocked(Id id);
+      NotificationView FindInArena(Id id) const;
+      NotificationView ReadSpilled(Id id) const;
+      void SpillOldest();
+      bool WriteSpilled(const RecordHeader& header, const uint8_t* text);
+      bool CompactLog();
+      void RemoveFromArena(Id id);
+
+      FS& fs;
+      SemaphoreHandle_t mutex = nullptr;
+
+      // Records ordered from the oldest to the newest, without any gap
+      std::array<uint8_t, arenaSize> arena;
+      size_t arenaUsed = 0;
+      // Notifications older than this one are in the log
+      Id arenaOldestId = 0;
+
+      // One bit per notification of the history, indexed by id % historySize, cleared when the notification is dismissed
+      std::array<uint8_t, historySize / 8> liveBits {};
+      uint32_t nextSerial = 0;
+      size_t historyCount = 0;
+      size_t nbNotifications = 0;
+      bool logAvailable = false;
+      std::array<LogIndexEntry, maxLogRecords / logIndexStride> logIndex;
+      size_t logSize = 0;
+      size_t logRecords = 0;
 
       std::atomic<bool> newNotification {false};
     };
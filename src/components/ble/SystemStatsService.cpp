@@ -0,0 +1,119 @@
+#include "components/ble/SystemStatsService.h"
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <heap_infinitime.h>
+#include <trace_infinitime.h>
+#include "systemtask/SystemMonitor.h"
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  // 0006yyxx-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t CharUuid(uint8_t x, uint8_t y) {
+    return ble_uuid128_t {.u = {.type = BLE_UUID_TYPE_128},
+                          .value = {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, x, y, 0x06, 0x00}};
+  }
+
+  // 00060000-78fc-48fe-8e23-433b3a1942d0
+  constexpr ble_uuid128_t BaseUuid() {
+    return CharUuid(0x00, 0x00);
+  }
+
+  constexpr ble_uuid128_t systemStatsServiceUuid {BaseUuid()};
+  constexpr ble_uuid128_t taskLoadsCharUuid {CharUuid(0x01, 0x00)};
+  constexpr ble_uuid128_t traceEventsCharUuid {CharUuid(0x02, 0x00)};
+  constexpr ble_uuid128_t heapSnapshotCharUuid {CharUuid(0x03, 0x00)};
+  constexpr ble_uuid128_t heapFailureCharUuid {CharUuid(0x04, 0x00)};
+
+  // Only the entries of the tag table that are used are sent
+  int AppendSnapshot(os_mbuf* om, const void* data, size_t fixedSize, const HeapSnapshot_t& snapshot) {
+    const size_t size = fixedSize + snapshot.ulNbTags * sizeof(HeapTagStats_t);
+    return os_mbuf_append(om, data, size);
+  }
+
+  int SystemStatsServiceCallback(uint16_t /*conn_handle*/, uint16_t attr_handle, struct ble_gatt_access_ctxt* ctxt, void* arg) {
+    auto* systemStatsService = static_cast<SystemStatsService*>(arg);
+    return systemStatsService->OnRead(attr_handle, ctxt);
+  }
+}
+
+SystemStatsService::SystemStatsService(const System::SystemMonitor& monitor)
+  : monitor {monitor},
+    characteristicDefinition {{.uuid = &taskLoadsCharUuid.u,
+                               .access_cb = SystemStatsServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &taskLoadsHandle},
+                              {.uuid = &traceEventsCharUuid.u,
+                               .access_cb = SystemStatsServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &traceEventsHandle},
+                              {.uuid = &heapSnapshotCharUuid.u,
+                               .access_cb = SystemStatsServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &heapSnapshotHandle},
+                              {.uuid = &heapFailureCharUuid.u,
+                               .access_cb = SystemStatsServiceCallback,
+                               .arg = this,
+                               .flags = BLE_GATT_CHR_F_READ,
+                               .val_handle = &heapFailureHandle},
+                              {0}},
+    serviceDefinition {
+      {.type = BLE_GATT_SVC_TYPE_PRIMARY, .uuid = &systemStatsServiceUuid.u, .characteristics = characteristicDefinition},
+      {0},
+    } {
+}
+
+void SystemStatsService::Init() {
+  int res = 0;
+  res = ble_gatts_count_cfg(serviceDefinition);
+  ASSERT(res == 0);
+
+  res = ble_gatts_add_svcs(serviceDefinition);
+  ASSERT(res == 0);
+}
+
+int SystemStatsService::OnRead(uint16_t attributeHandle, ble_gatt_access_ctxt* context) {
+  if (attributeHandle == taskLoadsHandle) {
+    std::array<System::SystemMonitor::TaskLoad, System::SystemMonitor::maxTasks> loads;
+    const uint8_t nb = monitor.GetTaskLoads(loads);
+    for (uint8_t i = 0; i < nb; i++) {
+      // number (1 byte), name (4 bytes, null-padded), load (uint16_t, 1/10 %)
+      static_assert(sizeof(loads[i].name) == 4);
+      uint8_t buffer[7] = {loads[i].number};
+      std::memcpy(&buffer[1], loads[i].name, sizeof(loads[i].name));
+      buffer[5] = loads[i].load & 0xff;
+      buffer[6] = loads[i].load >> 8;
+      if (os_mbuf_append(context->om, buffer, sizeof(buffer)) != 0) {
+        return BLE_ATT_ERR_INSUFFICIENT_RES;
+      }
+    }
+    return 0;
+  }
+
+  if (attributeHandle == traceEventsHandle) {
+    // The events are read in the BLE host task, which has a small stack
+    static std::array<TraceEvent_t, TRACE_RING_SIZE> events;
+    const uint32_t nb = ulTraceGetEvents(events.data(), events.size());
+    int res = os_mbuf_append(context->om, events.data(), nb * sizeof(TraceEvent_t));
+    return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+  }
+
+  if (attributeHandle == heapSnapshotHandle) {
+    static HeapSnapshot_t snapshot;
+    vPortGetHeapSnapshot(&snapshot);
+    int res = AppendSnapshot(context->om, &snapshot, offsetof(HeapSnapshot_t, xTags), snapshot);
+    return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+  }
+
+  if (attributeHandle == heapFailureHandle) {
+    static HeapFailure_t failure;
+    vPortGetLastHeapFailure(&failure);
+    int res = AppendSnapshot(context->om, &failure, offsetof(HeapFailure_t, xSnapshot.xTags), failure.xSnapshot);
+    return (res == 0) ? 0 : BLE_ATT_ERR_INSUFFICIENT_RES;
+  }
+  return 0;
+}
@@ -0,0 +1,33 @@
+#pragma once
+#define min // workaround: nimble's min/max macros conflict with libstdc++
+#define max
+#include <host/ble_gap.h>
+#undef max
+#undef min
+
+namespace Pinetime {
+  namespace System {
+    class SystemMonitor;
+  }
+
+  namespace Controllers {
+    // Read-only access to the CPU load of the tasks, to the trace ring and to the heap statistics (see doc/SystemStatsService.md)
+    class SystemStatsService {
+    public:
+      explicit SystemStatsService(const System::SystemMonitor& monitor);
+      void Init();
+      int OnRead(uint16_t attributeHandle, ble_gatt_access_ctxt* context);
+
+    private:
+      const System::SystemMonitor& monitor;
+
+      struct ble_gatt_chr_def characteristicDefinition[5];
+      struct ble_gatt_svc_def serviceDefinition[2];
+
+      uint16_t taskLoadsHandle;
+      uint16_t traceEventsHandle;
+      uint16_t heapSnapshotHandle;
+      uint16_t heapFailureHandle;
+    };
+  }
+}
@@ -9,33 +9,67 @@ namespace {
   char const* DaysStringShortLow[] = {"--", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat", "Sun"};
   char const* MonthsString[] = {"--", "JAN", "FEB", "MAR", "APR", "MAY", "JUN", "JUL", "AUG", "SEP", "OCT", "NOV", "DEC"};
   char const* MonthsStringLow[] = {"--", "Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+
+  constexpr int32_t secondsPerDay = 24 * 60 * 60;
+  constexpr int32_t secondsPerHalfHour = 30 * 60;
+
+  constexpr bool IsLeapYear(int year) {
+    return (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+  }
+
+  constexpr int DaysInMonth(int year, int month) {
+    constexpr uint8_t daysInMonth[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    if (month == 1 && IsLeapYear(year)) {
+      return 29;
+    }
+    return daysInMonth[month];
+  }
+
+  // Civil date <-> days since 1970-01-01 conversions, see http://howardhinnant.github.io/date_algorithms.html
+  constexpr int32_t DaysFromCivil(int year, int month, int day) {
+    year -= month <= 2;
+    const int32_t era = (year >= 0 ? year : year - 399) / 400;
+    const uint32_t yoe = static_cast<uint32_t>(year - era * 400);
+    const uint32_t doy = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 + day - 1;
+    const uint32_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + static_cast<int32_t>(doe) - 719468;
+  }
+
+  constexpr void CivilFromDays(int32_t days, int& year, int& month, int& day) {
+    days += 719468;
+    const int32_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const uint32_t doe = static_cast<uint32_t>(days - era * 146097);
+    const uint32_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const uint32_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const uint32_t mp = (5 * doy + 2) / 153;
+    day = static_cast<int>(doy - (153 * mp + 2) / 5 + 1);
+    month = static_cast<int>(mp < 10 ? mp + 3 : mp - 9);
+    year = static_cast<int>(yoe) + era * 400 + (month <= 2);
+  }
 }
 
-DateTime::DateTime(Controllers::Settings& settingsController) : settingsController {settingsController} {
+DateTime::DateTime(Controllers::Settings& settingsController, Controllers::TimerWheel& timerWheel)
+  : settingsController {settingsController}, timerWheel {timerWheel} {
 }
 
 void DateTime::SetCurrentTime(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> t) {
   this->currentDateTime = t;
+  UpdateCalendar();
   UpdateTime(previousSystickCounter); // Update internal state without updating the time
+  ScheduleChime();
 }
 
 void DateTime::SetTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second) {
-  std::tm tm = {
-    /* .tm_sec  = */ second,
-    /* .tm_min  = */ minute,
-    /* .tm_hour = */ hour,
-    /* .tm_mday = */ day,
-    /* .tm_mon  = */ month - 1,
-    /* .tm_year = */ year - 1900,
-  };
-
-  tm.tm_isdst = -1; // Use DST value from local time zone
-  currentDateTime = std::chrono::system_clock::from_time_t(std::mktime(&tm));
+  int32_t days = DaysFromCivil(year, month, day);
+  currentDateTime = std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>(
+    std::chrono::seconds(static_cast<int64_t>(days) * secondsPerDay + hour * 3600 + minute * 60 + second));
+  UpdateCalendar();
 
   NRF_LOG_INFO("%d %d %d ", day, month, year);
   NRF_LOG_INFO("%d %d %d ", hour, minute, second);
 
   UpdateTime(previousSystickCounter);
+  ScheduleChime();
 
   systemTask->PushMessage(System::Messages::OnNewTime);
 }
@@ -43,6 +77,8 @@ void DateTime::SetTime(uint16_t year, uint8_t month, uint8_t day, uint8_t hour,
 void DateTime::SetTimeZone(int8_t timezone, int8_t dst) {
   tzOffset = timezone;
   dstOffset = dst;
+  UpdateCalendar();
+  ScheduleChime();
 }
 
 void DateTime::UpdateTime(uint32_t systickCounter) {
@@ -69,30 +105,10 @@ void DateTime::UpdateTime(uint32_t systickCounter) {
   currentDateTime += std::chrono::seconds(correctedDelta);
   uptime += std::chrono::seconds(correctedDelta);
 
-  std::time_t currentTime = std::chrono::system_clock::to_time_t(currentDateTime);
-  localTime = *std::localtime(&currentTime);
+  AdvanceCalendar(correctedDelta);
 
-  auto minute = Minutes();
   auto hour = Hours();
 
-  if (minute == 0 && !isHourAlreadyNotified) {
-    isHourAlreadyNotified = true;
-    if (systemTask != nullptr) {
-      systemTask->PushMessage(System::Messages::OnNewHour);
-    }
-  } else if (minute != 0) {
-    isHourAlreadyNotified = false;
-  }
-
-  if ((minute == 0 || minute == 30) && !isHalfHourAlreadyNotified) {
-    isHalfHourAlreadyNotified = true;
-    if (systemTask != nullptr) {
-      systemTask->PushMessage(System::Messages::OnNewHalfHour);
-    }
-  } else if (minute != 0 && minute != 30) {
-    isHalfHourAlreadyNotified = false;
-  }
-
   // Notify new day to SystemTask
   if (hour == 0 and not isMidnightAlreadyNotified) {
     isMidnightAlreadyNotified = true;
@@ -103,6 +119,101 @@ void DateTime::UpdateTime(uint32_t systickCounter) {
   }
 }
 
+void DateTime::ScheduleChime() {
+  // Make sure the chime isn't running while its state is updated
+  timerWheel.Cancel(TimerWheel::Events::Chime);
+
+  const uint32_t secondsSinceHalfHour = (localTime.tm_min % 30) * 60 + localTime.tm_sec;
+  nextChime = timerWheel.Now() + (secondsPerHalfHour - secondsSinceHalfHour) * TimerWheel::ticksPerSecond;
+  nextChimeIsHour = localTime.tm_min >= 30;
+  timerWheel.Schedule(TimerWheel::Events::Chime, nextChime, Chime, this);
+}
+
+void DateTime::Chime(void* context) {
+  auto* dateTime = static_cast<DateTime*>(context);
+  if (dateTime->systemTask != nullptr) {
+    if (dateTime->nextChimeIsHour) {
+      dateTime->systemTask->PushMessage(System::Messages::OnNewHour);
+    }
+    dateTime->systemTask->PushMessage(System::Messages::OnNewHalfHour);
+  }
+
+  // The timer wheel and the clock both count the ticks of the 32kHz crystal: the next chime is exactly half an hour later,
+  // until the time is set again
+  dateTime->nextChime += secondsPerHalfHour * TimerWheel::ticksPerSecond;
+  dateTime->nextChimeIsHour = !dateTime->nextChimeIsHour;
+  dateTime->timerWheel.Schedule(TimerWheel::Events::Chime, dateTime->nextChime, Chime, dateTime);
+}
+
+uint32_t DateTime::TicksToNextMinute(uint32_t systickCounter) const {
+  uint32_t elapsed = (systickCounter - previousSystickCounter) & 0xffffff;
+  uint32_t ticksToRollover = (60 - localTime.tm_sec) * 1024;
+  if (elapsed >= ticksToRollover) {
+    return 0;
+  }
+  return ticksToRollover - elapsed;
+}
+
+void DateTime::UpdateCalendar() {
+  auto secondsSinceEpoch = std::chrono::duration_cast<std::chrono::seconds>(currentDateTime.time_since_epoch()).count();
+  auto days = static_cast<int32_t>(secondsSinceEpoch / secondsPerDay);
+  auto secondsOfDay = static_cast<int32_t>(secondsSinceEpoch % secondsPerDay);
+  if (secondsOfDay < 0) {
+    secondsOfDay += secondsPerDay;
+    days--;
+  }
+
+  int year;
+  int month;
+  int day;
+  CivilFromDays(days, year, month, day);
+
+  localTime.tm_sec = secondsOfDay % 60;
+  localTime.tm_min = (secondsOfDay / 60) % 60;
+  localTime.tm_hour = secondsOfDay / 3600;
+  localTime.tm_mday = day;
+  localTime.tm_mon = month - 1;
+  localTime.tm_year = year - 1900;
+  // 1970-01-01 was a Thursday
+  localTime.tm_wday = ((days % 7) + 11) % 7;
+  localTime.tm_yday = days - DaysFromCivil(year, 1, 1);
+  localTime.tm_isdst = 0;
+}
+
+void DateTime::AdvanceCalendar(uint32_t seconds) {
+  if (seconds == 0) {
+    return;
+  }
+  // Large jumps (e.g. after the RTC counter was not read for a long time) are cheaper to recompute
+  if (seconds >= secondsPerDay) {
+    UpdateCalendar();
+    return;
+  }
+
+  uint32_t second = localTime.tm_sec + seconds;
+  localTime.tm_sec = second % 60;
+  uint32_t minute = localTime.tm_min + second / 60;
+  localTime.tm_min = minute % 60;
+  uint32_t hour = localTime.tm_hour + minute / 60;
+  localTime.tm_hour = hour % 24;
+  if (hour < 24) {
+    return;
+  }
+
+  localTime.tm_wday = (localTime.tm_wday + 1) % 7;
+  localTime.tm_yday++;
+  localTime.tm_mday++;
+  if (localTime.tm_mday > DaysInMonth(localTime.tm_year + 1900, localTime.tm_mon)) {
+    localTime.tm_mday = 1;
+    localTime.tm_mon++;
+    if (localTime.tm_mon > 11) {
+      localTime.tm_mon = 0;
+      localTime.tm_year++;
+      localTime.tm_yday = 0;
+    }
+  }
+}
+
 const char* DateTime::MonthShortToString() const {
   return MonthsString[static_cast<uint8_t>(Month())];
 }
@@ -121,6 +232,7 @@ const char* DateTime::DayOfWeekShortToStringLow() const {
 
 void DateTime::Register(Pinetime::System::SystemTask* systemTask) {
   this->systemTask = systemTask;
+  ScheduleChime();
 }
 
 using ClockType = Pinetime::Controllers::Settings::ClockType;
@@ -5,6 +5,7 @@
 #include <ctime>
 #include <string>
 #include "components/settings/Settings.h"
+#include "components/timer/TimerWheel.h"
 
 namespace Pinetime {
   namespace System {
@@ -14,7 +15,7 @@ namespace Pinetime {
   namespace Controllers {
     class DateTime {
     public:
-      DateTime(Controllers::Settings& settingsController);
+      DateTime(Controllers::Settings& settingsController, Controllers::TimerWheel& timerWheel);
       enum class Days : uint8_t { Unknown, Monday, Tuesday, Wednesday, Thursday, Friday, Saturday, Sunday };
       enum class Months : uint8_t {
         Unknown,
@@ -47,6 +48,14 @@ namespace Pinetime {
 
       void UpdateTime(uint32_t systickCounter);
 
+      /*
+       * returns the number of RTC ticks (1024 Hz) between systickCounter and
+       * the next minute rollover, 0 if the rollover is already due.
+       *
+       * Lets the caller sleep until the next minute instead of polling UpdateTime().
+       */
+      uint32_t TicksToNextMinute(uint32_t systickCounter) const;
+
       uint16_t Year() const {
         return 1900 + localTime.tm_year;
       }
@@ -124,6 +133,10 @@ namespace Pinetime {
       static const char* MonthShortToStringLow(Months month);
       const char* DayOfWeekShortToStringLow() const;
 
+      const std::tm& LocalTime() const {
+        return localTime;
+      }
+
       std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> CurrentDateTime() const {
         return currentDateTime;
       }
@@ -141,7 +154,16 @@ namespace Pinetime {
       std::string FormattedTime();
 
     private:
-      std::tm localTime;
+      // Full conversion of currentDateTime into localTime, only needed when the time is set
+      void UpdateCalendar();
+      // Cheap incremental update of localTime for the seconds elapsed since the last update
+      void AdvanceCalendar(uint32_t seconds);
+      // Schedules the chime of the next hour or half hour of the local time, must be called when the time is set
+      void ScheduleChime();
+      // Called from the interrupt of the timer wheel
+      static void Chime(void* context);
+
+      std::tm localTime {};
       int8_t tzOffset = 0;
       int8_t dstOffset = 0;
 
@@ -150,10 +172,11 @@ namespace Pinetime {
       std::chrono::seconds uptime {0};
 
       bool isMidnightAlreadyNotified = false;
-      bool isHourAlreadyNotified = true;
-      bool isHalfHourAlreadyNotified = true;
+      TimerWheel::Ticks nextChime = 0;
+      bool nextChimeIsHour = false;
       System::SystemTask* systemTask = nullptr;
       Controllers::Settings& settingsController;
+      Controllers::TimerWheel& timerWheel;
     };
   }
 }
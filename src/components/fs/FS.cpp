@@ -5,6 +5,13 @@
 
 using namespace Pinetime::Controllers;
 
+namespace {
+  void FlashIdleTimerCallback(TimerHandle_t xTimer) {
+    auto* fs = static_cast<FS*>(pvTimerGetTimerID(xTimer));
+    fs->OnFlashIdle();
+  }
+}
+
 FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
   : flashDriver {driver},
     lfsConfig {
@@ -29,6 +36,10 @@ FS::FS(Pinetime::Drivers::SpiNorFlash& driver)
 }
 
 void FS::Init() {
+  fsMutex = xSemaphoreCreateRecursiveMutex();
+  flashMutex = xSemaphoreCreateMutex();
+  flashIdleTimer = xTimerCreate("fsIdle", flashIdleTimeout, pdFALSE, this, FlashIdleTimerCallback);
+  Lock lock {*this};
 
   // try mount
   int err = lfs_mount(&lfs, &lfsConfig);
@@ -54,61 +65,113 @@ void FS::VerifyResource() {
 }
 
 int FS::FileOpen(lfs_file_t* file_p, const char* fileName, const int flags) {
+  Lock lock {*this};
   return lfs_file_open(&lfs, file_p, fileName, flags);
 }
 
 int FS::FileClose(lfs_file_t* file_p) {
+  Lock lock {*this};
   return lfs_file_close(&lfs, file_p);
 }
 
 int FS::FileRead(lfs_file_t* file_p, uint8_t* buff, uint32_t size) {
+  Lock lock {*this};
   return lfs_file_read(&lfs, file_p, buff, size);
 }
 
 int FS::FileWrite(lfs_file_t* file_p, const uint8_t* buff, uint32_t size) {
+  Lock lock {*this};
   return lfs_file_write(&lfs, file_p, buff, size);
 }
 
 int FS::FileSeek(lfs_file_t* file_p, uint32_t pos) {
+  Lock lock {*this};
   return lfs_file_seek(&lfs, file_p, pos, LFS_SEEK_SET);
 }
 
 int FS::FileDelete(const char* fileName) {
+  Lock lock {*this};
   return lfs_remove(&lfs, fileName);
 }
 
 int FS::DirOpen(const char* path, lfs_dir_t* lfs_dir) {
+  Lock lock {*this};
   return lfs_dir_open(&lfs, lfs_dir, path);
 }
 
 int FS::DirClose(lfs_dir_t* lfs_dir) {
+  Lock lock {*this};
   return lfs_dir_close(&lfs, lfs_dir);
 }
 
 int FS::DirRead(lfs_dir_t* dir, lfs_info* info) {
+  Lock lock {*this};
   return lfs_dir_read(&lfs, dir, info);
 }
 
 int FS::DirRewind(lfs_dir_t* dir) {
+  Lock lock {*this};
   return lfs_dir_rewind(&lfs, dir);
 }
 
 int FS::DirCreate(const char* path) {
+  Lock lock {*this};
   return lfs_mkdir(&lfs, path);
 }
 
 int FS::Rename(const char* oldPath, const char* newPath) {
+  Lock lock {*this};
   return lfs_rename(&lfs, oldPath, newPath);
 }
 
 int FS::Stat(const char* path, lfs_info* info) {
+  Lock lock {*this};
   return lfs_stat(&lfs, path, info);
 }
 
+int FS::GetAttribute(const char* path, uint8_t type, void* buffer, uint32_t size) {
+  Lock lock {*this};
+  return lfs_getattr(&lfs, path, type, buffer, size);
+}
+
+int FS::SetAttribute(const char* path, uint8_t type, const void* buffer, uint32_t size) {
+  Lock lock {*this};
+  return lfs_setattr(&lfs, path, type, buffer, size);
+}
+
 lfs_ssize_t FS::GetFSSize() {
+  Lock lock {*this};
   return lfs_fs_size(&lfs);
 }
 
+void FS::AcquireFlash() {
+  xSemaphoreTake(flashMutex, portMAX_DELAY);
+  if (!flashAcquired) {
+    flashDriver.Acquire();
+    flashAcquired = true;
+  }
+  flashUsers++;
+  xSemaphoreGive(flashMutex);
+}
+
+void FS::ReleaseFlash() {
+  xSemaphoreTake(flashMutex, portMAX_DELAY);
+  flashUsers--;
+  if (flashUsers == 0) {
+    xTimerReset(flashIdleTimer, 0);
+  }
+  xSemaphoreGive(flashMutex);
+}
+
+void FS::OnFlashIdle() {
+  xSemaphoreTake(flashMutex, portMAX_DELAY);
+  if (flashUsers == 0 && flashAcquired) {
+    flashDriver.Release();
+    flashAcquired = false;
+  }
+  xSemaphoreGive(flashMutex);
+}
+
 /*
 
     ----------- Interface between littlefs and SpiNorFlash -----------
@@ -120,6 +183,7 @@ int FS::SectorSync(const struct lfs_config* /*c*/) {
 
 int FS::SectorErase(const struct lfs_config* c, lfs_block_t block) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
+  FlashAccess flashAccess {lfs};
   const size_t address = startAddress + (block * blockSize);
   lfs.flashDriver.SectorErase(address);
   return lfs.flashDriver.EraseFailed() ? -1 : 0;
@@ -127,6 +191,7 @@ int FS::SectorErase(const struct lfs_config* c, lfs_block_t block) {
 
 int FS::SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, const void* buffer, lfs_size_t size) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
+  FlashAccess flashAccess {lfs};
   const size_t address = startAddress + (block * blockSize) + off;
   lfs.flashDriver.Write(address, (uint8_t*) buffer, size);
   return lfs.flashDriver.ProgramFailed() ? -1 : 0;
@@ -134,6 +199,7 @@ int FS::SectorProg(const struct lfs_config* c, lfs_block_t block, lfs_off_t off,
 
 int FS::SectorRead(const struct lfs_config* c, lfs_block_t block, lfs_off_t off, void* buffer, lfs_size_t size) {
   Pinetime::Controllers::FS& lfs = *(static_cast<Pinetime::Controllers::FS*>(c->context));
+  FlashAccess flashAccess {lfs};
   const size_t address = startAddress + (block * blockSize) + off;
   lfs.flashDriver.Read(address, static_cast<uint8_t*>(buffer), size);
   return 0;
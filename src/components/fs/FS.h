@@ -1,6 +1,9 @@
 #pragma once
 
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
+#include <timers.h>
 #include "drivers/SpiNorFlash.h"
 #include <littlefs/lfs.h>
 
@@ -29,6 +32,11 @@ namespace Pinetime {
       lfs_ssize_t GetFSSize();
       int Rename(const char* oldPath, const char* newPath);
       int Stat(const char* path, lfs_info* info);
+
+      // User attributes (up to 50 bytes, identified by type) stored in the metadata of a file or directory.
+      // GetAttribute returns the size of the attribute on disk, even if it's larger than the buffer.
+      int GetAttribute(const char* path, uint8_t type, void* buffer, uint32_t size);
+      int SetAttribute(const char* path, uint8_t type, const void* buffer, uint32_t size);
       void VerifyResource();
 
       static size_t getSize() {
@@ -39,9 +47,57 @@ namespace Pinetime {
         return blockSize;
       }
 
+      void OnFlashIdle();
+
     private:
       Pinetime::Drivers::SpiNorFlash& flashDriver;
 
+      // littlefs is not thread-safe, and DisplayApp, SystemTask and the BLE host all use the file system: every call to lfs is
+      // made with fsMutex held. The mutex is recursive, so that an entry point may call another one.
+      class Lock {
+      public:
+        explicit Lock(FS& fs) : fs {fs} {
+          xSemaphoreTakeRecursive(fs.fsMutex, portMAX_DELAY);
+        }
+
+        ~Lock() {
+          xSemaphoreGiveRecursive(fs.fsMutex);
+        }
+
+        Lock(const Lock&) = delete;
+        Lock& operator=(const Lock&) = delete;
+
+      private:
+        FS& fs;
+      };
+
+      SemaphoreHandle_t fsMutex = nullptr;
+
+      // The flash is acquired (and woken up if needed) on the first access and released once it hasn't been
+      // accessed for flashIdleTimeout, so that accesses made while the system sleeps don't have to wake it up.
+      class FlashAccess {
+      public:
+        explicit FlashAccess(FS& fs) : fs {fs} {
+          fs.AcquireFlash();
+        }
+
+        ~FlashAccess() {
+          fs.ReleaseFlash();
+        }
+
+      private:
+        FS& fs;
+      };
+
+      void AcquireFlash();
+      void ReleaseFlash();
+
+      static constexpr TickType_t flashIdleTimeout = pdMS_TO_TICKS(200);
+      SemaphoreHandle_t flashMutex = nullptr;
+      TimerHandle_t flashIdleTimer = nullptr;
+      bool flashAcquired = false;
+      uint8_t flashUsers = 0;
+
       /*
        * External Flash MAP (4 MBytes)
        *
@@ -0,0 +1,33 @@
+#include "components/gfx/RleBlitter.h"
+#include <FreeRTOS.h>
+#include <task.h>
+#include <algorithm>
+#include "components/rle/RleDecoder.h"
+#include "drivers/St7789.h"
+
+using namespace Pinetime::Components;
+
+RleBlitter::RleBlitter(Pinetime::Drivers::St7789& lcd) : lcd {lcd} {
+}
+
+void RleBlitter::Draw(Tools::RleDecoder& decoder, uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
+  // The previous transfer must be finished before the DataCommand pin is changed to set the window
+  ulTaskNotifyTake(pdTRUE, 500);
+  lcd.BeginDrawBuffer(x, y, width, height);
+
+  size_t remaining = width * height;
+  uint8_t current = 0;
+  bool first = true;
+  size_t count = decoder.DecodeNext(buffers[current].data(), std::min(remaining, chunkPixels));
+  while (count > 0) {
+    if (!first) {
+      // Wait for the chunk that was sent while this one was decoded: its buffer is the next one to be filled
+      ulTaskNotifyTake(pdTRUE, 500);
+    }
+    first = false;
+    lcd.ContinueDrawBuffer(reinterpret_cast<const uint8_t*>(buffers[current].data()), count * sizeof(uint16_t));
+    remaining -= count;
+    current ^= 1;
+    count = decoder.DecodeNext(buffers[current].data(), std::min(remaining, chunkPixels));
+  }
+}
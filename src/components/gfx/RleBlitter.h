@@ -0,0 +1,38 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Drivers {
+    class St7789;
+  }
+
+  namespace Tools {
+    class RleDecoder;
+  }
+
+  namespace Components {
+    /**
+     * Draws RLE images (boot logo, recovery UI) on the display without a full frame buffer.
+     *
+     * The whole image is sent in a single address window, in chunks of several lines. Two chunk buffers are used: the next
+     * chunk is decoded while the previous one is being sent by the DMA.
+     */
+    class RleBlitter {
+    public:
+      explicit RleBlitter(Drivers::St7789& lcd);
+
+      // Returns once the last chunk is started. Like after St7789::DrawBuffer(), the end of the transfer is notified to the
+      // calling task, and the next drawing must wait for this notification.
+      void Draw(Tools::RleDecoder& decoder, uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+
+    private:
+      static constexpr size_t linesPerChunk = 4;
+      static constexpr size_t chunkPixels = 240 * linesPerChunk;
+
+      Drivers::St7789& lcd;
+      std::array<std::array<uint16_t, chunkPixels>, 2> buffers;
+    };
+  }
+}
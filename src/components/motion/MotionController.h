@@ -40,6 +40,18 @@ namespace Pinetime {
         currentTripSteps = 0;
       }
 
+      // The step counter of the motion sensor is reset with the MCU, the steps counted before are added to it
+      void RestoreSteps(uint32_t steps, uint32_t tripSteps) {
+        stepsOffset = steps;
+        nbSteps = steps;
+        currentTripSteps = tripSteps;
+      }
+
+      // Called when the step counter of the motion sensor is reset at midnight
+      void ResetSteps() {
+        stepsOffset = 0;
+      }
+
       uint32_t GetTripSteps() const {
         return currentTripSteps;
       }
@@ -64,6 +76,7 @@ namespace Pinetime {
 
     private:
       uint32_t nbSteps = 0;
+      uint32_t stepsOffset = 0;
       uint32_t currentTripSteps = 0;
 
       TickType_t lastTime = 0;
@@ -1,39 +1,160 @@
 #include "components/motor/MotorController.h"
 #include <hal/nrf_gpio.h>
-#include "systemtask/SystemTask.h"
+#include <hal/nrf_pwm.h>
 #include "drivers/PinMap.h"
 
 using namespace Pinetime::Controllers;
 
+namespace {
+  struct Pattern {
+    const MotorController::Step* steps;
+    uint8_t nbSteps;
+    // Pause between two repetitions of a looping pattern in ms, 0 if the pattern is played once
+    uint16_t pause;
+  };
+
+  constexpr MotorController::Step tap[] = {{100, 15}};
+  constexpr MotorController::Step click[] = {{100, 35}};
+  constexpr MotorController::Step message[] = {{100, 35}, {0, 80}, {100, 35}};
+  constexpr MotorController::Step email[] = {{60, 80}};
+  constexpr MotorController::Step alert[] = {{100, 50}, {0, 60}, {100, 50}, {0, 60}, {100, 50}};
+  constexpr MotorController::Step ring[] = {{100, 50}};
+  constexpr MotorController::Step metronomeBar[] = {{100, 90}};
+  constexpr MotorController::Step metronomeBeat[] = {{70, 30}};
+
+  // Indexed by MotorController::Patterns
+  constexpr Pattern patterns[] = {
+    {tap, std::size(tap), 0},
+    {click, std::size(click), 0},
+    {message, std::size(message), 0},
+    {email, std::size(email), 0},
+    {alert, std::size(alert), 0},
+    {ring, std::size(ring), 950},
+    {metronomeBar, std::size(metronomeBar), 0},
+    {metronomeBeat, std::size(metronomeBeat), 0},
+  };
+  static_assert(std::size(patterns) == static_cast<size_t>(MotorController::Patterns::MetronomeBeat) + 1);
+
+  // 16 MHz / 800 = 20 kHz, above the audible range so that the motor doesn't whine at low amplitudes
+  constexpr uint16_t counterTop = 800;
+  constexpr uint32_t pwmPeriodsPerMs = 20;
+  constexpr uint8_t interruptPriority = 6;
+
+  // The motor is on while the pin is low. With the polarity bit (15) cleared, the output is low from the start of the PWM
+  // period until the counter reaches the duty value.
+  constexpr uint16_t Duty(uint8_t amplitude) {
+    return static_cast<uint16_t>(counterTop * (amplitude > 100 ? 100 : amplitude) / 100);
+  }
+}
+
 void MotorController::Init() {
   nrf_gpio_cfg_output(PinMap::Motor);
   nrf_gpio_pin_set(PinMap::Motor);
 
-  shortVib = xTimerCreate("shortVib", 1, pdFALSE, nullptr, StopMotor);
-  longVib = xTimerCreate("longVib", pdMS_TO_TICKS(1000), pdTRUE, this, Ring);
+  uint32_t pins[NRF_PWM_CHANNEL_COUNT] = {PinMap::Motor, NRF_PWM_PIN_NOT_CONNECTED, NRF_PWM_PIN_NOT_CONNECTED, NRF_PWM_PIN_NOT_CONNECTED};
+  nrf_pwm_pins_set(NRF_PWM0, pins);
+  nrf_pwm_configure(NRF_PWM0, NRF_PWM_CLK_16MHz, NRF_PWM_MODE_UP, counterTop);
+  nrf_pwm_decoder_set(NRF_PWM0, NRF_PWM_LOAD_COMMON, NRF_PWM_STEP_AUTO);
+  // Each sample is played for stepDuration
+  nrf_pwm_seq_refresh_set(NRF_PWM0, 0, stepDuration * pwmPeriodsPerMs - 1);
+  nrf_pwm_seq_end_delay_set(NRF_PWM0, 0, 0);
+  nrf_pwm_seq_end_delay_set(NRF_PWM0, 1, 0);
+  pauseSample = Duty(0);
+  nrf_pwm_seq_ptr_set(NRF_PWM0, 1, &pauseSample);
+  nrf_pwm_seq_cnt_set(NRF_PWM0, 1, 1);
+
+  nrf_pwm_event_clear(NRF_PWM0, NRF_PWM_EVENT_STOPPED);
+  nrf_pwm_int_set(NRF_PWM0, NRF_PWM_INT_STOPPED_MASK);
+  NVIC_SetPriority(PWM0_IRQn, interruptPriority);
+  NVIC_ClearPendingIRQ(PWM0_IRQn);
+  NVIC_EnableIRQ(PWM0_IRQn);
 }
 
-void MotorController::Ring(TimerHandle_t xTimer) {
-  auto* motorController = static_cast<MotorController*>(pvTimerGetTimerID(xTimer));
-  motorController->RunForDuration(50);
+void MotorController::Play(Patterns pattern, TaskHandle_t taskToNotify) {
+  const Pattern& p = patterns[static_cast<uint8_t>(pattern)];
+  Play(p.steps, p.nbSteps, p.pause, taskToNotify);
 }
 
 void MotorController::RunForDuration(uint8_t motorDuration) {
-  if (motorDuration > 0 && xTimerChangePeriod(shortVib, pdMS_TO_TICKS(motorDuration), 0) == pdPASS && xTimerStart(shortVib, 0) == pdPASS) {
-    nrf_gpio_pin_clear(PinMap::Motor);
+  if (motorDuration > 0) {
+    const Step step {100, motorDuration};
+    Play(&step, 1, 0, nullptr);
   }
 }
 
 void MotorController::StartRinging() {
-  RunForDuration(50);
-  xTimerStart(longVib, 0);
+  Play(Patterns::Ring);
 }
 
 void MotorController::StopRinging() {
-  xTimerStop(longVib, 0);
-  nrf_gpio_pin_set(PinMap::Motor);
+  taskENTER_CRITICAL();
+  Stop();
+  taskEXIT_CRITICAL();
 }
 
-void MotorController::StopMotor(TimerHandle_t /*xTimer*/) {
-  nrf_gpio_pin_set(PinMap::Motor);
+void MotorController::Play(const Step* steps, size_t nbSteps, uint16_t pause, TaskHandle_t taskToNotify) {
+  taskENTER_CRITICAL();
+  Stop();
+
+  // A one-shot pattern ends with the motor off: the PWM is stopped as soon as the last sample is loaded
+  const size_t lastSample = (pause == 0) ? maxSamples - 1 : maxSamples;
+  size_t nbSamples = 0;
+  for (size_t i = 0; i < nbSteps; i++) {
+    const uint16_t duty = Duty(steps[i].amplitude);
+    for (uint16_t t = 0; t < steps[i].duration && nbSamples < lastSample; t += stepDuration) {
+      samples[nbSamples++] = duty;
+    }
+  }
+  if (pause == 0) {
+    samples[nbSamples++] = Duty(0);
+  }
+
+  if (nbSamples > 0) {
+    nrf_pwm_seq_ptr_set(NRF_PWM0, 0, samples.data());
+    nrf_pwm_seq_cnt_set(NRF_PWM0, 0, nbSamples);
+    if (pause == 0) {
+      nrf_pwm_loop_set(NRF_PWM0, 0);
+      nrf_pwm_shorts_set(NRF_PWM0, NRF_PWM_SHORT_SEQEND0_STOP_MASK);
+    } else {
+      // SEQ[0] (the steps) then SEQ[1] (a single sample held for the pause), repeated until stopped
+      nrf_pwm_seq_refresh_set(NRF_PWM0, 1, pause * pwmPeriodsPerMs - 1);
+      nrf_pwm_loop_set(NRF_PWM0, 1);
+      nrf_pwm_shorts_set(NRF_PWM0, NRF_PWM_SHORT_LOOPSDONE_SEQSTART0_MASK);
+    }
+
+    this->taskToNotify = taskToNotify;
+    playing = true;
+    nrf_pwm_enable(NRF_PWM0);
+    nrf_pwm_task_trigger(NRF_PWM0, NRF_PWM_TASK_SEQSTART0);
+  }
+  taskEXIT_CRITICAL();
+}
+
+// Must be called with the interrupt of PWM0 masked
+void MotorController::Stop() {
+  if (!playing) {
+    return;
+  }
+  // The PWM stops at the end of the current PWM period, 50 us at most
+  nrf_pwm_task_trigger(NRF_PWM0, NRF_PWM_TASK_STOP);
+  while (!nrf_pwm_event_check(NRF_PWM0, NRF_PWM_EVENT_STOPPED)) {
+  }
+  nrf_pwm_event_clear(NRF_PWM0, NRF_PWM_EVENT_STOPPED);
+  NVIC_ClearPendingIRQ(PWM0_IRQn);
+  // The pin is driven by the GPIO again, and is kept high (motor off)
+  nrf_pwm_disable(NRF_PWM0);
+  taskToNotify = nullptr;
+  playing = false;
+}
+
+void MotorController::OnStoppedEvent() {
+  nrf_pwm_disable(NRF_PWM0);
+  playing = false;
+
+  if (taskToNotify != nullptr) {
+    BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+    vTaskNotifyGiveFromISR(taskToNotify, &xHigherPriorityTaskWoken);
+    taskToNotify = nullptr;
+    portYIELD_FROM_ISR(xHigherPriorityTaskWoken);
+  }
 }
@@ -1,26 +1,61 @@
 #pragma once
 
-#include <FreeRTOS.h>
-#include <timers.h>
+#include <array>
+#include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <task.h>
 
 namespace Pinetime {
   namespace Controllers {
 
+    /**
+     * Vibration patterns played by the PWM0 peripheral.
+     *
+     * A pattern is a list of steps (an amplitude and a duration), expanded into a buffer of PWM duty cycles that EasyDMA feeds to
+     * the motor pin without any help from the CPU. The CPU is only woken up at the end of the pattern, to disable the PWM.
+     * Looping patterns (ringing) use the second sequence of the PWM for the pause between two repetitions, and play until
+     * StopRinging() is called.
+     */
     class MotorController {
     public:
-      MotorController() = default;
+      enum class Patterns : uint8_t { Tap, Click, Message, Email, Alert, Ring, MetronomeBar, MetronomeBeat };
+
+      struct Step {
+        // 0 to 100 %
+        uint8_t amplitude;
+        // ms, rounded up to a multiple of stepDuration
+        uint16_t duration;
+      };
 
       void Init();
+      // taskToNotify, if not null, is notified when the pattern ends, but not when it is stopped or replaced by another pattern
+      void Play(Patterns pattern, TaskHandle_t taskToNotify = nullptr);
       void RunForDuration(uint8_t motorDuration);
       void StartRinging();
+      // Stops the pattern being played, ringing or not
       void StopRinging();
+      bool IsPlaying() const {
+        return playing;
+      }
+
+      // Called from the interrupt of PWM0
+      void OnStoppedEvent();
+
+      static constexpr uint8_t stepDuration = 5;
 
     private:
-      static void Ring(TimerHandle_t xTimer);
-      static void StopMotor(TimerHandle_t xTimer);
-      TimerHandle_t shortVib;
-      TimerHandle_t longVib;
+      void Play(const Step* steps, size_t nbSteps, uint16_t pause, TaskHandle_t taskToNotify);
+      void Stop();
+
+      // 640 ms, longer patterns are truncated
+      static constexpr size_t maxSamples = 128;
+
+      // EasyDMA can only read from RAM
+      std::array<uint16_t, maxSamples> samples {};
+      uint16_t pauseSample = 0;
+      volatile bool playing = false;
+      TaskHandle_t taskToNotify = nullptr;
     };
   }
 }
@@ -0,0 +1,215 @@
+#include "components/recordstore/RecordStore.h"
+#include <cstring>
+#include "drivers/InternalFlash.h"
+
+using namespace Pinetime::Controllers;
+
+/*
+ * A record is made of words, as the flash is written one word at a time:
+ *  - header : key (8 bits), size of the data in bytes (8 bits), complement of the 16 lower bits (16 bits)
+ *  - data, padded with 0xff to a multiple of 4 bytes
+ *  - checksum (FNV-1a) of the header and the data, written last
+ * A header that reads as erased ends the log.
+ */
+namespace {
+  constexpr uint32_t Header(uint8_t key, uint8_t size) {
+    const uint32_t low = key | (size << 8);
+    return low | ((~low & 0xffff) << 16);
+  }
+
+  constexpr bool IsHeaderValid(uint32_t header) {
+    return (header >> 16) == (~header & 0xffff);
+  }
+
+  constexpr uint8_t DataSize(uint32_t header) {
+    return (header >> 8) & 0xff;
+  }
+
+  constexpr uint8_t Key(uint32_t header) {
+    return header & 0xff;
+  }
+
+  constexpr uint32_t RecordWords(size_t dataSize) {
+    return 1 + (dataSize + 3) / 4 + 1;
+  }
+
+  class Checksum {
+  public:
+    void Add(uint32_t word) {
+      for (uint8_t i = 0; i < 4; i++) {
+        value = (value ^ ((word >> (8 * i)) & 0xff)) * 16777619;
+      }
+    }
+
+    // Never the value of an erased word, which would make an interrupted record look committed
+    uint32_t Value() const {
+      return (value == 0xffffffff) ? 0xfffffffe : value;
+    }
+
+  private:
+    uint32_t value = 2166136261;
+  };
+}
+
+uint32_t RecordStore::Word(uint32_t address) {
+  return *reinterpret_cast<const volatile uint32_t*>(address);
+}
+
+uint32_t RecordStore::RecordSize(uint32_t header) {
+  return RecordWords(DataSize(header)) * 4;
+}
+
+bool RecordStore::IsValid(uint32_t address, uint32_t end) {
+  const uint32_t header = Word(address);
+  const uint32_t checksumAddress = address + RecordSize(header) - 4;
+  if (!IsHeaderValid(header) || checksumAddress >= end) {
+    return false;
+  }
+  Checksum checksum;
+  for (uint32_t a = address; a < checksumAddress; a += 4) {
+    checksum.Add(Word(a));
+  }
+  return Word(checksumAddress) == checksum.Value();
+}
+
+bool RecordStore::IsPageValid(uint32_t page) {
+  return Word(page + 4) == magic && Word(page) != erased;
+}
+
+bool RecordStore::IsPageErased(uint32_t page) {
+  for (uint32_t address = page; address < page + pageSize; address += 4) {
+    if (Word(address) != erased) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void RecordStore::Init() {
+  const bool valid[2] = {IsPageValid(pages[0]), IsPageValid(pages[1])};
+  if (!valid[0] && !valid[1]) {
+    Format(0);
+  } else if (valid[0] && valid[1]) {
+    // The older page wasn't erased yet after the last compaction
+    activePage = (Word(pages[1]) > Word(pages[0])) ? 1 : 0;
+  } else {
+    activePage = valid[0] ? 0 : 1;
+  }
+  generation = Word(pages[activePage]);
+  spareErased = IsPageErased(pages[activePage ^ 1]);
+  Scan();
+}
+
+void RecordStore::Format(uint8_t page) {
+  Drivers::InternalFlash::ErasePage(pages[page]);
+  Drivers::InternalFlash::WriteWord(pages[page], 0);
+  Drivers::InternalFlash::WriteWord(pages[page] + 4, magic);
+  activePage = page;
+}
+
+void RecordStore::EraseSpare() {
+  if (spareErased) {
+    return;
+  }
+  Drivers::InternalFlash::ErasePage(pages[activePage ^ 1]);
+  spareErased = true;
+}
+
+void RecordStore::Scan() {
+  latest.fill(0);
+  const uint32_t end = pages[activePage] + pageSize;
+  uint32_t address = pages[activePage] + headerSize;
+  while (address < end) {
+    const uint32_t header = Word(address);
+    if (header == erased) {
+      break;
+    }
+    if (!IsHeaderValid(header) || address + RecordSize(header) > end) {
+      // Nothing can be appended after a corrupted header, the next write compacts the page
+      address = end;
+      break;
+    }
+    // The records interrupted by a reset are skipped, the previous record of their key is kept
+    if (Key(header) < latest.size() && IsValid(address, end)) {
+      latest[Key(header)] = address;
+    }
+    address += RecordSize(header);
+  }
+  writeAddress = address;
+}
+
+bool RecordStore::Read(Keys key, void* data, size_t size) const {
+  const uint32_t address = latest[static_cast<uint8_t>(key)];
+  if (address == 0 || DataSize(Word(address)) != size) {
+    return false;
+  }
+  std::memcpy(data, reinterpret_cast<const void*>(address + 4), size);
+  return true;
+}
+
+bool RecordStore::Write(Keys key, const void* data, size_t size) {
+  if (key >= Keys::NbKeys || size > maxRecordSize) {
+    return false;
+  }
+  const uint32_t current = latest[static_cast<uint8_t>(key)];
+  if (current != 0 && DataSize(Word(current)) == size && std::memcmp(reinterpret_cast<const void*>(current + 4), data, size) == 0) {
+    return true;
+  }
+
+  if (writeAddress + RecordWords(size) * 4 > pages[activePage] + pageSize) {
+    Compact(key, data, size);
+    return true;
+  }
+  latest[static_cast<uint8_t>(key)] = writeAddress;
+  writeAddress = Append(writeAddress, key, data, size);
+  return true;
+}
+
+uint32_t RecordStore::Append(uint32_t address, Keys key, const void* data, size_t size) {
+  Checksum checksum;
+  const uint32_t header = Header(static_cast<uint8_t>(key), static_cast<uint8_t>(size));
+  Drivers::InternalFlash::WriteWord(address, header);
+  checksum.Add(header);
+  address += 4;
+
+  const auto* bytes = static_cast<const uint8_t*>(data);
+  for (size_t offset = 0; offset < size; offset += 4) {
+    uint32_t word = erased;
+    std::memcpy(&word, bytes + offset, (size - offset < 4) ? size - offset : 4);
+    Drivers::InternalFlash::WriteWord(address, word);
+    checksum.Add(word);
+    address += 4;
+  }
+
+  Drivers::InternalFlash::WriteWord(address, checksum.Value());
+  return address + 4;
+}
+
+void RecordStore::Compact(Keys key, const void* data, size_t size) {
+  const uint8_t next = activePage ^ 1;
+  EraseSpare();
+
+  // The new record replaces the latest one of its key
+  static_assert(RecordWords(maxRecordSize) * 4 * static_cast<size_t>(Keys::NbKeys) <= pageSize - headerSize,
+                "The latest records must fit in a page");
+  decltype(latest) moved {};
+  uint32_t address = pages[next] + headerSize;
+  for (uint8_t k = 0; k < latest.size(); k++) {
+    if (k == static_cast<uint8_t>(key)) {
+      moved[k] = address;
+      address = Append(address, key, data, size);
+    } else if (latest[k] != 0) {
+      moved[k] = address;
+      address = Append(address, static_cast<Keys>(k), reinterpret_cast<const void*>(latest[k] + 4), DataSize(Word(latest[k])));
+    }
+  }
+
+  // The new page replaces the active one once its header is written, until then a reset falls back to the active page
+  Drivers::InternalFlash::WriteWord(pages[next], generation + 1);
+  Drivers::InternalFlash::WriteWord(pages[next] + 4, magic);
+  activePage = next;
+  spareErased = false;
+  generation++;
+  latest = moved;
+  writeAddress = address;
+}
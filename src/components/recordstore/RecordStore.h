@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    /**
+     * Small persistent records in the internal flash, for the state that changes too often to be saved in the file system.
+     *
+     * Writing a record costs a few word writes (~41 us each) and doesn't wake the SPI flash up. The records are appended to
+     * a log in the active page of a pair of internal flash pages, which spreads the wear over the whole page. Every record
+     * ends with a checksum written last, so a record interrupted by a reset is ignored and the previous value is kept. When
+     * the active page is full, the latest record of each key is copied to the other page, which becomes active once its
+     * header is written.
+     *
+     * The erase of a page stalls the CPU (and the BLE stack) for ~85 ms. The page left by a compaction is only erased by
+     * EraseSpare(), which the caller runs when the stall doesn't matter (no BLE connection). If it wasn't erased yet when
+     * the active page is full, Write() erases it and stalls.
+     *
+     * The pages are in the unused space after the scratch partition of MCUBoot (see gcc_nrf52-mcuboot.ld).
+     * Not thread-safe: the records are read and written by the system task.
+     */
+    class RecordStore {
+    public:
+      // Never reuse the value of a key that was removed, its records may still be in the flash
+      enum class Keys : uint8_t { Time, Steps, NbKeys };
+
+      static constexpr size_t maxRecordSize = 64;
+
+      void Init();
+
+      /** @return false if there is no record for this key, or if its size isn't size */
+      bool Read(Keys key, void* data, size_t size) const;
+
+      /** Does nothing if the latest record of the key is already data. @return false if the record couldn't be written */
+      bool Write(Keys key, const void* data, size_t size);
+
+      /** Erases the page left by the last compaction, if it isn't erased yet. Stalls the CPU for ~85 ms when it does. */
+      void EraseSpare();
+
+      template <typename T>
+      bool Read(Keys key, T& value) const {
+        return Read(key, &value, sizeof(T));
+      }
+
+      template <typename T>
+      bool Write(Keys key, const T& value) {
+        return Write(key, &value, sizeof(T));
+      }
+
+    private:
+      static constexpr uint32_t pageSize = 0x1000;
+      static constexpr std::array<uint32_t, 2> pages {0x7e000, 0x7f000};
+      static constexpr uint32_t magic = 0x53434552; // "RECS"
+      static constexpr uint32_t erased = 0xffffffff;
+      // Page header: generation (incremented by each compaction), then the magic, written last
+      static constexpr uint32_t headerSize = 8;
+
+      static uint32_t Word(uint32_t address);
+      static uint32_t RecordSize(uint32_t header);
+      static bool IsValid(uint32_t address, uint32_t end);
+      static bool IsPageValid(uint32_t page);
+      static bool IsPageErased(uint32_t page);
+
+      void Format(uint8_t page);
+      void Scan();
+      uint32_t Append(uint32_t address, Keys key, const void* data, size_t size);
+      void Compact(Keys key, const void* data, size_t size);
+
+      uint8_t activePage = 0;
+      uint32_t generation = 0;
+      uint32_t writeAddress = 0;
+      bool spareErased = false;
+      // Address of the latest record of each key, 0 if there is none
+      std::array<uint32_t, static_cast<size_t>(Keys::NbKeys)> latest {};
+    };
+  }
+}
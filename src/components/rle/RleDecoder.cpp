@@ -1,36 +1,54 @@
 #include "components/rle/RleDecoder.h"
+#include <algorithm>
+#include <cstring>
 
 using namespace Pinetime::Tools;
 
+namespace {
+  constexpr uint16_t SwapBytes(uint16_t color) {
+    return static_cast<uint16_t>((color << 8) | (color >> 8));
+  }
+}
+
 RleDecoder::RleDecoder(const uint8_t* buffer, size_t size) : buffer {buffer}, size {size} {
 }
 
 RleDecoder::RleDecoder(const uint8_t* buffer, size_t size, uint16_t foregroundColor, uint16_t backgroundColor) : RleDecoder {buffer, size} {
-  this->foregroundColor = foregroundColor;
-  this->backgroundColor = backgroundColor;
+  this->foregroundColor = SwapBytes(foregroundColor);
+  this->backgroundColor = SwapBytes(backgroundColor);
+  color = this->backgroundColor;
 }
 
-void RleDecoder::DecodeNext(uint8_t* output, size_t maxBytes) {
-  for (; encodedBufferIndex < size; encodedBufferIndex++) {
-    uint8_t rl = buffer[encodedBufferIndex] - processedCount;
-    while (rl) {
-      output[bp] = color >> 8;
-      output[bp + 1] = color & 0xff;
-      bp += 2;
-      rl -= 1;
-      processedCount++;
+size_t RleDecoder::DecodeNext(uint16_t* output, size_t maxPixels) {
+  size_t written = 0;
+  while (written < maxPixels && encodedBufferIndex < size) {
+    const size_t runLength = buffer[encodedBufferIndex];
+    const size_t count = std::min(runLength - processedCount, maxPixels - written);
+    FillRun(output + written, color, count);
+    written += count;
+    processedCount += count;
 
-      if (bp >= maxBytes) {
-        bp = 0;
-        y += 1;
-        return;
-      }
+    if (processedCount == runLength) {
+      encodedBufferIndex++;
+      processedCount = 0;
+      color = (color == backgroundColor) ? foregroundColor : backgroundColor;
     }
-    processedCount = 0;
+  }
+  return written;
+}
 
-    if (color == backgroundColor)
-      color = foregroundColor;
-    else
-      color = backgroundColor;
+void RleDecoder::FillRun(uint16_t* output, uint16_t color, size_t count) {
+  // Store 2 pixels at a time once the output is word-aligned
+  if (count > 0 && (reinterpret_cast<uintptr_t>(output) & 0x2) != 0) {
+    *output++ = color;
+    count--;
+  }
+  const uint32_t pair = (static_cast<uint32_t>(color) << 16) | color;
+  for (; count >= 2; count -= 2) {
+    std::memcpy(output, &pair, sizeof(pair));
+    output += 2;
+  }
+  if (count > 0) {
+    *output = color;
   }
 }
@@ -6,7 +6,9 @@
 namespace Pinetime {
   namespace Tools {
     /* 1-bit RLE decoder. Provide the encoded buffer to the constructor and then call DecodeNext() by
-     * specifying the output (decoded) buffer and the maximum number of bytes this buffer can handle.
+     * specifying the output (decoded) buffer and the maximum number of pixels this buffer can handle.
+     *
+     * The pixels are written in the byte order of the display (big endian), a whole run at a time.
      *
      * Code from https://github.com/daniel-thompson/wasp-bootloader by Daniel Thompson released under the MIT license.
      */
@@ -15,19 +17,21 @@ namespace Pinetime {
       RleDecoder(const uint8_t* buffer, size_t size);
       RleDecoder(const uint8_t* buffer, size_t size, uint16_t foregroundColor, uint16_t backgroundColor);
 
-      void DecodeNext(uint8_t* output, size_t maxBytes);
+      // Returns the number of pixels written in output, which is less than maxPixels at the end of the image
+      size_t DecodeNext(uint16_t* output, size_t maxPixels);
 
     private:
+      static void FillRun(uint16_t* output, uint16_t color, size_t count);
+
       const uint8_t* buffer;
       size_t size;
 
       size_t encodedBufferIndex = 0;
-      int y = 0;
-      uint16_t bp = 0;
+      // Colors are stored byte-swapped, ready to be sent to the display
       uint16_t foregroundColor = 0xffff;
       uint16_t backgroundColor = 0;
-      uint16_t color = backgroundColor;
-      int processedCount = 0;
+      uint16_t color = 0;
+      size_t processedCount = 0;
     };
   }
 }
@@ -1,9 +1,55 @@
 #include "components/settings/Settings.h"
 #include <cstdlib>
 #include <cstring>
+#include <type_traits>
 
 using namespace Pinetime::Controllers;
 
+namespace {
+  // The settings are the only entry of their directory, so that the metadata log that holds them isn't shared with other files
+  constexpr const char* settingsDir = "/settings";
+  constexpr const char* settingsPath = "/settings/values";
+  constexpr const char* legacySettingsPath = "/settings.dat";
+}
+
+template <typename Visitor>
+void Settings::ForEachField(SettingsData& data, SettingsData& saved, Visitor&& visit) {
+  visit(Key::StepsGoal, data.stepsGoal, saved.stepsGoal);
+  visit(Key::ScreenTimeOut, data.screenTimeOut, saved.screenTimeOut);
+  visit(Key::ClockType, data.clockType, saved.clockType);
+  visit(Key::WeatherFormat, data.weatherFormat, saved.weatherFormat);
+  visit(Key::NotificationStatus, data.notificationStatus, saved.notificationStatus);
+  visit(Key::WatchFace, data.watchFace, saved.watchFace);
+  visit(Key::ChimesOption, data.chimesOption, saved.chimesOption);
+  visit(Key::PTSColorTime, data.PTS.ColorTime, saved.PTS.ColorTime);
+  visit(Key::PTSColorBar, data.PTS.ColorBar, saved.PTS.ColorBar);
+  visit(Key::PTSColorBG, data.PTS.ColorBG, saved.PTS.ColorBG);
+  visit(Key::PTSGaugeStyle, data.PTS.gaugeStyle, saved.PTS.gaugeStyle);
+  visit(Key::PTSWeatherEnable, data.PTS.weatherEnable, saved.PTS.weatherEnable);
+  visit(Key::InfineatShowSideCover, data.watchFaceInfineat.showSideCover, saved.watchFaceInfineat.showSideCover);
+  visit(Key::InfineatColorIndex, data.watchFaceInfineat.colorIndex, saved.watchFaceInfineat.colorIndex);
+  visit(Key::WakeUpMode, data.wakeUpMode, saved.wakeUpMode);
+  visit(Key::ShakeWakeThreshold, data.shakeWakeThreshold, saved.shakeWakeThreshold);
+  visit(Key::BrightLevel, data.brightLevel, saved.brightLevel);
+}
+
+template <typename T>
+void Settings::ReadField(Key key, T& value) {
+  uint8_t buffer[sizeof(T)];
+  const int size = fs.GetAttribute(settingsPath, static_cast<uint8_t>(key), buffer, sizeof(buffer));
+  if (size == static_cast<int>(sizeof(T))) {
+    std::memcpy(&value, buffer, sizeof(T));
+  } else if constexpr (std::is_integral_v<T> || std::is_enum_v<T>) {
+    if (size > 0 && size < static_cast<int>(sizeof(T))) {
+      // The setting was stored by a firmware in which it was smaller: zero-extend it (the values are little endian)
+      T widened {};
+      std::memcpy(&widened, buffer, size);
+      value = widened;
+    }
+  }
+  // Otherwise the setting isn't stored (LFS_ERR_NOATTR) or can't be converted, and keeps its default value
+}
+
 Settings::Settings(Pinetime::Controllers::FS& fs) : fs {fs} {
 }
 
@@ -17,31 +63,64 @@ void Settings::SaveSettings() {
 
   // verify if is necessary to save
   if (settingsChanged) {
-    SaveSettingsToFile();
+    // The settings that couldn't be written are written again by the next save
+    settingsChanged = !SaveSettingsToFile();
   }
-  settingsChanged = false;
 }
 
 void Settings::LoadSettingsFromFile() {
-  SettingsData bufferSettings;
-  lfs_file_t settingsFile;
-
-  if (fs.FileOpen(&settingsFile, "/settings.dat", LFS_O_RDONLY) != LFS_ERR_OK) {
-    return;
-  }
-  fs.FileRead(&settingsFile, reinterpret_cast<uint8_t*>(&bufferSettings), sizeof(settings));
-  fs.FileClose(&settingsFile);
-  if (bufferSettings.version == settingsVersion) {
-    settings = bufferSettings;
+  lfs_info info;
+  if (fs.Stat(settingsPath, &info) == LFS_ERR_OK) {
+    ForEachField(settings, savedSettings, [this](Key key, auto& value, auto& saved) {
+      ReadField(key, value);
+      saved = value;
+    });
+  } else {
+    fs.DirCreate(settingsDir);
+    lfs_file_t settingsFile;
+    if (fs.FileOpen(&settingsFile, settingsPath, LFS_O_WRONLY | LFS_O_CREAT) != LFS_ERR_OK) {
+      return;
+    }
+    fs.FileClose(&settingsFile);
   }
+
+  ImportLegacySettings();
 }
 
-void Settings::SaveSettingsToFile() {
-  lfs_file_t settingsFile;
+bool Settings::SaveSettingsToFile() {
+  // Each attribute is written as a small commit appended to the metadata log of the settings directory. littlefs compacts
+  // the log when it fills its block, and a commit interrupted by a power loss is discarded when the log is read.
+  bool saved = true;
+  ForEachField(settings, savedSettings, [this, &saved](Key key, auto& value, auto& savedValue) {
+    if (std::memcmp(&value, &savedValue, sizeof(value)) == 0) {
+      return;
+    }
+    if (fs.SetAttribute(settingsPath, static_cast<uint8_t>(key), &value, sizeof(value)) == LFS_ERR_OK) {
+      savedValue = value;
+    } else {
+      saved = false;
+    }
+  });
+  return saved;
+}
 
-  if (fs.FileOpen(&settingsFile, "/settings.dat", LFS_O_WRONLY | LFS_O_CREAT) != LFS_ERR_OK) {
+void Settings::ImportLegacySettings() {
+  lfs_file_t settingsFile;
+  if (fs.FileOpen(&settingsFile, legacySettingsPath, LFS_O_RDONLY) != LFS_ERR_OK) {
     return;
   }
-  fs.FileWrite(&settingsFile, reinterpret_cast<uint8_t*>(&settings), sizeof(settings));
+  SettingsData bufferSettings;
+  const bool valid = fs.FileRead(&settingsFile, reinterpret_cast<uint8_t*>(&bufferSettings), sizeof(bufferSettings)) ==
+                       static_cast<int>(sizeof(bufferSettings)) &&
+                     bufferSettings.version == settingsVersion;
   fs.FileClose(&settingsFile);
+
+  if (valid) {
+    settings = bufferSettings;
+    if (!SaveSettingsToFile()) {
+      // Keep the legacy file, the import will be done again on the next boot
+      return;
+    }
+  }
+  fs.FileDelete(legacySettingsPath);
 }
@@ -286,8 +286,32 @@ namespace Pinetime {
     private:
       Pinetime::Controllers::FS& fs;
 
+      // Version of the legacy /settings.dat file, which contained the whole SettingsData struct
       static constexpr uint32_t settingsVersion = 0x0007;
 
+      // Each setting is stored as a separate attribute of the settings file, identified by its key. Keys must never be
+      // reused or renumbered: add a new key when the meaning of a setting changes. A setting that is not stored keeps its
+      // default value.
+      enum class Key : uint8_t {
+        StepsGoal,
+        ScreenTimeOut,
+        ClockType,
+        WeatherFormat,
+        NotificationStatus,
+        WatchFace,
+        ChimesOption,
+        PTSColorTime,
+        PTSColorBar,
+        PTSColorBG,
+        PTSGaugeStyle,
+        PTSWeatherEnable,
+        InfineatShowSideCover,
+        InfineatColorIndex,
+        WakeUpMode,
+        ShakeWakeThreshold,
+        BrightLevel
+      };
+
       struct SettingsData {
         uint32_t version = settingsVersion;
         uint32_t stepsGoal = 10000;
@@ -311,6 +335,8 @@ namespace Pinetime {
       };
 
       SettingsData settings;
+      // Values as they are stored in the file system, so that only the settings that changed are written
+      SettingsData savedSettings;
       bool settingsChanged = false;
 
       uint8_t appMenu = 0;
@@ -322,7 +348,13 @@ namespace Pinetime {
       bool bleRadioEnabled = true;
 
       void LoadSettingsFromFile();
-      void SaveSettingsToFile();
+      bool SaveSettingsToFile();
+      void ImportLegacySettings();
+
+      template <typename Visitor>
+      static void ForEachField(SettingsData& data, SettingsData& saved, Visitor&& visit);
+      template <typename T>
+      void ReadField(Key key, T& value);
     };
   }
 }
@@ -2,27 +2,25 @@
 
 using namespace Pinetime::Controllers;
 
-Timer::Timer(void* const timerData, TimerCallbackFunction_t timerCallbackFunction) {
-  timer = xTimerCreate("Timer", 1, pdFALSE, timerData, timerCallbackFunction);
+Timer::Timer(TimerWheel& timerWheel, void* const timerData, TimerWheel::Callback timerCallbackFunction)
+  : timerWheel {timerWheel}, timerData {timerData}, timerCallbackFunction {timerCallbackFunction} {
 }
 
 void Timer::StartTimer(std::chrono::milliseconds duration) {
-  xTimerChangePeriod(timer, pdMS_TO_TICKS(duration.count()), 0);
-  xTimerStart(timer, 0);
+  timerWheel.Schedule(TimerWheel::Events::Timer,
+                      timerWheel.Now() + TimerWheel::MsToTicks(duration.count()),
+                      timerCallbackFunction,
+                      timerData);
 }
 
 std::chrono::milliseconds Timer::GetTimeRemaining() {
-  if (IsRunning()) {
-    TickType_t remainingTime = xTimerGetExpiryTime(timer) - xTaskGetTickCount();
-    return std::chrono::milliseconds(remainingTime * 1000 / configTICK_RATE_HZ);
-  }
-  return std::chrono::milliseconds(0);
+  return std::chrono::milliseconds(TimerWheel::TicksToMs(timerWheel.Remaining(TimerWheel::Events::Timer)));
 }
 
 void Timer::StopTimer() {
-  xTimerStop(timer, 0);
+  timerWheel.Cancel(TimerWheel::Events::Timer);
 }
 
 bool Timer::IsRunning() {
-  return (xTimerIsTimerActive(timer) == pdTRUE);
+  return timerWheel.IsScheduled(TimerWheel::Events::Timer);
 }
@@ -1,15 +1,14 @@
 #pragma once
 
-#include <FreeRTOS.h>
-#include <timers.h>
-
 #include <chrono>
+#include "components/timer/TimerWheel.h"
 
 namespace Pinetime {
   namespace Controllers {
     class Timer {
     public:
-      Timer(void* timerData, TimerCallbackFunction_t timerCallbackFunction);
+      // The callback is called from the interrupt of the timer wheel
+      Timer(TimerWheel& timerWheel, void* timerData, TimerWheel::Callback timerCallbackFunction);
 
       void StartTimer(std::chrono::milliseconds duration);
 
@@ -20,7 +19,9 @@ namespace Pinetime {
       bool IsRunning();
 
     private:
-      TimerHandle_t timer;
+      TimerWheel& timerWheel;
+      void* timerData;
+      TimerWheel::Callback timerCallbackFunction;
     };
   }
 }
@@ -0,0 +1,165 @@
+#include "components/timer/TimerWheel.h"
+#include <hal/nrf_rtc.h>
+#include <FreeRTOS.h>
+
+using namespace Pinetime::Controllers;
+
+namespace {
+  // Masks the interrupts up to configMAX_SYSCALL_INTERRUPT_PRIORITY, RTC2 included. Unlike taskENTER_CRITICAL(), it can be
+  // used from the callbacks, which run in the interrupt.
+  class InterruptLock {
+  public:
+    InterruptLock() : mask {portSET_INTERRUPT_MASK_FROM_ISR()} {
+    }
+
+    ~InterruptLock() {
+      portCLEAR_INTERRUPT_MASK_FROM_ISR(mask);
+    }
+
+    InterruptLock(const InterruptLock&) = delete;
+    InterruptLock& operator=(const InterruptLock&) = delete;
+
+  private:
+    UBaseType_t mask;
+  };
+
+  constexpr uint32_t counterMask = 0xffffff;
+  constexpr uint8_t interruptPriority = 6;
+}
+
+void TimerWheel::Init() {
+  nrf_rtc_task_trigger(NRF_RTC2, NRF_RTC_TASK_STOP);
+  nrf_rtc_prescaler_set(NRF_RTC2, 32768 / ticksPerSecond - 1);
+  nrf_rtc_event_clear(NRF_RTC2, NRF_RTC_EVENT_OVERFLOW);
+  nrf_rtc_event_clear(NRF_RTC2, NRF_RTC_EVENT_COMPARE_0);
+  nrf_rtc_int_enable(NRF_RTC2, NRF_RTC_INT_OVERFLOW_MASK);
+
+  NVIC_SetPriority(RTC2_IRQn, interruptPriority);
+  NVIC_ClearPendingIRQ(RTC2_IRQn);
+  NVIC_EnableIRQ(RTC2_IRQn);
+
+  nrf_rtc_task_trigger(NRF_RTC2, NRF_RTC_TASK_CLEAR);
+  nrf_rtc_task_trigger(NRF_RTC2, NRF_RTC_TASK_START);
+}
+
+void TimerWheel::Schedule(Events event, Ticks deadline, Callback callback, void* context) {
+  InterruptLock lock;
+  entries[static_cast<uint8_t>(event)] = {deadline, callback, context, true};
+  SetCompare();
+}
+
+void TimerWheel::Cancel(Events event) {
+  InterruptLock lock;
+  entries[static_cast<uint8_t>(event)].scheduled = false;
+  SetCompare();
+}
+
+bool TimerWheel::IsScheduled(Events event) const {
+  return entries[static_cast<uint8_t>(event)].scheduled;
+}
+
+TimerWheel::Ticks TimerWheel::Remaining(Events event) const {
+  InterruptLock lock;
+  const Entry& entry = entries[static_cast<uint8_t>(event)];
+  const Ticks now = Now();
+  if (!entry.scheduled || IsDue(entry.deadline, now)) {
+    return 0;
+  }
+  return entry.deadline - now;
+}
+
+TimerWheel::Ticks TimerWheel::Now() const {
+  uint32_t high;
+  uint32_t counter;
+  bool overflowPending;
+  do {
+    high = overflows;
+    counter = nrf_rtc_counter_get(NRF_RTC2);
+    overflowPending = nrf_rtc_event_pending(NRF_RTC2, NRF_RTC_EVENT_OVERFLOW);
+  } while (high != overflows);
+
+  if (overflowPending) {
+    // The counter overflowed, but the interrupt hasn't been handled yet. Read the counter again, in case it was read just
+    // before the overflow.
+    counter = nrf_rtc_counter_get(NRF_RTC2);
+    high++;
+  }
+  return (high << 24) | counter;
+}
+
+void TimerWheel::OnInterrupt() {
+  if (nrf_rtc_event_pending(NRF_RTC2, NRF_RTC_EVENT_OVERFLOW)) {
+    nrf_rtc_event_clear(NRF_RTC2, NRF_RTC_EVENT_OVERFLOW);
+    overflows = overflows + 1;
+  }
+  nrf_rtc_event_clear(NRF_RTC2, NRF_RTC_EVENT_COMPARE_0);
+  // Make sure that the events are cleared before leaving the interrupt, so that it isn't triggered again
+  (void) nrf_rtc_event_pending(NRF_RTC2, NRF_RTC_EVENT_COMPARE_0);
+
+  // Only the events that are due now are dispatched: an event rescheduled by its callback is handled by the next interrupt
+  const Ticks now = Now();
+  uint8_t due = 0;
+  for (uint8_t i = 0; i < nbEvents; i++) {
+    if (entries[i].scheduled && IsDue(entries[i].deadline, now)) {
+      due |= 1 << i;
+    }
+  }
+
+  while (due != 0) {
+    uint8_t next = nbEvents;
+    for (uint8_t i = 0; i < nbEvents; i++) {
+      if ((due & (1 << i)) != 0 && (next == nbEvents || static_cast<int32_t>(entries[i].deadline - entries[next].deadline) < 0)) {
+        next = i;
+      }
+    }
+    due &= ~(1 << next);
+
+    Callback callback;
+    void* context;
+    {
+      InterruptLock lock;
+      // The event may have been cancelled or rescheduled by the callback of a previous event
+      if (!entries[next].scheduled || !IsDue(entries[next].deadline, now)) {
+        continue;
+      }
+      entries[next].scheduled = false;
+      callback = entries[next].callback;
+      context = entries[next].context;
+    }
+    callback(context);
+  }
+
+  InterruptLock lock;
+  SetCompare();
+}
+
+void TimerWheel::SetCompare() {
+  const Entry* next = nullptr;
+  for (const auto& entry : entries) {
+    if (entry.scheduled && (next == nullptr || static_cast<int32_t>(entry.deadline - next->deadline) < 0)) {
+      next = &entry;
+    }
+  }
+
+  if (next == nullptr) {
+    nrf_rtc_int_disable(NRF_RTC2, NRF_RTC_INT_COMPARE0_MASK);
+    return;
+  }
+
+  const Ticks now = Now();
+  if (IsDue(next->deadline, now)) {
+    NVIC_SetPendingIRQ(RTC2_IRQn);
+    return;
+  }
+
+  Ticks delay = next->deadline - now;
+  if (delay < minDelay) {
+    delay = minDelay;
+  } else if (delay > maxDelay) {
+    // Wake up half way, the compare channel will be set again from there
+    delay = maxDelay;
+  }
+  nrf_rtc_cc_set(NRF_RTC2, 0, (now + delay) & counterMask);
+  nrf_rtc_event_clear(NRF_RTC2, NRF_RTC_EVENT_COMPARE_0);
+  nrf_rtc_int_enable(NRF_RTC2, NRF_RTC_INT_COMPARE0_MASK);
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <cstdint>
+
+namespace Pinetime {
+  namespace Controllers {
+    /**
+     * Events scheduled at an absolute time, driven by the compare channel 0 of RTC2.
+     *
+     * The time is counted in ticks of 1/1024 s since Init(). The 24-bit counter of the RTC is extended to 32 bits in the overflow
+     * interrupt, so the time wraps after 48 days and deadlines must be less than 24 days in the future.
+     *
+     * Each owner has a single slot, and scheduling an event replaces its previous deadline. The compare channel is set to the
+     * earliest deadline, so the CPU is only woken up when an event is due (or every 2 hours, when the next deadline is too far for
+     * the 24-bit counter). The callbacks are called from the interrupt, in the order of their deadlines: they must be short, and
+     * use the FromISR API of FreeRTOS to wake their task.
+     */
+    class TimerWheel {
+    public:
+      enum class Events : uint8_t { Alarm, Timer, Chime };
+      using Ticks = uint32_t;
+      using Callback = void (*)(void* context);
+
+      static constexpr Ticks ticksPerSecond = 1024;
+
+      static constexpr Ticks MsToTicks(uint32_t ms) {
+        return (static_cast<uint64_t>(ms) * ticksPerSecond + 999) / 1000;
+      }
+
+      static constexpr uint32_t TicksToMs(Ticks ticks) {
+        return static_cast<uint64_t>(ticks) * 1000 / ticksPerSecond;
+      }
+
+      void Init();
+
+      void Schedule(Events event, Ticks deadline, Callback callback, void* context);
+      void Cancel(Events event);
+      bool IsScheduled(Events event) const;
+      // Ticks until the deadline of the event, 0 if it isn't scheduled
+      Ticks Remaining(Events event) const;
+
+      Ticks Now() const;
+
+      void OnInterrupt();
+
+    private:
+      static constexpr uint8_t nbEvents = static_cast<uint8_t>(Events::Chime) + 1;
+      // The compare channel must be set at least 2 ticks ahead of the counter, and less than half a period of the counter
+      // ahead so that the difference with the current time can't be ambiguous
+      static constexpr Ticks minDelay = 3;
+      static constexpr Ticks maxDelay = 1 << 23;
+
+      struct Entry {
+        Ticks deadline;
+        Callback callback;
+        void* context;
+        bool scheduled;
+      };
+
+      static bool IsDue(Ticks deadline, Ticks now) {
+        return static_cast<int32_t>(deadline - now) <= 0;
+      }
+
+      void SetCompare();
+
+      std::array<Entry, nbEvents> entries {};
+      volatile uint32_t overflows = 0;
+    };
+  }
+}
@@ -0,0 +1,85 @@
+#include "displayapp/Canvas.h"
+#include <algorithm>
+#include <cstdlib>
+
+using namespace Pinetime::Components;
+
+Canvas::Canvas(Target& target) : target {target} {
+}
+
+void Canvas::Stamp(lv_coord_t x, lv_coord_t y, uint8_t size, lv_color_t color) {
+  const lv_coord_t y1 = std::max<lv_coord_t>(y - size / 2, 0);
+  const lv_coord_t y2 = std::min<lv_coord_t>(y - size / 2 + size - 1, LV_VER_RES_MAX - 1);
+  const lv_coord_t x1 = std::max<lv_coord_t>(x - size / 2, 0);
+  const lv_coord_t x2 = std::min<lv_coord_t>(x - size / 2 + size - 1, LV_HOR_RES_MAX - 1);
+  if (y1 > y2 || x1 > x2) {
+    return;
+  }
+
+  // A frame has a single color and a single span per line
+  if (top <= bottom && (color.full != brushColor.full || !CanAdd(y1, y2, x1, x2))) {
+    Flush();
+  }
+  brushColor = color;
+
+  for (lv_coord_t row = y1; row <= y2; row++) {
+    Span& span = spans[row];
+    span.x1 = std::min<uint8_t>(span.x1, x1);
+    span.x2 = std::max<uint8_t>(span.x2, x2);
+  }
+  top = std::min(top, y1);
+  bottom = std::max(bottom, y2);
+}
+
+void Canvas::Stroke(lv_coord_t x, lv_coord_t y, uint8_t size, lv_color_t color) {
+  if (!strokeActive) {
+    Stamp(x, y, size, color);
+  } else if (x != strokePoint.x || y != strokePoint.y) {
+    // Consecutive stamps are at most half a brush apart, so that diagonal strokes keep their width
+    const lv_coord_t dx = x - strokePoint.x;
+    const lv_coord_t dy = y - strokePoint.y;
+    const lv_coord_t step = std::max(size / 2, 1);
+    const lv_coord_t nbSteps = (std::max(std::abs(dx), std::abs(dy)) + step - 1) / step;
+    for (lv_coord_t i = 1; i <= nbSteps; i++) {
+      Stamp(strokePoint.x + dx * i / nbSteps, strokePoint.y + dy * i / nbSteps, size, color);
+    }
+  }
+  strokePoint = {x, y};
+  strokeActive = true;
+}
+
+bool Canvas::CanAdd(lv_coord_t y1, lv_coord_t y2, uint8_t x1, uint8_t x2) const {
+  for (lv_coord_t row = y1; row <= y2; row++) {
+    const Span& span = spans[row];
+    // The new span must overlap or touch the span of the line
+    if (span.x1 <= span.x2 && (x1 > span.x2 + 1 || x2 + 1 < span.x1)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void Canvas::Flush() {
+  if (top > bottom) {
+    return;
+  }
+  lv_coord_t y = top;
+  while (y <= bottom) {
+    const Span span = spans[y];
+    if (span.x1 > span.x2) {
+      y++;
+      continue;
+    }
+    // Consecutive lines with the same span are sent as a single rectangle
+    lv_coord_t height = 1;
+    while (y + height <= bottom && spans[y + height].x1 == span.x1 && spans[y + height].x2 == span.x2) {
+      height++;
+    }
+    target.FillRect(span.x1, y, span.x2 - span.x1 + 1, height, brushColor, line.data(), line.size());
+    y += height;
+  }
+
+  std::fill(spans.begin() + top, spans.begin() + bottom + 1, Span {});
+  top = LV_VER_RES_MAX;
+  bottom = -1;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <lvgl/lvgl.h>
+
+namespace Pinetime {
+  namespace Components {
+    /**
+     * Raw canvas, for the apps that draw directly on the display instead of using LVGL objects (InfiniPaint...).
+     *
+     * The canvas is allocated with the screen of the app, and attached to LittleVgl (LittleVgl::SetCanvas()) while the screen is
+     * displayed. The square brush stamps of a frame are merged into one span per line and sent to the target at the next
+     * Flush(): consecutive lines with the same span make a single rectangle.
+     * Stroke() joins the point to the previous point of the stroke with stamps, so that fast strokes don't leave gaps between
+     * the touch samples. The stroke ends with EndStroke(), when the finger is lifted.
+     */
+    class Canvas {
+    public:
+      class Target {
+      public:
+        /**
+         * Fills a rectangle of the display with color. line is a buffer of lineSize pixels that belongs to the canvas: the target
+         * fills it with color if line[0] is of another color, then sends it as many times as needed.
+         */
+        virtual void
+        FillRect(uint8_t x, lv_coord_t y, uint8_t width, lv_coord_t height, lv_color_t color, lv_color_t* line, size_t lineSize) = 0;
+
+      protected:
+        ~Target() = default;
+      };
+
+      explicit Canvas(Target& target);
+
+      Canvas(const Canvas&) = delete;
+      Canvas& operator=(const Canvas&) = delete;
+
+      void Stamp(lv_coord_t x, lv_coord_t y, uint8_t size, lv_color_t color);
+      void Stroke(lv_coord_t x, lv_coord_t y, uint8_t size, lv_color_t color);
+
+      void EndStroke() {
+        strokeActive = false;
+      }
+
+      void Flush();
+
+    private:
+      bool CanAdd(lv_coord_t y1, lv_coord_t y2, uint8_t x1, uint8_t x2) const;
+
+      // Span of a line of the canvas, empty when x1 > x2
+      struct Span {
+        uint8_t x1 = UINT8_MAX;
+        uint8_t x2 = 0;
+      };
+
+      Target& target;
+      std::array<Span, LV_VER_RES_MAX> spans;
+      lv_coord_t top = LV_VER_RES_MAX;
+      lv_coord_t bottom = -1;
+      lv_color_t brushColor = {};
+      // Pixels of the brush color, sent as many times as needed to fill a rectangle of the canvas
+      static constexpr uint8_t lineSize = 80;
+      std::array<lv_color_t, lineSize> line {};
+      lv_point_t strokePoint = {};
+      bool strokeActive = false;
+    };
+  }
+}
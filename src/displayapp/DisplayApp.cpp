@@ -1,4 +1,7 @@
 #include "displayapp/DisplayApp.h"
+#include "displayapp/LvglPool.h"
+#include "displayapp/ScreenMemoryBudget.h"
+#include <heap_infinitime.h>
 #include <libraries/log/nrf_log.h>
 #include "displayapp/screens/HeartRate.h"
 #include "displayapp/screens/Motion.h"
@@ -59,8 +62,8 @@ namespace {
     return (SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0;
   }
 
-  void TimerCallback(TimerHandle_t xTimer) {
-    auto* dispApp = static_cast<DisplayApp*>(pvTimerGetTimerID(xTimer));
+  void TimerCallback(void* context) {
+    auto* dispApp = static_cast<DisplayApp*>(context);
     dispApp->PushMessage(Display::Messages::TimerDone);
   }
 }
@@ -79,7 +82,8 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
                        Pinetime::Controllers::AlarmController& alarmController,
                        Pinetime::Controllers::BrightnessController& brightnessController,
                        Pinetime::Controllers::TouchHandler& touchHandler,
-                       Pinetime::Controllers::FS& filesystem)
+                       Pinetime::Controllers::FS& filesystem,
+                       Pinetime::Controllers::TimerWheel& timerWheel)
   : lcd {lcd},
     touchPanel {touchPanel},
     batteryController {batteryController},
@@ -96,7 +100,7 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
     touchHandler {touchHandler},
     filesystem {filesystem},
     lvgl {lcd, filesystem},
-    timer(this, TimerCallback),
+    timer(timerWheel, this, TimerCallback),
     controllers {batteryController,
                  bleController,
                  dateTimeController,
@@ -152,11 +156,19 @@ void DisplayApp::InitHw() {
   brightnessController.Init();
   ApplyBrightness();
   motorController.Init();
+  systemTask->GetBootProfile().Begin(System::BootProfile::Stages::Display);
   lcd.Init();
+  systemTask->GetBootProfile().End(System::BootProfile::Stages::Display);
+  // The first frame is the clock face (or the boot error)
+  lvgl.MarkFirstFrame(systemTask->GetBootProfile());
 }
 
 void DisplayApp::Refresh() {
   auto LoadPreviousScreen = [this]() {
+    if (returnAppStack.Empty()) {
+      LoadScreen(Apps::Clock, FullRefreshDirections::None);
+      return;
+    }
     FullRefreshDirections returnDirection;
     switch (appStackDirections.Pop()) {
       case FullRefreshDirections::Up:
@@ -210,7 +222,7 @@ void DisplayApp::Refresh() {
       if (!currentScreen->IsRunning()) {
         LoadPreviousScreen();
       }
-      queueTimeout = lv_task_handler();
+      queueTimeout = lvgl.RunTasks();
 
       if (!systemTask->IsSleepDisabled() && IsPastDimTime()) {
         if (!isDimmed) {
@@ -371,8 +383,7 @@ void DisplayApp::Refresh() {
         PushMessageToSystemTask(System::Messages::BleRadioEnableToggle);
         break;
       case Messages::UpdateDateTime:
-        // Added to remove warning
-        // What should happen here?
+        currentScreen->OnTimeChanged();
         break;
       case Messages::Chime:
         LoadNewScreen(Apps::Clock, DisplayApp::FullRefreshDirections::None);
@@ -380,7 +391,7 @@ void DisplayApp::Refresh() {
         break;
       case Messages::OnChargingEvent:
         RestoreBrightness();
-        motorController.RunForDuration(15);
+        motorController.Play(Controllers::MotorController::Patterns::Tap);
         break;
     }
   }
@@ -412,13 +423,46 @@ void DisplayApp::LoadNewScreen(Apps app, DisplayApp::FullRefreshDirections direc
 }
 
 void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections direction) {
+  const TickType_t loadStart = xTaskGetTickCount();
   lvgl.CancelTap();
   lv_disp_trig_activity(nullptr);
   motorController.StopRinging();
 
-  currentScreen.reset(nullptr);
+  if (currentScreen != nullptr) {
+    const auto poolStats = Components::LvglPool::GetStats();
+    NRF_LOG_INFO("Screen %d used %d bytes (budget %d), pool fragmentation %d%%",
+                 static_cast<int>(currentApp),
+                 static_cast<int>(poolStats.screenHighWater),
+                 static_cast<int>(poolStats.screenBudget),
+                 Components::LvglPool::Fragmentation());
+  }
+
+  ReleaseCurrentScreen();
   SetFullRefresh(direction);
 
+  // Settings can change how the warm screens are built
+  if (app == Apps::Settings) {
+    DropWarmScreens();
+  }
+
+  const bool resumed = ResumeWarmScreen(app);
+  if (!resumed && (Components::LvglPool::GetStats().free < ScreenMemoryBudget(app) || FreeScreenMemory() < warmScreenMinFreeMemory)) {
+    DropWarmScreens();
+  }
+
+  // After the screens are released and dropped, so that the memory they free doesn't add to the budget of the new screen
+  Components::LvglPool::BeginScreen(ScreenMemoryBudget(app));
+#if configHEAP_PROFILER == 1
+  // The allocations of the screen are accounted to the app in the heap profiler
+  vTaskSetApplicationTaskTag(nullptr, reinterpret_cast<TaskHookFunction_t>(HEAP_TAG_APP_BASE + static_cast<uintptr_t>(app)));
+#endif
+
+  if (resumed) {
+    currentApp = app;
+    NRF_LOG_INFO("Screen %d resumed in %d ticks", static_cast<int>(app), static_cast<int>(xTaskGetTickCount() - loadStart));
+    return;
+  }
+
   switch (app) {
     case Apps::Launcher: {
       std::array<Screens::Tile::Applications, UserAppTypes::Count> apps;
@@ -534,7 +578,9 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
                                                             bleController,
                                                             watchdog,
                                                             motionController,
-                                                            touchPanel);
+                                                            touchPanel,
+                                                            systemTask->Monitor(),
+                                                            systemTask->GetBootProfile());
       break;
     case Apps::FlashLight:
       currentScreen = std::make_unique<Screens::FlashLight>(*systemTask, brightnessController);
@@ -552,6 +598,102 @@ void DisplayApp::LoadScreen(Apps app, DisplayApp::FullRefreshDirections directio
     }
   }
   currentApp = app;
+  NRF_LOG_INFO("Screen %d created in %d ticks", static_cast<int>(app), static_cast<int>(xTaskGetTickCount() - loadStart));
+}
+
+size_t DisplayApp::FreeScreenMemory() {
+  // LVGL allocations that don't fit in its pool fall back to the FreeRTOS heap
+  return Components::LvglPool::GetStats().free + xPortGetFreeHeapSize();
+}
+
+bool DisplayApp::IsKeptWarm(Apps app) const {
+  return app == Apps::Clock || app == Apps::Launcher;
+}
+
+uint8_t DisplayApp::WarmScreenVariant(Apps app) const {
+  if (app == Apps::Clock) {
+    return static_cast<uint8_t>(settingsController.GetWatchFace());
+  }
+  return 0;
+}
+
+void DisplayApp::ReleaseCurrentScreen() {
+  if (currentScreen == nullptr) {
+    return;
+  }
+
+  if (!IsKeptWarm(currentApp) || FreeScreenMemory() < warmScreenMinFreeMemory) {
+    currentScreen.reset(nullptr);
+    return;
+  }
+
+  WarmScreen* slot = nullptr;
+  for (auto& warmScreen : warmScreens) {
+    if (warmScreen.screen == nullptr || warmScreen.app == currentApp) {
+      slot = &warmScreen;
+      break;
+    }
+  }
+  if (slot == nullptr) {
+    currentScreen.reset(nullptr);
+    return;
+  }
+  if (slot->screen != nullptr) {
+    DropWarmScreen(*slot);
+  }
+
+  currentScreen->Suspend();
+  slot->app = currentApp;
+  slot->variant = WarmScreenVariant(currentApp);
+  slot->lvScreen = lv_scr_act();
+  slot->screen = std::move(currentScreen);
+
+  // The next screen is built on a new, empty LVGL screen
+  lv_scr_load(lv_obj_create(nullptr, nullptr));
+}
+
+bool DisplayApp::ResumeWarmScreen(Apps app) {
+  for (auto& warmScreen : warmScreens) {
+    if (warmScreen.screen == nullptr || warmScreen.app != app) {
+      continue;
+    }
+    if (warmScreen.variant != WarmScreenVariant(app)) {
+      DropWarmScreen(warmScreen);
+      return false;
+    }
+
+    lv_obj_t* emptyScreen = lv_scr_act();
+    lv_scr_load(warmScreen.lvScreen);
+    lv_obj_del(emptyScreen);
+
+    currentScreen = std::move(warmScreen.screen);
+    warmScreen.app = Apps::None;
+    warmScreen.lvScreen = nullptr;
+    currentScreen->Resume();
+    return true;
+  }
+  return false;
+}
+
+void DisplayApp::DropWarmScreen(WarmScreen& warmScreen) {
+  // Screens clean lv_scr_act() in their destructor: make the warm screen the active one while it is deleted
+  lv_disp_t* display = lv_disp_get_default();
+  lv_obj_t* activeScreen = display->act_scr;
+  display->act_scr = warmScreen.lvScreen;
+  warmScreen.screen.reset(nullptr);
+  display->act_scr = activeScreen;
+
+  lv_obj_del(warmScreen.lvScreen);
+  warmScreen.app = Apps::None;
+  warmScreen.lvScreen = nullptr;
+}
+
+void DisplayApp::DropWarmScreens() {
+  for (auto& warmScreen : warmScreens) {
+    if (warmScreen.screen != nullptr) {
+      DropWarmScreen(warmScreen);
+    }
+  }
 }
 
 void DisplayApp::PushMessage(Messages msg) {
@@ -566,7 +708,8 @@ void DisplayApp::PushMessage(Messages msg) {
     // Make xQueueSend() non-blocking if the message is a Notification message. We do this to avoid
     // deadlock between SystemTask and DisplayApp when their respective message queues are getting full
     // when a lot of notifications are received on a very short time span.
-    if (msg == Messages::NewNotification) {
+    // UpdateDateTime is sent every second and only triggers a refresh, dropping it is harmless.
+    if (msg == Messages::NewNotification || msg == Messages::UpdateDateTime) {
       timeout = static_cast<TickType_t>(0);
     }
 
@@ -2,6 +2,7 @@
 #include <FreeRTOS.h>
 #include <queue.h>
 #include <task.h>
+#include <array>
 #include <memory>
 #include <systemtask/Messages.h>
 #include "displayapp/apps/Apps.h"
@@ -66,7 +67,8 @@ namespace Pinetime {
                  Pinetime::Controllers::AlarmController& alarmController,
                  Pinetime::Controllers::BrightnessController& brightnessController,
                  Pinetime::Controllers::TouchHandler& touchHandler,
-                 Pinetime::Controllers::FS& filesystem);
+                 Pinetime::Controllers::FS& filesystem,
+                 Pinetime::Controllers::TimerWheel& timerWheel);
       void Start(System::BootErrors error);
       void PushMessage(Display::Messages msg);
 
@@ -112,6 +114,20 @@ namespace Pinetime {
 
       std::unique_ptr<Screens::Screen> currentScreen;
 
+      // Screens kept alive (with their own LVGL screen object) while another app is displayed,
+      // so that going back to them doesn't rebuild the whole object tree
+      struct WarmScreen {
+        Apps app = Apps::None;
+        uint8_t variant = 0;
+        lv_obj_t* lvScreen = nullptr;
+        std::unique_ptr<Screens::Screen> screen;
+      };
+
+      static constexpr uint8_t nbWarmScreens = 2;
+      // Below this amount of free memory for LVGL, screens are deleted instead of being kept warm
+      static constexpr size_t warmScreenMinFreeMemory = 10 * 1024;
+      std::array<WarmScreen, nbWarmScreens> warmScreens;
+
       Apps currentApp = Apps::None;
       Apps returnToApp = Apps::None;
       FullRefreshDirections returnDirection = FullRefreshDirections::None;
@@ -123,6 +139,14 @@ namespace Pinetime {
       void Refresh();
       void LoadNewScreen(Apps app, DisplayApp::FullRefreshDirections direction);
       void LoadScreen(Apps app, DisplayApp::FullRefreshDirections direction);
+      void ReleaseCurrentScreen();
+      bool ResumeWarmScreen(Apps app);
+      void DropWarmScreen(WarmScreen& warmScreen);
+      void DropWarmScreens();
+      bool IsKeptWarm(Apps app) const;
+      // Memory left for the LVGL objects of a screen: the free memory of the LVGL pool and of the FreeRTOS heap it falls back to
+      static size_t FreeScreenMemory();
+      uint8_t WarmScreenVariant(Apps app) const;
       void PushMessageToSystemTask(Pinetime::System::Messages message);
 
       Apps nextApp = Apps::None;
@@ -24,8 +24,9 @@ DisplayApp::DisplayApp(Drivers::St7789& lcd,
                        Pinetime::Controllers::AlarmController& /*alarmController*/,
                        Pinetime::Controllers::BrightnessController& /*brightnessController*/,
                        Pinetime::Controllers::TouchHandler& /*touchHandler*/,
-                       Pinetime::Controllers::FS& /*filesystem*/)
-  : lcd {lcd}, bleController {bleController} {
+                       Pinetime::Controllers::FS& /*filesystem*/,
+                       Pinetime::Controllers::TimerWheel& /*timerWheel*/)
+  : lcd {lcd}, bleController {bleController}, blitter {lcd} {
 }
 
 void DisplayApp::Start() {
@@ -92,11 +93,7 @@ void DisplayApp::Refresh() {
 
 void DisplayApp::DisplayLogo(uint16_t color) {
   Pinetime::Tools::RleDecoder rleDecoder(infinitime_nb, sizeof(infinitime_nb), color, colorBlack);
-  for (int i = 0; i < displayWidth; i++) {
-    rleDecoder.DecodeNext(displayBuffer, displayWidth * bytesPerPixel);
-    ulTaskNotifyTake(pdTRUE, 500);
-    lcd.DrawBuffer(0, i, displayWidth, 1, reinterpret_cast<const uint8_t*>(displayBuffer), displayWidth * bytesPerPixel);
-  }
+  blitter.Draw(rleDecoder, 0, 0, displayWidth, displayHeight);
 }
 
 void DisplayApp::DisplayOtaProgress(uint8_t percent, uint16_t color) {
@@ -6,6 +6,7 @@
 #include <bits/unique_ptr.h>
 #include <queue.h>
 #include "components/gfx/Gfx.h"
+#include "components/gfx/RleBlitter.h"
 #include "drivers/Cst816s.h"
 #include <drivers/Watchdog.h>
 #include <components/motor/MotorController.h>
@@ -34,6 +35,7 @@ namespace Pinetime {
     class AlarmController;
     class BrightnessController;
     class FS;
+    class TimerWheel;
     class SimpleWeatherService;
     class MusicService;
     class NavigationService;
@@ -60,7 +62,8 @@ namespace Pinetime {
                  Pinetime::Controllers::AlarmController& alarmController,
                  Pinetime::Controllers::BrightnessController& brightnessController,
                  Pinetime::Controllers::TouchHandler& touchHandler,
-                 Pinetime::Controllers::FS& filesystem);
+                 Pinetime::Controllers::FS& filesystem,
+                 Pinetime::Controllers::TimerWheel& timerWheel);
       void Start();
 
       void Start(Pinetime::System::BootErrors) {
@@ -98,6 +101,7 @@ namespace Pinetime {
       static constexpr uint16_t colorRedSwapped = 0x00ff;
       static constexpr uint16_t colorBlack = 0x0000;
       uint8_t displayBuffer[displayWidth * bytesPerPixel];
+      Pinetime::Components::RleBlitter blitter;
     };
   }
 }
@@ -0,0 +1,215 @@
+#include "displayapp/FontPack.h"
+#include <algorithm>
+#include <cstring>
+#include <libraries/log/nrf_log.h>
+#include "components/fs/FS.h"
+
+using namespace Pinetime::Components;
+
+FontPack::FontPack(Controllers::FS& fs) : fs {fs} {
+}
+
+FontPack::~FontPack() {
+  Close();
+}
+
+bool FontPack::IsValid(Controllers::FS& fs, const char* path) {
+  lfs_file_t f;
+  if (fs.FileOpen(&f, path, LFS_O_RDONLY) < 0) {
+    return false;
+  }
+  Header h;
+  const bool valid =
+    fs.FileRead(&f, reinterpret_cast<uint8_t*>(&h), sizeof(h)) == static_cast<int>(sizeof(h)) && h.magic == magic && h.version == version;
+  fs.FileClose(&f);
+  return valid;
+}
+
+bool FontPack::Open(const char* path, uint8_t glyphsInUse) {
+  Close();
+  if (fs.FileOpen(&file, path, LFS_O_RDONLY) < 0) {
+    return false;
+  }
+  if (fs.FileRead(&file, reinterpret_cast<uint8_t*>(&header), sizeof(header)) != static_cast<int>(sizeof(header)) ||
+      header.magic != magic || header.version != version) {
+    NRF_LOG_INFO("[FontPack] %s is not a valid glyph pack", path);
+    fs.FileClose(&file);
+    return false;
+  }
+  if (!AllocateCache(glyphsInUse)) {
+    fs.FileClose(&file);
+    return false;
+  }
+
+  std::memset(&font, 0, sizeof(font));
+  font.get_glyph_dsc = GetGlyphDescriptor;
+  font.get_glyph_bitmap = GetGlyphBitmap;
+  font.line_height = header.lineHeight;
+  font.base_line = header.baseLine;
+  font.subpx = LV_FONT_SUBPX_NONE;
+  font.underline_position = header.underlinePosition;
+  font.underline_thickness = header.underlineThickness;
+  font.dsc = this;
+
+  nbEntries = 0;
+  bitmapsUsed = 0;
+  isOpen = true;
+  return true;
+}
+
+void FontPack::Close() {
+  if (isOpen) {
+    fs.FileClose(&file);
+    isOpen = false;
+  }
+  bitmaps.reset();
+  cacheSize = 0;
+}
+
+bool FontPack::AllocateCache(uint8_t glyphsInUse) {
+  // Sizes of the glyphsInUse largest bitmaps of the pack, in decreasing order. The index follows the header.
+  std::array<uint16_t, cacheEntries> largest {};
+  glyphsInUse = std::min(glyphsInUse, cacheEntries);
+  for (uint16_t i = 0; i < header.nbGlyphs; i++) {
+    GlyphEntry glyph;
+    if (fs.FileRead(&file, reinterpret_cast<uint8_t*>(&glyph), sizeof(glyph)) != static_cast<int>(sizeof(glyph))) {
+      return false;
+    }
+    uint16_t size = BitmapSize(glyph);
+    for (uint8_t j = 0; j < glyphsInUse; j++) {
+      if (size > largest[j]) {
+        std::swap(size, largest[j]);
+      }
+    }
+  }
+
+  uint32_t size = 0;
+  for (uint8_t j = 0; j < glyphsInUse; j++) {
+    size += largest[j];
+  }
+  if (size > maxCacheSize) {
+    NRF_LOG_INFO("[FontPack] The glyphs in use need %d bytes, the cache is limited to %d", size, maxCacheSize);
+    size = maxCacheSize;
+  }
+  cacheSize = static_cast<uint16_t>(size);
+  bitmaps = std::make_unique<uint8_t[]>(cacheSize);
+  return true;
+}
+
+bool FontPack::GetGlyphDescriptor(const lv_font_t* font, lv_font_glyph_dsc_t* dsc, uint32_t letter, uint32_t /*letterNext*/) {
+  auto* pack = static_cast<FontPack*>(font->dsc);
+  const CacheEntry* entry = pack->Lookup(letter);
+  if (entry == nullptr) {
+    return false;
+  }
+
+  // Round the advance width to the nearest pixel, like the built-in fonts
+  dsc->adv_w = (entry->glyph.advanceWidth + (1 << 3)) >> 4;
+  dsc->box_w = entry->glyph.boxWidth;
+  dsc->box_h = entry->glyph.boxHeight;
+  dsc->ofs_x = entry->glyph.offsetX;
+  dsc->ofs_y = entry->glyph.offsetY;
+  dsc->bpp = pack->header.bpp;
+  return true;
+}
+
+const uint8_t* FontPack::GetGlyphBitmap(const lv_font_t* font, uint32_t letter) {
+  auto* pack = static_cast<FontPack*>(font->dsc);
+  const CacheEntry* entry = pack->Lookup(letter);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  return &pack->bitmaps[entry->bitmapOffset];
+}
+
+FontPack::CacheEntry* FontPack::Lookup(uint32_t codePoint) {
+  if (!isOpen) {
+    return nullptr;
+  }
+  for (uint8_t i = 0; i < nbEntries; i++) {
+    if (entries[i].codePoint == codePoint) {
+      hits++;
+      entries[i].lastUse = ++useCounter;
+      return entries[i].found ? &entries[i] : nullptr;
+    }
+  }
+  misses++;
+  return Load(codePoint);
+}
+
+bool FontPack::FindGlyph(uint32_t codePoint, GlyphEntry& glyph) {
+  // The index is sorted by code point
+  uint16_t low = 0;
+  uint16_t high = header.nbGlyphs;
+  while (low < high) {
+    const uint16_t middle = low + (high - low) / 2;
+    if (fs.FileSeek(&file, sizeof(Header) + middle * sizeof(GlyphEntry)) < 0 ||
+        fs.FileRead(&file, reinterpret_cast<uint8_t*>(&glyph), sizeof(glyph)) != static_cast<int>(sizeof(glyph))) {
+      return false;
+    }
+    if (glyph.codePoint == codePoint) {
+      return true;
+    }
+    if (glyph.codePoint < codePoint) {
+      low = middle + 1;
+    } else {
+      high = middle;
+    }
+  }
+  return false;
+}
+
+FontPack::CacheEntry* FontPack::Load(uint32_t codePoint) {
+  GlyphEntry glyph {};
+  const bool found = FindGlyph(codePoint, glyph);
+  const uint16_t size = found ? BitmapSize(glyph) : 0;
+  if (size > cacheSize) {
+    NRF_LOG_INFO("[FontPack] Glyph %d is too large for the cache", codePoint);
+    return nullptr;
+  }
+
+  while (nbEntries == cacheEntries || bitmapsUsed + size > cacheSize) {
+    Evict();
+  }
+
+  if (size > 0 && (fs.FileSeek(&file, glyph.bitmapOffset) < 0 || fs.FileRead(&file, &bitmaps[bitmapsUsed], size) != size)) {
+    return nullptr;
+  }
+
+  // Glyphs that are not in the pack are cached too, so that they are not searched in the file each time the text is measured
+  CacheEntry& entry = entries[nbEntries++];
+  entry.codePoint = codePoint;
+  entry.found = found;
+  entry.glyph = glyph;
+  entry.bitmapOffset = bitmapsUsed;
+  entry.bitmapSize = size;
+  entry.lastUse = ++useCounter;
+  bitmapsUsed += size;
+  return found ? &entry : nullptr;
+}
+
+void FontPack::Evict() {
+  uint8_t oldest = 0;
+  for (uint8_t i = 1; i < nbEntries; i++) {
+    if (entries[i].lastUse < entries[oldest].lastUse) {
+      oldest = i;
+    }
+  }
+
+  const CacheEntry evicted = entries[oldest];
+  const uint16_t end = evicted.bitmapOffset + evicted.bitmapSize;
+  std::memmove(&bitmaps[evicted.bitmapOffset], &bitmaps[end], bitmapsUsed - end);
+  bitmapsUsed -= evicted.bitmapSize;
+
+  entries[oldest] = entries[--nbEntries];
+  for (uint8_t i = 0; i < nbEntries; i++) {
+    if (entries[i].bitmapOffset >= end) {
+      entries[i].bitmapOffset -= evicted.bitmapSize;
+    }
+  }
+}
+
+uint16_t FontPack::BitmapSize(const GlyphEntry& glyph) const {
+  // The rows of the bitmaps are not padded, like in the built-in fonts
+  return (glyph.boxWidth * glyph.boxHeight * header.bpp + 7) / 8;
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <lvgl/lvgl.h>
+#include "littlefs/lfs.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+  }
+
+  namespace Components {
+    /**
+     * LVGL font read on demand from a glyph pack in the file system (see generate-fonts.py, format "pack").
+     *
+     * Unlike lv_font_load(), which copies the whole font in the heap, only the glyphs that are displayed are loaded. The glyph
+     * index of the pack is sorted by code point and searched directly in the file, and the glyph bitmap is read in a single
+     * burst. The most recently used glyphs are kept in a RAM cache, sized when the pack is opened so that it holds the largest
+     * glyphs that are displayed at the same time: LVGL draws the screen a few rows at a time and asks for the bitmap of every
+     * glyph of a label for each of these rows, so a cache that is too small reads the same glyphs again and again.
+     *
+     * The file stays open while the font is in use. The pointers returned to LVGL are only valid until the next glyph is
+     * requested, which is how LVGL uses them.
+     */
+    class FontPack {
+    public:
+      explicit FontPack(Controllers::FS& fs);
+      ~FontPack();
+
+      FontPack(const FontPack&) = delete;
+      FontPack& operator=(const FontPack&) = delete;
+
+      /** @return true if the file exists and is a glyph pack that this firmware can read */
+      static bool IsValid(Controllers::FS& fs, const char* path);
+
+      /**
+       * @param glyphsInUse the largest number of different glyphs displayed at the same time with this font (at most 16). The
+       * cache holds the glyphsInUse largest bitmaps of the pack, so that redrawing the text doesn't read the file again.
+       */
+      bool Open(const char* path, uint8_t glyphsInUse);
+      void Close();
+
+      /** @return the font to use in the styles, or nullptr if the pack couldn't be opened */
+      lv_font_t* Font() {
+        return isOpen ? &font : nullptr;
+      }
+
+      struct Stats {
+        uint32_t hits;
+        uint32_t misses;
+        uint16_t cacheSize;
+      };
+
+      Stats GetStats() const {
+        return {hits, misses, cacheSize};
+      }
+
+      struct Header {
+        uint32_t magic;
+        uint16_t nbGlyphs;
+        uint8_t bpp;
+        uint8_t version;
+        int16_t lineHeight;
+        int16_t baseLine;
+        int8_t underlinePosition;
+        uint8_t underlineThickness;
+        uint16_t reserved;
+      };
+
+      struct GlyphEntry {
+        uint32_t codePoint;
+        uint32_t bitmapOffset;
+        // Advance width in 1/16 px
+        uint16_t advanceWidth;
+        uint8_t boxWidth;
+        uint8_t boxHeight;
+        int8_t offsetX;
+        int8_t offsetY;
+        uint16_t reserved;
+      };
+
+      static_assert(sizeof(Header) == 16);
+      static_assert(sizeof(GlyphEntry) == 16);
+
+      static constexpr uint32_t magic = 0x4b504647; // "GFPK"
+      static constexpr uint8_t version = 1;
+
+    private:
+      struct CacheEntry {
+        uint32_t codePoint;
+        bool found;
+        GlyphEntry glyph;
+        uint16_t bitmapOffset;
+        uint16_t bitmapSize;
+        uint32_t lastUse;
+      };
+
+      static bool GetGlyphDescriptor(const lv_font_t* font, lv_font_glyph_dsc_t* dsc, uint32_t letter, uint32_t letterNext);
+      static const uint8_t* GetGlyphBitmap(const lv_font_t* font, uint32_t letter);
+
+      CacheEntry* Lookup(uint32_t codePoint);
+      bool FindGlyph(uint32_t codePoint, GlyphEntry& glyph);
+      CacheEntry* Load(uint32_t codePoint);
+      void Evict();
+      uint16_t BitmapSize(const GlyphEntry& glyph) const;
+      bool AllocateCache(uint8_t glyphsInUse);
+
+      Controllers::FS& fs;
+      lfs_file_t file;
+      bool isOpen = false;
+      Header header;
+      lv_font_t font;
+
+      static constexpr uint8_t cacheEntries = 16;
+      static constexpr uint16_t maxCacheSize = 4096;
+      std::array<CacheEntry, cacheEntries> entries;
+      uint8_t nbEntries = 0;
+      // Bitmaps of the cached glyphs, without any gap
+      std::unique_ptr<uint8_t[]> bitmaps;
+      uint16_t cacheSize = 0;
+      uint16_t bitmapsUsed = 0;
+      uint32_t useCounter = 0;
+
+      uint32_t hits = 0;
+      uint32_t misses = 0;
+    };
+  }
+}
@@ -0,0 +1,448 @@
+#include "displayapp/ImageDecoder.h"
+#include <algorithm>
+#include <cstring>
+#include <new>
+
+using namespace Pinetime::Components;
+
+// Content of an image file, in the file system or in RAM
+struct ImageDecoder::Source {
+  const uint8_t* data = nullptr;
+  uint32_t size = 0;
+  uint32_t position = 0;
+  lv_fs_file_t file;
+
+  bool Open(const void* src) {
+    switch (lv_img_src_get_type(src)) {
+      case LV_IMG_SRC_VARIABLE: {
+        const auto* dsc = static_cast<const lv_img_dsc_t*>(src);
+        data = dsc->data;
+        size = dsc->data_size;
+        position = 0;
+        return dsc->header.cf == LV_IMG_CF_USER_ENCODED_0 && data != nullptr;
+      }
+      case LV_IMG_SRC_FILE:
+        data = nullptr;
+        return lv_fs_open(&file, static_cast<const char*>(src), LV_FS_MODE_RD) == LV_FS_RES_OK;
+      default:
+        return false;
+    }
+  }
+
+  bool Read(void* buffer, uint32_t count) {
+    if (data != nullptr) {
+      if (count > size - position) {
+        return false;
+      }
+      std::memcpy(buffer, data + position, count);
+      position += count;
+      return true;
+    }
+    uint32_t read = 0;
+    return lv_fs_read(&file, buffer, count, &read) == LV_FS_RES_OK && read == count;
+  }
+
+  bool Seek(uint32_t offset) {
+    if (data != nullptr) {
+      if (offset > size) {
+        return false;
+      }
+      position = offset;
+      return true;
+    }
+    return lv_fs_seek(&file, offset) == LV_FS_RES_OK;
+  }
+
+  void Close() {
+    if (data == nullptr) {
+      lv_fs_close(&file);
+    }
+  }
+};
+
+// Constructed at the start of the memory allocated by Open(), followed by the buffers it points to
+struct ImageDecoder::Context {
+  Source source;
+  Header header {};
+  uint16_t width = 0;
+  uint16_t height = 0;
+  uint16_t stride = 0;
+  uint8_t bpp = 0;
+  uint32_t indexOffset = 0;
+
+  // Next row in the file, and its offset
+  uint16_t nextRow = 0;
+  uint32_t nextRowOffset = 0;
+  // Row currently in rowBuffer, -1 if none
+  int32_t decodedRow = -1;
+
+  lv_color_t* palette = nullptr;
+  lv_opa_t* paletteOpa = nullptr;
+  uint8_t* rowBuffer = nullptr;
+  uint8_t* compressedBuffer = nullptr;
+};
+
+namespace {
+  // Set by Info() in the reserved bits of the header of the compressed images. The header is passed to Open(), which knows
+  // without reading the file again that the other images go to the built-in decoder.
+  constexpr uint8_t encodedMarker = 1;
+
+  uint8_t BitsPerPixel(uint8_t format) {
+    switch (format) {
+      case LV_IMG_CF_TRUE_COLOR:
+        return 16;
+      case LV_IMG_CF_TRUE_COLOR_ALPHA:
+        return 24;
+      case LV_IMG_CF_INDEXED_1BIT:
+        return 1;
+      case LV_IMG_CF_INDEXED_2BIT:
+        return 2;
+      case LV_IMG_CF_INDEXED_4BIT:
+        return 4;
+      case LV_IMG_CF_INDEXED_8BIT:
+        return 8;
+      default:
+        return 0;
+    }
+  }
+}
+
+void ImageDecoder::Register() {
+  lv_img_decoder_t* decoder = lv_img_decoder_create();
+  lv_img_decoder_set_info_cb(decoder, Info);
+  lv_img_decoder_set_open_cb(decoder, Open);
+  lv_img_decoder_set_read_line_cb(decoder, ReadLine);
+  lv_img_decoder_set_close_cb(decoder, Close);
+}
+
+bool ImageDecoder::ReadHeader(Source& source, Header& header) {
+  return source.Read(&header, sizeof(header)) && BitsPerPixel(header.format) != 0 && header.rowsPerIndex != 0 &&
+         header.compression <= Compressions::Lz4;
+}
+
+lv_res_t ImageDecoder::Info(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header) {
+  // The images in RAM tell their format without any I/O
+  const lv_img_src_t type = lv_img_src_get_type(src);
+  if (type != LV_IMG_SRC_FILE &&
+      (type != LV_IMG_SRC_VARIABLE || static_cast<const lv_img_dsc_t*>(src)->header.cf != LV_IMG_CF_USER_ENCODED_0)) {
+    return lv_img_decoder_built_in_info(decoder, src, header);
+  }
+
+  Source source;
+  if (!source.Open(src)) {
+    return LV_RES_INV;
+  }
+  lv_img_header_t imgHeader;
+  if (!source.Read(&imgHeader, sizeof(imgHeader))) {
+    source.Close();
+    return LV_RES_INV;
+  }
+  if (imgHeader.cf != LV_IMG_CF_USER_ENCODED_0) {
+    // A plain image file: its header is all the built-in decoder would read, so the file isn't opened again to get it
+    source.Close();
+    *header = imgHeader;
+    header->reserved = 0;
+    return LV_RES_OK;
+  }
+  Header encodedHeader;
+  const bool valid = ReadHeader(source, encodedHeader);
+  source.Close();
+  if (!valid) {
+    return LV_RES_INV;
+  }
+
+  // Format of the lines given to LVGL: the indexed formats are converted to colors with an alpha byte
+  header->cf = (encodedHeader.format == LV_IMG_CF_TRUE_COLOR) ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA;
+  header->w = imgHeader.w;
+  header->h = imgHeader.h;
+  header->always_zero = 0;
+  header->reserved = encodedMarker;
+  return LV_RES_OK;
+}
+
+lv_res_t ImageDecoder::Open(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+  if (dsc->header.reserved != encodedMarker) {
+    return lv_img_decoder_built_in_open(decoder, dsc);
+  }
+  Source source;
+  if (!source.Open(dsc->src)) {
+    return LV_RES_INV;
+  }
+  lv_img_header_t imgHeader;
+  Header header;
+  if (!source.Read(&imgHeader, sizeof(imgHeader)) || imgHeader.cf != LV_IMG_CF_USER_ENCODED_0 || !ReadHeader(source, header)) {
+    source.Close();
+    return LV_RES_INV;
+  }
+
+  const uint8_t bpp = BitsPerPixel(header.format);
+  const uint16_t paletteSize = (bpp <= 8) ? (1 << bpp) : 0;
+  const uint16_t stride = (imgHeader.w * bpp + 7) / 8;
+  // Everything in a single allocation: the context, the palette, the decoded row and the compressed row
+  const size_t size = sizeof(Context) + paletteSize * (sizeof(lv_color_t) + sizeof(lv_opa_t)) + stride + header.maxRowSize;
+  auto* memory = static_cast<uint8_t*>(lv_mem_alloc(size));
+  if (memory == nullptr) {
+    source.Close();
+    return LV_RES_INV;
+  }
+
+  auto* context = new (memory) Context;
+  context->source = source;
+  context->header = header;
+  context->width = imgHeader.w;
+  context->height = imgHeader.h;
+  context->stride = stride;
+  context->bpp = bpp;
+  context->palette = reinterpret_cast<lv_color_t*>(memory + sizeof(Context));
+  context->paletteOpa = reinterpret_cast<lv_opa_t*>(context->palette + paletteSize);
+  context->rowBuffer = context->paletteOpa + paletteSize;
+  context->compressedBuffer = context->rowBuffer + stride;
+  context->indexOffset = sizeof(lv_img_header_t) + sizeof(Header) + paletteSize * sizeof(lv_color32_t);
+  context->nextRow = context->height;
+
+  for (uint16_t i = 0; i < paletteSize; i++) {
+    lv_color32_t color;
+    if (!context->source.Read(&color, sizeof(color))) {
+      context->source.Close();
+      context->~Context();
+      lv_mem_free(memory);
+      return LV_RES_INV;
+    }
+    context->palette[i] = lv_color_make(color.ch.red, color.ch.green, color.ch.blue);
+    context->paletteOpa[i] = color.ch.alpha;
+  }
+
+  dsc->img_data = nullptr;
+  dsc->user_data = context;
+  return LV_RES_OK;
+}
+
+bool ImageDecoder::DecodeRow(Context& context, uint16_t y) {
+  // Restart from the closest indexed row, unless the row is a bit further in the file
+  if (y < context.nextRow || y - context.nextRow >= context.header.rowsPerIndex) {
+    const uint16_t indexedRow = y / context.header.rowsPerIndex;
+    uint32_t offset;
+    if (!context.source.Seek(context.indexOffset + indexedRow * sizeof(offset)) || !context.source.Read(&offset, sizeof(offset))) {
+      return false;
+    }
+    context.nextRow = indexedRow * context.header.rowsPerIndex;
+    context.nextRowOffset = offset;
+  }
+
+  uint16_t rowSize;
+  while (true) {
+    if (!context.source.Seek(context.nextRowOffset) || !context.source.Read(&rowSize, sizeof(rowSize))) {
+      return false;
+    }
+    context.nextRow++;
+    context.nextRowOffset += sizeof(rowSize) + rowSize;
+    if (context.nextRow > y) {
+      break;
+    }
+  }
+
+  context.decodedRow = -1;
+  if (rowSize > context.header.maxRowSize || !context.source.Read(context.compressedBuffer, rowSize)) {
+    return false;
+  }
+
+  bool decoded = false;
+  switch (context.header.compression) {
+    case Compressions::None:
+      decoded = rowSize == context.stride;
+      if (decoded) {
+        std::memcpy(context.rowBuffer, context.compressedBuffer, rowSize);
+      }
+      break;
+    case Compressions::Rle:
+      decoded = DecodeRle(context.compressedBuffer, rowSize, context.rowBuffer, context.stride, context.bpp > 8 ? context.bpp / 8 : 1);
+      break;
+    case Compressions::Lz4:
+      decoded = DecodeLz4(context.compressedBuffer, rowSize, context.rowBuffer, context.stride);
+      break;
+  }
+  if (decoded) {
+    context.decodedRow = y;
+  }
+  return decoded;
+}
+
+lv_res_t ImageDecoder::ReadLine(lv_img_decoder_t* decoder,
+                                lv_img_decoder_dsc_t* dsc,
+                                lv_coord_t x,
+                                lv_coord_t y,
+                                lv_coord_t len,
+                                uint8_t* buf) {
+  if (dsc->header.reserved != encodedMarker) {
+    return lv_img_decoder_built_in_read_line(decoder, dsc, x, y, len, buf);
+  }
+  auto* context = static_cast<Context*>(dsc->user_data);
+  if (x < 0 || y < 0 || len <= 0 || x + len > context->width || y >= context->height) {
+    return LV_RES_INV;
+  }
+  if (context->decodedRow != y && !DecodeRow(*context, y)) {
+    return LV_RES_INV;
+  }
+
+  switch (context->header.format) {
+    case LV_IMG_CF_TRUE_COLOR:
+    case LV_IMG_CF_TRUE_COLOR_ALPHA:
+      std::memcpy(buf, context->rowBuffer + x * (context->bpp / 8), len * (context->bpp / 8));
+      break;
+    default: {
+      const uint8_t pixelsPerByte = 8 / context->bpp;
+      const uint8_t mask = (1 << context->bpp) - 1;
+      for (lv_coord_t i = 0; i < len; i++) {
+        const uint16_t px = x + i;
+        const uint8_t shift = 8 - context->bpp * (px % pixelsPerByte + 1);
+        const uint8_t index = (context->rowBuffer[px / pixelsPerByte] >> shift) & mask;
+        // Same layout as the built-in decoder: the color may not be aligned, so it is written byte by byte
+        const lv_color_t color = context->palette[index];
+        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE] = color.full & 0xFF;
+        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + 1] = (color.full >> 8) & 0xFF;
+        buf[i * LV_IMG_PX_SIZE_ALPHA_BYTE + 2] = context->paletteOpa[index];
+      }
+    } break;
+  }
+  return LV_RES_OK;
+}
+
+void ImageDecoder::Close(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc) {
+  if (dsc->header.reserved != encodedMarker) {
+    lv_img_decoder_built_in_close(decoder, dsc);
+    return;
+  }
+  auto* context = static_cast<Context*>(dsc->user_data);
+  if (context != nullptr) {
+    context->source.Close();
+    context->~Context();
+    lv_mem_free(context);
+    dsc->user_data = nullptr;
+  }
+}
+
+bool ImageDecoder::DecodeRle(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize, uint8_t unitSize) {
+  size_t in = 0;
+  size_t out = 0;
+  while (in < srcSize) {
+    const uint8_t control = src[in++];
+    if ((control & 0x80) != 0) {
+      const size_t count = (control & 0x7F) + 2;
+      if (in + unitSize > srcSize || out + count * unitSize > dstSize) {
+        return false;
+      }
+      for (size_t i = 0; i < count; i++) {
+        std::memcpy(dst + out, src + in, unitSize);
+        out += unitSize;
+      }
+      in += unitSize;
+    } else {
+      const size_t size = (control + 1) * unitSize;
+      if (in + size > srcSize || out + size > dstSize) {
+        return false;
+      }
+      std::memcpy(dst + out, src + in, size);
+      in += size;
+      out += size;
+    }
+  }
+  return out == dstSize;
+}
+
+size_t ImageDecoder::EncodeRle(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity, uint8_t unitSize) {
+  const size_t nbUnits = srcSize / unitSize;
+  size_t out = 0;
+  size_t literalStart = 0;
+  size_t literals = 0;
+
+  auto flushLiterals = [&]() {
+    while (literals > 0) {
+      const size_t count = std::min<size_t>(literals, 128);
+      if (out + 1 + count * unitSize > dstCapacity) {
+        return false;
+      }
+      dst[out++] = static_cast<uint8_t>(count - 1);
+      std::memcpy(dst + out, src + literalStart * unitSize, count * unitSize);
+      out += count * unitSize;
+      literalStart += count;
+      literals -= count;
+    }
+    return true;
+  };
+
+  size_t i = 0;
+  while (i < nbUnits) {
+    size_t run = 1;
+    while (i + run < nbUnits && run < 129 && std::memcmp(src + (i + run) * unitSize, src + i * unitSize, unitSize) == 0) {
+      run++;
+    }
+    if (run >= 2) {
+      if (!flushLiterals() || out + 1 + unitSize > dstCapacity) {
+        return 0;
+      }
+      dst[out++] = static_cast<uint8_t>(0x80 | (run - 2));
+      std::memcpy(dst + out, src + i * unitSize, unitSize);
+      out += unitSize;
+      i += run;
+      literalStart = i;
+    } else {
+      literals++;
+      i++;
+    }
+  }
+  return flushLiterals() ? out : 0;
+}
+
+bool ImageDecoder::DecodeLz4(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize) {
+  size_t in = 0;
+  size_t out = 0;
+
+  auto readLength = [&](size_t length) -> size_t {
+    if (length == 15) {
+      uint8_t byte;
+      do {
+        if (in >= srcSize) {
+          return SIZE_MAX;
+        }
+        byte = src[in++];
+        length += byte;
+      } while (byte == 255);
+    }
+    return length;
+  };
+
+  while (in < srcSize) {
+    const uint8_t token = src[in++];
+    const size_t literals = readLength(token >> 4);
+    if (literals == SIZE_MAX || in + literals > srcSize || out + literals > dstSize) {
+      return false;
+    }
+    std::memcpy(dst + out, src + in, literals);
+    in += literals;
+    out += literals;
+
+    // The last sequence only has literals
+    if (in == srcSize) {
+      break;
+    }
+
+    if (in + 2 > srcSize) {
+      return false;
+    }
+    const size_t offset = src[in] | (src[in + 1] << 8);
+    in += 2;
+    size_t matchLength = readLength(token & 0x0F);
+    if (matchLength == SIZE_MAX || offset == 0 || offset > out) {
+      return false;
+    }
+    matchLength += 4;
+    if (out + matchLength > dstSize) {
+      return false;
+    }
+    // The match can overlap the bytes it produces, so it is copied byte by byte
+    for (size_t i = 0; i < matchLength; i++, out++) {
+      dst[out] = dst[out - offset];
+    }
+  }
+  return out == dstSize;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <lvgl/lvgl.h>
+
+namespace Pinetime {
+  namespace Components {
+    /**
+     * LVGL image decoder for the images compressed by lv_img_conv.py (--compression), stored in the file system or in RAM
+     * (an lv_img_dsc_t whose data is the content of the file, see Widgets::StaticLayer).
+     *
+     * The rows are compressed independently (run-length or LZ4 block) and decoded one at a time into the line buffer of
+     * LVGL, so that the image never has to be decompressed entirely in RAM. An index of the offset of every rowsPerIndex-th row allows
+     * LVGL to start drawing anywhere in the image, and the rows that follow are read sequentially.
+     * The palette of the indexed formats (1, 2, 4 and 8 bits) is converted once, when the image is opened.
+     *
+     * The decoder is registered ahead of the built-in decoder of LVGL, to which it hands the other images (LVGL binary format).
+     * The header of a plain image file is read only once: Info() returns it, as the built-in decoder would, and Open(),
+     * ReadLine() and Close() call the built-in decoder for it.
+     */
+    class ImageDecoder {
+    public:
+      static void Register();
+
+      enum class Compressions : uint8_t { None, Rle, Lz4 };
+
+      // Follows the LVGL header, whose color format is LV_IMG_CF_USER_ENCODED_0
+      struct Header {
+        // LVGL color format of the decoded rows
+        uint8_t format;
+        Compressions compression;
+        uint8_t rowsPerIndex;
+        uint8_t reserved;
+        // Size of the largest compressed row
+        uint16_t maxRowSize;
+        uint16_t reserved2;
+      };
+      static_assert(sizeof(Header) == 8);
+
+      /**
+       * Control byte n, followed by n + 1 literal units (n < 0x80) or by a unit repeated (n & 0x7F) + 2 times.
+       * @return false if the data is corrupted or doesn't decompress to exactly dstSize bytes
+       */
+      static bool DecodeRle(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize, uint8_t unitSize);
+      /** Same encoding as lv_img_conv.py. @return the size of the compressed data, 0 if it doesn't fit in dstCapacity */
+      static size_t EncodeRle(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstCapacity, uint8_t unitSize);
+      static bool DecodeLz4(const uint8_t* src, size_t srcSize, uint8_t* dst, size_t dstSize);
+
+    private:
+      struct Source;
+      struct Context;
+
+      static lv_res_t Info(lv_img_decoder_t* decoder, const void* src, lv_img_header_t* header);
+      static lv_res_t Open(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc);
+      static lv_res_t
+      ReadLine(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf);
+      static void Close(lv_img_decoder_t* decoder, lv_img_decoder_dsc_t* dsc);
+
+      static bool ReadHeader(Source& source, Header& header);
+      static bool DecodeRow(Context& context, uint16_t y);
+    };
+  }
+}
@@ -3,9 +3,11 @@
 
 #include <FreeRTOS.h>
 #include <task.h>
+#include <algorithm>
 #include "drivers/St7789.h"
 #include "littlefs/lfs.h"
 #include "components/fs/FS.h"
+#include "displayapp/ImageDecoder.h"
 
 using namespace Pinetime::Components;
 
@@ -60,7 +62,8 @@ static void disp_flush(lv_disp_drv_t* disp_drv, const lv_area_t* area, lv_color_
 
 static void rounder(lv_disp_drv_t* disp_drv, lv_area_t* area) {
   auto* lvgl = static_cast<LittleVgl*>(disp_drv->user_data);
-  if (lvgl->GetFullRefresh()) {
+  // Don't consume the full refresh of the screen transition while rendering into a render target
+  if (!lvgl->IsRendering() && lvgl->GetFullRefresh()) {
     area->x1 = 0;
     area->x2 = LV_HOR_RES - 1;
     area->y1 = 0;
@@ -82,6 +85,7 @@ void LittleVgl::Init() {
   InitDisplay();
   InitTouchpad();
   InitFileSystem();
+  ImageDecoder::Register();
 }
 
 void LittleVgl::InitDisplay() {
@@ -102,7 +106,7 @@ void LittleVgl::InitDisplay() {
   disp_drv.rounder_cb = rounder;
 
   /*Finally register the driver*/
-  lv_disp_drv_register(&disp_drv);
+  display = lv_disp_drv_register(&disp_drv);
 }
 
 void LittleVgl::InitTouchpad() {
@@ -112,7 +116,33 @@ void LittleVgl::InitTouchpad() {
   indev_drv.type = LV_INDEV_TYPE_POINTER;
   indev_drv.read_cb = touchpad_read;
   indev_drv.user_data = this;
-  lv_indev_drv_register(&indev_drv);
+  touchpad = lv_indev_drv_register(&indev_drv);
+}
+
+uint32_t LittleVgl::RunTasks() {
+  if (canvas != nullptr) {
+    canvas->Flush();
+  }
+  uint32_t timeTillNext = lv_task_handler();
+
+  // The display refresh and input device tasks run every LV_DISP_DEF_REFR_PERIOD even when there is nothing to draw or read.
+  // When nothing is invalidated, animated or touched, only wake up for the tasks created by the screens.
+  if (display->inv_p != 0 || lv_anim_count_running() > 0 || lv_disp_get_inactive_time(display) < interactionGracePeriod) {
+    return timeTillNext;
+  }
+
+  uint32_t timeTillNextScreenTask = LV_NO_TASK_READY;
+  for (lv_task_t* task = lv_task_get_next(nullptr); task != nullptr; task = lv_task_get_next(task)) {
+    if (task == display->refr_task || task == touchpad->driver.read_task || task->prio == LV_TASK_PRIO_OFF) {
+      continue;
+    }
+    uint32_t elapsed = lv_tick_elaps(task->last_run);
+    uint32_t remaining = (elapsed < task->period) ? task->period - elapsed : 0;
+    if (remaining < timeTillNextScreenTask) {
+      timeTillNextScreenTask = remaining;
+    }
+  }
+  return timeTillNextScreenTask;
 }
 
 void LittleVgl::InitFileSystem() {
@@ -134,24 +164,77 @@ void LittleVgl::InitFileSystem() {
 void LittleVgl::SetFullRefresh(FullRefreshDirections direction) {
   if (scrollDirection == FullRefreshDirections::None) {
     scrollDirection = direction;
-    if (scrollDirection == FullRefreshDirections::Down) {
-      lv_disp_set_direction(lv_disp_get_default(), 1);
-    } else if (scrollDirection == FullRefreshDirections::Right) {
-      lv_disp_set_direction(lv_disp_get_default(), 2);
-    } else if (scrollDirection == FullRefreshDirections::Left) {
-      lv_disp_set_direction(lv_disp_get_default(), 3);
-    } else if (scrollDirection == FullRefreshDirections::RightAnim) {
-      lv_disp_set_direction(lv_disp_get_default(), 5);
-    } else if (scrollDirection == FullRefreshDirections::LeftAnim) {
-      lv_disp_set_direction(lv_disp_get_default(), 4);
-    }
+    ApplyScrollDirection();
   }
   fullRefresh = true;
 }
 
+void LittleVgl::ApplyScrollDirection() {
+  if (scrollDirection == FullRefreshDirections::Down) {
+    lv_disp_set_direction(lv_disp_get_default(), 1);
+  } else if (scrollDirection == FullRefreshDirections::Right) {
+    lv_disp_set_direction(lv_disp_get_default(), 2);
+  } else if (scrollDirection == FullRefreshDirections::Left) {
+    lv_disp_set_direction(lv_disp_get_default(), 3);
+  } else if (scrollDirection == FullRefreshDirections::RightAnim) {
+    lv_disp_set_direction(lv_disp_get_default(), 5);
+  } else if (scrollDirection == FullRefreshDirections::LeftAnim) {
+    lv_disp_set_direction(lv_disp_get_default(), 4);
+  } else {
+    lv_disp_set_direction(lv_disp_get_default(), 0);
+  }
+}
+
+bool LittleVgl::Render(RenderTarget& target) {
+  // LVGL renders into the buffers that the last flush may still be sending to the display: wait for the end of the transfer
+  ulTaskNotifyTake(pdTRUE, 200);
+
+  renderTarget = &target;
+  renderNextLine = 0;
+  renderError = false;
+
+  // Render the whole screen from top to bottom, whatever the direction of the pending screen transition
+  lv_disp_set_direction(display, 0);
+  lv_obj_invalidate(lv_scr_act());
+  lv_refr_now(display);
+
+  renderTarget = nullptr;
+  ApplyScrollDirection();
+  // Nothing was sent to the display yet
+  lv_obj_invalidate(lv_scr_act());
+  // The next flush waits for the end of the transfer that was taken above
+  xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+
+  return !renderError && renderNextLine == LV_VER_RES;
+}
+
+void LittleVgl::RenderArea(const lv_area_t* area, const lv_color_t* color_p) {
+  if (renderError) {
+    return;
+  }
+  if (area->x1 != 0 || area->x2 != LV_HOR_RES - 1 || area->y1 != renderNextLine) {
+    renderError = true;
+    return;
+  }
+
+  for (lv_coord_t y = area->y1; y <= area->y2; y++) {
+    if (!renderTarget->WriteRow(color_p + (y - area->y1) * LV_HOR_RES)) {
+      renderError = true;
+      return;
+    }
+  }
+  renderNextLine = area->y2 + 1;
+}
+
 void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
   uint16_t y1, y2, width, height = 0;
 
+  if (renderTarget != nullptr) {
+    RenderArea(area, color_p);
+    lv_disp_flush_ready(&disp_drv);
+    return;
+  }
+
   ulTaskNotifyTake(pdTRUE, 200);
   // Notification is still needed (even if there is a mutex on SPI) because of the DataCommand pin
   // which cannot be set/clear during a transfer.
@@ -230,11 +313,61 @@ void LittleVgl::FlushDisplay(const lv_area_t* area, lv_color_t* color_p) {
     lcd.DrawBuffer(area->x1, y1, width, height, reinterpret_cast<const uint8_t*>(color_p), width * height * 2);
   }
 
+  if (firstFrameProfile != nullptr && lv_disp_flush_is_last(&disp_drv)) {
+    // Wait for the end of the transfer of the last area of the frame, and give the notification back for the next flush
+    ulTaskNotifyTake(pdTRUE, 200);
+    firstFrameProfile->Mark(System::BootProfile::Stages::ClockFace);
+    firstFrameProfile = nullptr;
+    xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+  }
+
   // IMPORTANT!!!
   // Inform the graphics library that you are ready with the flushing
   lv_disp_flush_ready(&disp_drv);
 }
 
+void LittleVgl::SetCanvas(Canvas* canvas) {
+  if (this->canvas != nullptr && canvas == nullptr) {
+    // The last line of the canvas may still be read by the transfer in progress, wait for it before the canvas is freed
+    ulTaskNotifyTake(pdTRUE, 100);
+    xTaskNotifyGive(xTaskGetCurrentTaskHandle());
+  }
+  this->canvas = canvas;
+}
+
+void LittleVgl::FillRect(uint8_t x, lv_coord_t y, uint8_t width, lv_coord_t height, lv_color_t color, lv_color_t* line, size_t lineSize) {
+  // Like in FlushDisplay(), the previous transfer must be finished before the DataCommand pin is changed, and before the line
+  // it may still be reading is filled again
+  ulTaskNotifyTake(pdTRUE, 100);
+  if (line[0].full != color.full) {
+    std::fill(line, line + lineSize, color);
+  }
+
+  // A window can't wrap around the end of the display memory
+  const uint16_t y1 = (y + writeOffset) % totalNbLines;
+  const uint16_t firstHeight = std::min<uint16_t>(height, totalNbLines - y1);
+  FillWindow(x, y1, width, firstHeight, line, lineSize);
+  if (firstHeight < height) {
+    ulTaskNotifyTake(pdTRUE, 100);
+    FillWindow(x, 0, width, height - firstHeight, line, lineSize);
+  }
+}
+
+void LittleVgl::FillWindow(uint8_t x, uint16_t y, uint8_t width, uint16_t height, const lv_color_t* line, size_t lineSize) {
+  lcd.BeginDrawBuffer(x, y, width, height);
+  size_t remaining = width * height;
+  bool first = true;
+  while (remaining > 0) {
+    if (!first) {
+      ulTaskNotifyTake(pdTRUE, 100);
+    }
+    first = false;
+    const size_t count = std::min(remaining, lineSize);
+    lcd.ContinueDrawBuffer(reinterpret_cast<const uint8_t*>(line), count * sizeof(lv_color_t));
+    remaining -= count;
+  }
+}
+
 void LittleVgl::SetNewTouchPoint(int16_t x, int16_t y, bool contact) {
   if (contact) {
     if (!isCancelled) {
@@ -242,6 +375,9 @@ void LittleVgl::SetNewTouchPoint(int16_t x, int16_t y, bool contact) {
       tapped = true;
     }
   } else {
+    if (canvas != nullptr) {
+      canvas->EndStroke();
+    }
     if (isCancelled) {
       touchPoint = {-1, -1};
       tapped = false;
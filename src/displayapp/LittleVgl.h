@@ -1,7 +1,10 @@
 #pragma once
 
+#include <array>
 #include <lvgl/lvgl.h>
 #include <components/fs/FS.h>
+#include "displayapp/Canvas.h"
+#include "systemtask/BootProfile.h"
 
 namespace Pinetime {
   namespace Drivers {
@@ -9,7 +12,7 @@ namespace Pinetime {
   }
 
   namespace Components {
-    class LittleVgl {
+    class LittleVgl : public Canvas::Target {
     public:
       enum class FullRefreshDirections { None, Up, Down, Left, Right, LeftAnim, RightAnim };
       LittleVgl(Pinetime::Drivers::St7789& lcd, Pinetime::Controllers::FS& filesystem);
@@ -21,12 +24,50 @@ namespace Pinetime {
 
       void Init();
 
+      /**
+       * Runs the LVGL task handler
+       * @return the time (in ms) until a task needs to run again. Periodic display and touch polling is skipped
+       * while the screen is idle, so that only the refresh tasks of the current screen wake DisplayApp up.
+       */
+      uint32_t RunTasks();
+
       void FlushDisplay(const lv_area_t* area, lv_color_t* color_p);
       bool GetTouchPadInfo(lv_indev_data_t* ptr);
       void SetFullRefresh(FullRefreshDirections direction);
       void SetNewTouchPoint(int16_t x, int16_t y, bool contact);
       void CancelTap();
 
+      /**
+       * Attaches the canvas of the current screen (nullptr to detach it): its stamps are sent to the display at each RunTasks(),
+       * and its stroke ends when the finger is lifted. The canvas must have this object as its target.
+       */
+      void SetCanvas(Canvas* canvas);
+
+      /** Receives the rows of the active screen, from top to bottom, when it is rendered by Render() */
+      class RenderTarget {
+      public:
+        /** @return false to abort the rendering */
+        virtual bool WriteRow(const lv_color_t* pixels) = 0;
+
+      protected:
+        ~RenderTarget() = default;
+      };
+
+      /**
+       * Renders the active screen into target instead of the display.
+       * @return false if the screen could not be entirely written into target
+       */
+      bool Render(RenderTarget& target);
+
+      bool IsRendering() const {
+        return renderTarget != nullptr;
+      }
+
+      /** Records the clock face stage in profile once the next frame has entirely been sent to the display */
+      void MarkFirstFrame(System::BootProfile& profile) {
+        firstFrameProfile = &profile;
+      }
+
       bool GetFullRefresh() {
         bool returnValue = fullRefresh;
         if (fullRefresh) {
@@ -39,6 +80,11 @@ namespace Pinetime {
       void InitDisplay();
       void InitTouchpad();
       void InitFileSystem();
+      void ApplyScrollDirection();
+      void RenderArea(const lv_area_t* area, const lv_color_t* color_p);
+      void
+      FillRect(uint8_t x, lv_coord_t y, uint8_t width, lv_coord_t height, lv_color_t color, lv_color_t* line, size_t lineSize) override;
+      void FillWindow(uint8_t x, uint16_t y, uint8_t width, uint16_t height, const lv_color_t* line, size_t lineSize);
 
       Pinetime::Drivers::St7789& lcd;
       Pinetime::Controllers::FS& filesystem;
@@ -48,6 +94,11 @@ namespace Pinetime {
       lv_color_t buf2_2[LV_HOR_RES_MAX * 4];
 
       lv_disp_drv_t disp_drv;
+      lv_disp_t* display = nullptr;
+      lv_indev_t* touchpad = nullptr;
+
+      // Keep polling the touchpad for a while after the last interaction to process releases and drag throws
+      static constexpr uint32_t interactionGracePeriod = 1000;
 
       bool fullRefresh = false;
       static constexpr uint8_t nbWriteLines = 4;
@@ -62,6 +113,14 @@ namespace Pinetime {
       uint16_t writeOffset = 0;
       uint16_t scrollOffset = 0;
 
+      System::BootProfile* firstFrameProfile = nullptr;
+
+      RenderTarget* renderTarget = nullptr;
+      lv_coord_t renderNextLine = 0;
+      bool renderError = false;
+
+      Canvas* canvas = nullptr;
+
       lv_point_t touchPoint = {};
       bool tapped = false;
       bool isCancelled = false;
@@ -0,0 +1,190 @@
+#include "displayapp/LvglPool.h"
+#include <array>
+#include <FreeRTOS.h>
+
+using namespace Pinetime::Components;
+
+namespace {
+  constexpr size_t nbPages = LvglPool::poolSize / LvglPool::pageSize;
+  // Chosen to fit the common LVGL allocations (objects are ~70 bytes, styles and label texts are smaller)
+  constexpr std::array<uint16_t, LvglPool::nbSizeClasses> classSizes {16, 32, 48, 64, 80, 128, 256};
+  constexpr uint8_t noClass = 0xff;
+  constexpr uint8_t noBlock = 0xff;
+
+  struct Page {
+    uint8_t sizeClass = noClass;
+    uint8_t used = 0;
+    // Blocks that were freed, linked by their first byte
+    uint8_t freeHead = noBlock;
+    // Blocks after this one have never been allocated since the page was assigned to its class
+    uint8_t untouched = 0;
+  };
+
+  // Fallback allocations are prefixed with their size to keep track of the memory used in the heap
+  struct FallbackHeader {
+    size_t size;
+    size_t padding;
+  };
+
+  alignas(8) uint8_t pool[LvglPool::poolSize];
+  std::array<Page, nbPages> pages;
+
+  size_t used = 0;
+  size_t usedHighWater = 0;
+  size_t fallbackUsed = 0;
+  uint32_t fallbackCount = 0;
+  uint32_t failedCount = 0;
+  size_t screenBaseline = 0;
+  size_t screenHighWater = 0;
+  size_t screenBudget = 0;
+
+  uint8_t BlocksPerPage(uint8_t sizeClass) {
+    return LvglPool::pageSize / classSizes[sizeClass];
+  }
+
+  uint8_t SizeClass(size_t size) {
+    for (uint8_t i = 0; i < classSizes.size(); i++) {
+      if (size <= classSizes[i]) {
+        return i;
+      }
+    }
+    return noClass;
+  }
+
+  size_t ScreenUsed() {
+    const size_t total = used + fallbackUsed;
+    return total > screenBaseline ? total - screenBaseline : 0;
+  }
+
+  void Account() {
+    if (used > usedHighWater) {
+      usedHighWater = used;
+    }
+    const size_t screenUsed = ScreenUsed();
+    if (screenUsed > screenHighWater) {
+      screenHighWater = screenUsed;
+    }
+    configASSERT(screenBudget == 0 || screenUsed <= screenBudget);
+  }
+
+  void* AllocBlock(uint8_t sizeClass) {
+    Page* page = nullptr;
+    Page* freePage = nullptr;
+    for (auto& p : pages) {
+      if (p.sizeClass == sizeClass && p.used < BlocksPerPage(sizeClass)) {
+        page = &p;
+        break;
+      }
+      if (freePage == nullptr && p.sizeClass == noClass) {
+        freePage = &p;
+      }
+    }
+    if (page == nullptr) {
+      if (freePage == nullptr) {
+        return nullptr;
+      }
+      page = freePage;
+      page->sizeClass = sizeClass;
+      page->used = 0;
+      page->freeHead = noBlock;
+      page->untouched = 0;
+    }
+
+    uint8_t* pageStart = &pool[static_cast<size_t>(page - pages.data()) * LvglPool::pageSize];
+    uint8_t block;
+    if (page->freeHead != noBlock) {
+      block = page->freeHead;
+      page->freeHead = pageStart[block * classSizes[sizeClass]];
+    } else {
+      block = page->untouched++;
+    }
+    page->used++;
+    used += classSizes[sizeClass];
+    return &pageStart[block * classSizes[sizeClass]];
+  }
+}
+
+void* LvglPoolAlloc(size_t size) {
+  const uint8_t sizeClass = SizeClass(size);
+  if (sizeClass != noClass) {
+    void* ptr = AllocBlock(sizeClass);
+    if (ptr != nullptr) {
+      Account();
+      return ptr;
+    }
+  }
+
+  auto* header = static_cast<FallbackHeader*>(pvPortMalloc(sizeof(FallbackHeader) + size));
+  if (header == nullptr) {
+    failedCount++;
+    return nullptr;
+  }
+  header->size = size;
+  fallbackUsed += size;
+  fallbackCount++;
+  Account();
+  return header + 1;
+}
+
+void LvglPoolFree(void* ptr) {
+  if (ptr == nullptr) {
+    return;
+  }
+
+  auto* bytes = static_cast<uint8_t*>(ptr);
+  if (bytes < pool || bytes >= pool + LvglPool::poolSize) {
+    auto* header = static_cast<FallbackHeader*>(ptr) - 1;
+    fallbackUsed -= header->size;
+    vPortFree(header);
+    return;
+  }
+
+  const size_t offset = static_cast<size_t>(bytes - pool);
+  Page& page = pages[offset / LvglPool::pageSize];
+  const uint16_t blockSize = classSizes[page.sizeClass];
+  const uint8_t block = (offset % LvglPool::pageSize) / blockSize;
+
+  used -= blockSize;
+  page.used--;
+  if (page.used == 0) {
+    page.sizeClass = noClass;
+    return;
+  }
+  *bytes = page.freeHead;
+  page.freeHead = block;
+}
+
+void LvglPool::BeginScreen(size_t budget) {
+  screenBaseline = used + fallbackUsed;
+  screenHighWater = 0;
+  screenBudget = budget;
+}
+
+LvglPool::Stats LvglPool::GetStats() {
+  Stats stats {};
+  stats.used = used;
+  stats.usedHighWater = usedHighWater;
+  for (const auto& page : pages) {
+    if (page.sizeClass == noClass) {
+      stats.freeInPages += pageSize;
+    } else {
+      stats.free += (BlocksPerPage(page.sizeClass) - page.used) * classSizes[page.sizeClass];
+    }
+  }
+  stats.free += stats.freeInPages;
+  stats.fallbackUsed = fallbackUsed;
+  stats.fallbackCount = fallbackCount;
+  stats.failedCount = failedCount;
+  stats.screenUsed = ScreenUsed();
+  stats.screenHighWater = screenHighWater;
+  stats.screenBudget = screenBudget;
+  return stats;
+}
+
+uint8_t LvglPool::Fragmentation() {
+  const Stats stats = GetStats();
+  if (stats.free == 0) {
+    return 0;
+  }
+  return static_cast<uint8_t>(100 - (stats.freeInPages * 100) / stats.free);
+}
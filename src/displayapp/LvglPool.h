@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stddef.h>
+
+/*
+ * Size-class allocator used by LVGL (see LV_MEM_CUSTOM_ALLOC in lv_conf.h).
+ *
+ * LVGL objects, styles and strings are allocated from a dedicated pool split in pages of 256 bytes. Each page holds blocks
+ * of a single size class and goes back to the free pages as soon as all its blocks are freed, so that LVGL doesn't fragment
+ * the FreeRTOS heap anymore. Allocations that don't fit in the pool fall back to the FreeRTOS heap.
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+void* LvglPoolAlloc(size_t size);
+void LvglPoolFree(void* ptr);
+
+#ifdef __cplusplus
+}
+
+  #include <cstdint>
+
+namespace Pinetime {
+  namespace Components {
+    namespace LvglPool {
+      constexpr size_t poolSize = 12 * 1024;
+      constexpr size_t pageSize = 256;
+      constexpr size_t nbSizeClasses = 7;
+      // A screen can use up to this many bytes without any fallback to the FreeRTOS heap, if it starts with an empty pool:
+      // each size class may leave one page partially used
+      constexpr size_t maxScreenBudget = poolSize - nbSizeClasses * pageSize;
+
+      struct Stats {
+        // Bytes of the blocks currently allocated in the pool
+        size_t used;
+        size_t usedHighWater;
+        // Free bytes in the pool, and the part of them that is in completely free pages
+        size_t free;
+        size_t freeInPages;
+        // Allocations that didn't fit in the pool and were made in the FreeRTOS heap
+        size_t fallbackUsed;
+        uint32_t fallbackCount;
+        uint32_t failedCount;
+        // Memory used by the current screen since BeginScreen(), and its high-water mark
+        size_t screenUsed;
+        size_t screenHighWater;
+        size_t screenBudget;
+      };
+
+      /** Starts the accounting of a new screen. In debug builds, the allocations that exceed the budget trigger an assert. */
+      void BeginScreen(size_t budget);
+
+      Stats GetStats();
+
+      /** @return the fragmentation of the free memory of the pool, in percent (0 when all the free memory is in free pages) */
+      uint8_t Fragmentation();
+    }
+  }
+}
+#endif
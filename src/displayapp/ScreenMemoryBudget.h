@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include "displayapp/apps/Apps.h"
+#include "displayapp/LvglPool.h"
+
+namespace Pinetime {
+  namespace Applications {
+    /**
+     * Memory that the LVGL objects of a screen may allocate, checked by LvglPool in debug builds (see LvglPool::BeginScreen()).
+     *
+     * Every budget fits in an empty LVGL pool: DisplayApp drops the screens kept warm when the pool has less free memory
+     * than the budget of the next screen. The budgets are estimates, to be tuned with the high-water marks logged when a
+     * screen is closed.
+     */
+    constexpr size_t ScreenMemoryBudget(Apps app) {
+      switch (app) {
+        case Apps::Launcher:
+        case Apps::Notifications:
+        case Apps::NotificationsPreview:
+        case Apps::Paint:
+        case Apps::Twos:
+          return 10 * 1024;
+        default:
+          return 8 * 1024;
+      }
+    }
+
+    // Weather is the last app of the enum
+    constexpr bool AllScreenBudgetsFitInPool() {
+      for (uint8_t app = 0; app <= static_cast<uint8_t>(Apps::Weather); app++) {
+        if (ScreenMemoryBudget(static_cast<Apps>(app)) > Components::LvglPool::maxScreenBudget) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    static_assert(AllScreenBudgetsFitInPool(), "The budget of a screen must fit in the LVGL pool");
+  }
+}
@@ -42,6 +42,16 @@ bool ApplicationList::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
   return screens.OnTouchEvent(event);
 }
 
+void ApplicationList::Suspend() {
+  Screen::Suspend();
+  screens.Suspend();
+}
+
+void ApplicationList::Resume() {
+  Screen::Resume();
+  screens.Resume();
+}
+
 std::unique_ptr<Screen> ApplicationList::CreateScreen(unsigned int screenNum) const {
   std::array<Tile::Applications, appsPerScreen> pageApps;
 
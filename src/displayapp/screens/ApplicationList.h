@@ -23,6 +23,8 @@ namespace Pinetime {
                                  std::array<Tile::Applications, UserAppTypes::Count>&& apps);
         ~ApplicationList() override;
         bool OnTouchEvent(TouchEvents event) override;
+        void Suspend() override;
+        void Resume() override;
 
       private:
         DisplayApp* app;
@@ -36,7 +36,6 @@ namespace Pinetime {
 
         void UpdateError();
 
-        lv_task_t* taskRefresh;
         TickType_t startTime;
       };
     }
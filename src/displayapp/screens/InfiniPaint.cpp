@@ -3,16 +3,15 @@
 #include "displayapp/LittleVgl.h"
 #include "displayapp/InfiniTimeTheme.h"
 
-#include <algorithm> // std::fill
-
 using namespace Pinetime::Applications::Screens;
 
 InfiniPaint::InfiniPaint(Pinetime::Components::LittleVgl& lvgl, Pinetime::Controllers::MotorController& motor)
-  : lvgl {lvgl}, motor {motor} {
-  std::fill(b, b + bufferSize, selectColor);
+  : lvgl {lvgl}, motor {motor}, canvas {lvgl} {
+  lvgl.SetCanvas(&canvas);
 }
 
 InfiniPaint::~InfiniPaint() {
+  lvgl.SetCanvas(nullptr);
   lv_obj_clean(lv_scr_act());
 }
 
@@ -51,7 +50,6 @@ bool InfiniPaint::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
           break;
       }
 
-      std::fill(b, b + bufferSize, selectColor);
       motor.RunForDuration(35);
       return true;
     default:
@@ -61,12 +59,6 @@ bool InfiniPaint::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
 }
 
 bool InfiniPaint::OnTouchEvent(uint16_t x, uint16_t y) {
-  lv_area_t area;
-  area.x1 = x - (width / 2);
-  area.y1 = y - (height / 2);
-  area.x2 = x + (width / 2) - 1;
-  area.y2 = y + (height / 2) - 1;
-  lvgl.SetFullRefresh(Components::LittleVgl::FullRefreshDirections::None);
-  lvgl.FlushDisplay(&area, b);
+  canvas.Stroke(x, y, brushSize, selectColor);
   return true;
 }
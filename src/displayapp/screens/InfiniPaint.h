@@ -2,8 +2,8 @@
 
 #include <lvgl/lvgl.h>
 #include <cstdint>
-#include <algorithm> // std::fill
 #include "displayapp/screens/Screen.h"
+#include "displayapp/Canvas.h"
 #include "components/motor/MotorController.h"
 #include "Symbols.h"
 #include "displayapp/apps/Apps.h"
@@ -30,10 +30,8 @@ namespace Pinetime {
       private:
         Pinetime::Components::LittleVgl& lvgl;
         Controllers::MotorController& motor;
-        static constexpr uint16_t width = 10;
-        static constexpr uint16_t height = 10;
-        static constexpr uint16_t bufferSize = width * height;
-        lv_color_t b[bufferSize];
+        Components::Canvas canvas;
+        static constexpr uint8_t brushSize = 10;
         lv_color_t selectColor = LV_COLOR_WHITE;
         uint8_t color = 2;
       };
@@ -83,9 +83,9 @@ void Metronome::Refresh() {
       counter--;
       if (counter == 0) {
         counter = bpb;
-        motorController.RunForDuration(90);
+        motorController.Play(Controllers::MotorController::Patterns::MetronomeBar);
       } else {
-        motorController.RunForDuration(30);
+        motorController.Play(Controllers::MotorController::Patterns::MetronomeBeat);
       }
     }
   }
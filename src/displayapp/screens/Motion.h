@@ -29,7 +29,6 @@ namespace Pinetime {
         lv_obj_t* label;
 
         lv_obj_t* labelStep;
-        lv_task_t* taskRefresh;
       };
     }
 
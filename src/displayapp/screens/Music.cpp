@@ -140,7 +140,7 @@ Music::Music(Pinetime::Controllers::MusicService& music) : musicService(music) {
 
   musicService.event(Controllers::MusicService::EVENT_MUSIC_OPEN);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriod::Second, LV_TASK_PRIO_MID, this);
 }
 
 Music::~Music() {
@@ -150,18 +150,10 @@ Music::~Music() {
 }
 
 void Music::Refresh() {
-  if (artist != musicService.getArtist()) {
-    artist = musicService.getArtist();
-    lv_label_set_text(txtArtist, artist.data());
-  }
-
-  if (track != musicService.getTrack()) {
-    track = musicService.getTrack();
-    lv_label_set_text(txtTrack, track.data());
-  }
-
-  if (album != musicService.getAlbum()) {
-    album = musicService.getAlbum();
+  if (textRevision != musicService.TextRevision()) {
+    textRevision = musicService.TextRevision();
+    lv_label_set_text(txtArtist, musicService.getArtist().data());
+    lv_label_set_text(txtTrack, musicService.getTrack().data());
   }
 
   if (playing != musicService.isPlaying()) {
@@ -180,7 +172,7 @@ void Music::Refresh() {
 
   if (playing) {
     lv_label_set_text_static(txtPlayPause, Symbols::pause);
-    if (xTaskGetTickCount() - 1024 >= lastIncrement) {
+    if (xTaskGetTickCount() - lastIncrement >= pdMS_TO_TICKS(RefreshPeriod::Second)) {
 
       if (frameB) {
         lv_img_set_src(imgDiscAnim, &disc_f_1);
@@ -19,7 +19,6 @@
 
 #include <FreeRTOS.h>
 #include <lvgl/src/lv_core/lv_obj.h>
-#include <string>
 #include "displayapp/screens/Screen.h"
 #include "displayapp/apps/Apps.h"
 #include "displayapp/Controllers.h"
@@ -67,9 +66,8 @@ namespace Pinetime {
 
         Pinetime::Controllers::MusicService& musicService;
 
-        std::string artist;
-        std::string album;
-        std::string track;
+        /** Revision of the texts of the music service displayed by the labels */
+        uint32_t textRevision = 0;
 
         /** Total length in seconds */
         int totalLength = 0;
@@ -80,8 +78,6 @@ namespace Pinetime {
 
         bool playing;
 
-        lv_task_t* taskRefresh;
-
         /** Watchapp */
       };
     }
@@ -176,7 +176,7 @@ namespace {
     return {iconsFile1, static_cast<int16_t>(iconHeight * (index - maxIconsPerFile))};
   }
 
-  Icon GetIcon(const std::string& icon) {
+  Icon GetIcon(std::string_view icon) {
     for (const auto& iter : iconMap) {
       if (iter.first == icon) {
         return GetIcon(iter.second);
@@ -238,23 +238,16 @@ Navigation::~Navigation() {
 }
 
 void Navigation::Refresh() {
-  if (flag != navService.getFlag()) {
-    flag = navService.getFlag();
-    const auto& image = GetIcon(flag);
+  if (textRevision != navService.TextRevision()) {
+    textRevision = navService.TextRevision();
+    const auto& image = GetIcon(navService.getFlag());
     lv_img_set_src(imgFlag, image.fileName);
     lv_obj_set_style_local_image_recolor_opa(imgFlag, LV_IMG_PART_MAIN, LV_STATE_DEFAULT, LV_OPA_COVER);
     lv_obj_set_style_local_image_recolor(imgFlag, LV_IMG_PART_MAIN, LV_STATE_DEFAULT, LV_COLOR_CYAN);
     lv_img_set_offset_y(imgFlag, image.offset);
-  }
-
-  if (narrative != navService.getNarrative()) {
-    narrative = navService.getNarrative();
-    lv_label_set_text(txtNarrative, narrative.data());
-  }
 
-  if (manDist != navService.getManDist()) {
-    manDist = navService.getManDist();
-    lv_label_set_text(txtManDist, manDist.data());
+    lv_label_set_text(txtNarrative, navService.getNarrative().data());
+    lv_label_set_text(txtManDist, navService.getManDist().data());
   }
 
   if (progress != navService.getProgress()) {
@@ -19,7 +19,6 @@
 
 #include <FreeRTOS.h>
 #include <lvgl/src/lv_core/lv_obj.h>
-#include <string>
 #include "displayapp/screens/Screen.h"
 #include <array>
 #include "displayapp/apps/Apps.h"
@@ -50,12 +49,9 @@ namespace Pinetime {
 
         Pinetime::Controllers::NavigationService& navService;
 
-        std::string flag;
-        std::string narrative;
-        std::string manDist;
+        /** Revision of the texts of the navigation service displayed by the screen */
+        uint32_t textRevision = 0;
         int progress = 0;
-
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -10,6 +10,31 @@ using namespace Pinetime::Applications::Screens;
 extern lv_font_t jetbrains_mono_extrabold_compressed;
 extern lv_font_t jetbrains_mono_bold_20;
 
+namespace {
+  using Categories = Pinetime::Controllers::NotificationManager::Categories;
+  using Patterns = Pinetime::Controllers::MotorController::Patterns;
+
+  Patterns VibrationPattern(Categories category) {
+    switch (category) {
+      case Categories::IncomingCall:
+        return Patterns::Ring;
+      case Categories::Sms:
+      case Categories::InstantMessage:
+        return Patterns::Message;
+      case Categories::Email:
+      case Categories::News:
+        return Patterns::Email;
+      case Categories::MissedCall:
+      case Categories::VoiceMail:
+      case Categories::Schedule:
+      case Categories::HighProriotyAlert:
+        return Patterns::Alert;
+      default:
+        return Patterns::Click;
+    }
+  }
+}
+
 Notifications::Notifications(DisplayApp* app,
                              Pinetime::Controllers::NotificationManager& notificationManager,
                              Pinetime::Controllers::AlertNotificationService& alertNotificationService,
@@ -41,11 +66,7 @@ Notifications::Notifications(DisplayApp* app,
   }
   if (mode == Modes::Preview) {
     systemTask.PushMessage(System::Messages::DisableSleeping);
-    if (notification.category == Controllers::NotificationManager::Categories::IncomingCall) {
-      motorController.StartRinging();
-    } else {
-      motorController.RunForDuration(35);
-    }
+    motorController.Play(VibrationPattern(notification.category));
 
     timeoutLine = lv_line_create(lv_scr_act(), nullptr);
 
@@ -104,7 +125,7 @@ void Notifications::Refresh() {
     }
 
     if (validDisplay) {
-      Controllers::NotificationManager::Notification::Idx currentIdx = notificationManager.IndexOf(currentId);
+      Controllers::NotificationManager::Idx currentIdx = notificationManager.IndexOf(currentId);
       currentItem = std::make_unique<NotificationItem>(notification.Title(),
                                                        notification.Message(),
                                                        currentIdx + 1,
@@ -180,7 +201,7 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
       }
       return false;
     case Pinetime::Applications::TouchEvents::SwipeDown: {
-      Controllers::NotificationManager::Notification previousNotification;
+      Controllers::NotificationManager::NotificationView previousNotification;
       if (validDisplay) {
         previousNotification = notificationManager.GetPrevious(currentId);
       } else {
@@ -192,7 +213,7 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
       }
 
       currentId = previousNotification.id;
-      Controllers::NotificationManager::Notification::Idx currentIdx = notificationManager.IndexOf(currentId);
+      Controllers::NotificationManager::Idx currentIdx = notificationManager.IndexOf(currentId);
       validDisplay = true;
       currentItem.reset(nullptr);
       app->SetFullRefresh(DisplayApp::FullRefreshDirections::Down);
@@ -206,7 +227,7 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
     }
       return true;
     case Pinetime::Applications::TouchEvents::SwipeUp: {
-      Controllers::NotificationManager::Notification nextNotification;
+      Controllers::NotificationManager::NotificationView nextNotification;
       if (validDisplay) {
         nextNotification = notificationManager.GetNext(currentId);
       } else {
@@ -219,7 +240,7 @@ bool Notifications::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
       }
 
       currentId = nextNotification.id;
-      Controllers::NotificationManager::Notification::Idx currentIdx = notificationManager.IndexOf(currentId);
+      Controllers::NotificationManager::Idx currentIdx = notificationManager.IndexOf(currentId);
       validDisplay = true;
       currentItem.reset(nullptr);
       app->SetFullRefresh(DisplayApp::FullRefreshDirections::Up);
@@ -257,9 +278,9 @@ Notifications::NotificationItem::NotificationItem(Pinetime::Controllers::AlertNo
 
 Notifications::NotificationItem::NotificationItem(const char* title,
                                                   const char* msg,
-                                                  uint8_t notifNr,
+                                                  uint16_t notifNr,
                                                   Controllers::NotificationManager::Categories category,
-                                                  uint8_t notifNb,
+                                                  uint16_t notifNb,
                                                   Pinetime::Controllers::AlertNotificationService& alertNotificationService,
                                                   Pinetime::Controllers::MotorController& motorController)
   : alertNotificationService {alertNotificationService}, motorController {motorController} {
@@ -40,9 +40,9 @@ namespace Pinetime {
                            Pinetime::Controllers::MotorController& motorController);
           NotificationItem(const char* title,
                            const char* msg,
-                           uint8_t notifNr,
+                           uint16_t notifNr,
                            Controllers::NotificationManager::Categories,
-                           uint8_t notifNb,
+                           uint16_t notifNb,
                            Pinetime::Controllers::AlertNotificationService& alertNotificationService,
                            Pinetime::Controllers::MotorController& motorController);
           ~NotificationItem();
@@ -76,7 +76,7 @@ namespace Pinetime {
         System::SystemTask& systemTask;
         Modes mode = Modes::Normal;
         std::unique_ptr<NotificationItem> currentItem;
-        Pinetime::Controllers::NotificationManager::Notification::Id currentId;
+        Pinetime::Controllers::NotificationManager::Id currentId;
         bool validDisplay = false;
         bool afterDismissNextMessageFromAbove = false;
 
@@ -88,8 +88,6 @@ namespace Pinetime {
         bool interacted = true;
 
         bool dismissingNotification = false;
-
-        lv_task_t* taskRefresh;
       };
     }
   }
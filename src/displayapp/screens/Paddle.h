@@ -44,8 +44,6 @@ namespace Pinetime {
         lv_obj_t* paddle;
         lv_obj_t* ball;
         lv_obj_t* background;
-
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -4,3 +4,22 @@ using namespace Pinetime::Applications::Screens;
 void Screen::RefreshTaskCallback(lv_task_t* task) {
   static_cast<Screen*>(task->user_data)->Refresh();
 }
+
+void Screen::RequestRefresh() {
+  if (taskRefresh != nullptr) {
+    lv_task_ready(taskRefresh);
+  }
+}
+
+void Screen::Suspend() {
+  if (taskRefresh != nullptr) {
+    lv_task_set_prio(taskRefresh, LV_TASK_PRIO_OFF);
+  }
+}
+
+void Screen::Resume() {
+  if (taskRefresh != nullptr) {
+    lv_task_set_prio(taskRefresh, LV_TASK_PRIO_MID);
+    lv_task_ready(taskRefresh);
+  }
+}
@@ -9,6 +9,16 @@ namespace Pinetime {
     class DisplayApp;
 
     namespace Screens {
+      /** Periods (in ms) for the refresh task of a screen */
+      namespace RefreshPeriod {
+        /** Animated content, refreshed at the display frame rate */
+        constexpr uint32_t Frame = LV_DISP_DEF_REFR_PERIOD;
+        /** Content that changes at most once per second */
+        constexpr uint32_t Second = 1000;
+        /** Content that follows the clock: refreshed by OnTimeChanged(), the task only polls as a fallback */
+        constexpr uint32_t TimeChange = 5000;
+      }
+
       class Screen {
       private:
         virtual void Refresh() {
@@ -21,6 +31,25 @@ namespace Pinetime {
 
         static void RefreshTaskCallback(lv_task_t* task);
 
+        /** Runs the refresh task on the next LVGL pass instead of waiting for its period */
+        void RequestRefresh();
+
+        /** Called by DisplayApp when the time displayed by the clock has changed */
+        void OnTimeChanged() {
+          if (refreshOnTimeChange) {
+            RequestRefresh();
+          }
+        }
+
+        /**
+         * Called when the screen is kept alive in the background by DisplayApp: stops the refresh task.
+         * Screens that run other tasks, or that contain other screens, must stop them too.
+         */
+        virtual void Suspend();
+
+        /** Called when a suspended screen is displayed again: restarts the refresh task and refreshes it right away */
+        virtual void Resume();
+
         bool IsRunning() const {
           return running;
         }
@@ -42,6 +71,10 @@ namespace Pinetime {
 
       protected:
         bool running = true;
+
+        lv_task_t* taskRefresh = nullptr;
+        // Set by screens that only need a refresh when the time changes (see RefreshPeriod::TimeChange)
+        bool refreshOnTimeChange = false;
       };
     }
   }
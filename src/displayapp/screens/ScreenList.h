@@ -36,6 +36,16 @@ namespace Pinetime {
           lv_obj_clean(lv_scr_act());
         }
 
+        void Suspend() override {
+          Screen::Suspend();
+          current->Suspend();
+        }
+
+        void Resume() override {
+          Screen::Resume();
+          current->Resume();
+        }
+
         bool OnTouchEvent(TouchEvents event) override {
 
           if (mode == ScreenListModes::UpDown) {
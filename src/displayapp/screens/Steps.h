@@ -38,8 +38,6 @@ namespace Pinetime {
         lv_obj_t* tripLabel;
 
         uint32_t stepsCount;
-
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -55,8 +55,6 @@ namespace Pinetime {
         lv_obj_t *time, *msecTime, *btnPlayPause, *btnStopLap, *txtPlayPause, *txtStopLap;
         lv_obj_t* lapText;
         bool isHoursLabelUpdated = false;
-
-        lv_task_t* taskRefresh;
       };
     }
 
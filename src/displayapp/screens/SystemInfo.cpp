@@ -4,6 +4,7 @@
 #include "displayapp/screens/SystemInfo.h"
 #include <lvgl/lvgl.h>
 #include "displayapp/DisplayApp.h"
+#include "displayapp/LvglPool.h"
 #include "displayapp/screens/Label.h"
 #include "Version.h"
 #include "BootloaderVersion.h"
@@ -13,6 +14,8 @@
 #include "components/datetime/DateTimeController.h"
 #include "components/motion/MotionController.h"
 #include "drivers/Watchdog.h"
+#include "systemtask/SystemMonitor.h"
+#include "systemtask/BootProfile.h"
 #include "displayapp/InfiniTimeTheme.h"
 
 using namespace Pinetime::Applications::Screens;
@@ -38,7 +41,9 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
                        const Pinetime::Controllers::Ble& bleController,
                        const Pinetime::Drivers::Watchdog& watchdog,
                        Pinetime::Controllers::MotionController& motionController,
-                       const Pinetime::Drivers::Cst816S& touchPanel)
+                       const Pinetime::Drivers::Cst816S& touchPanel,
+                       const Pinetime::System::SystemMonitor& monitor,
+                       const Pinetime::System::BootProfile& bootProfile)
   : app {app},
     dateTimeController {dateTimeController},
     batteryController {batteryController},
@@ -47,6 +52,8 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
     watchdog {watchdog},
     motionController {motionController},
     touchPanel {touchPanel},
+    monitor {monitor},
+    bootProfile {bootProfile},
     screens {app,
              0,
              {[this]() -> std::unique_ptr<Screen> {
@@ -63,6 +70,12 @@ SystemInfo::SystemInfo(Pinetime::Applications::DisplayApp* app,
               },
               [this]() -> std::unique_ptr<Screen> {
                 return CreateScreen5();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen6();
+              },
+              [this]() -> std::unique_ptr<Screen> {
+                return CreateScreen7();
               }},
              Screens::ScreenListModes::UpDown} {
 }
@@ -75,6 +88,16 @@ bool SystemInfo::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
   return screens.OnTouchEvent(event);
 }
 
+void SystemInfo::Suspend() {
+  Screen::Suspend();
+  screens.Suspend();
+}
+
+void SystemInfo::Resume() {
+  Screen::Resume();
+  screens.Resume();
+}
+
 std::unique_ptr<Screen> SystemInfo::CreateScreen1() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
@@ -95,7 +118,7 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen1() {
                         BootloaderVersion::VersionString());
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(0, 5, label);
+  return std::make_unique<Screens::Label>(0, 7, label);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
@@ -174,14 +197,13 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen2() {
                         touchPanel.GetFwVersion(),
                         TARGET_DEVICE_NAME);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(1, 5, label);
+  return std::make_unique<Screens::Label>(1, 7, label);
 }
 
 extern int mallocFailedCount;
 extern int stackOverflowCount;
 std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
-  lv_mem_monitor_t mon;
-  lv_mem_monitor(&mon);
+  const auto poolStats = Components::LvglPool::GetStats();
 
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
@@ -190,12 +212,13 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         "#808080 BLE MAC#\n"
                         " %02x:%02x:%02x:%02x:%02x:%02x"
                         "\n"
-                        "\n"
                         "#808080 Memory heap#\n"
                         " #808080 Free# %d\n"
                         " #808080 Min free# %d\n"
                         " #808080 Alloc err# %d\n"
-                        " #808080 Ovrfl err# %d\n",
+                        " #808080 Ovrfl err# %d\n"
+                        "#808080 LVGL pool#\n"
+                        " %d/%d #808080 frag# %d%%\n",
                         bleAddr[5],
                         bleAddr[4],
                         bleAddr[3],
@@ -205,9 +228,12 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen3() {
                         xPortGetFreeHeapSize(),
                         xPortGetMinimumEverFreeHeapSize(),
                         mallocFailedCount,
-                        stackOverflowCount);
+                        stackOverflowCount,
+                        static_cast<int>(poolStats.used),
+                        static_cast<int>(Components::LvglPool::poolSize),
+                        Components::LvglPool::Fragmentation());
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(2, 5, label);
+  return std::make_unique<Screens::Label>(2, 7, label);
 }
 
 bool SystemInfo::sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs) {
@@ -268,10 +294,67 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen4() {
     }
     lv_table_set_cell_value(infoTask, i + 1, 3, buffer);
   }
-  return std::make_unique<Screens::Label>(3, 5, infoTask);
+  return std::make_unique<Screens::Label>(3, 7, infoTask);
 }
 
 std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
+  std::array<System::SystemMonitor::TaskLoad, System::SystemMonitor::maxTasks> loads;
+  const uint8_t nb = monitor.GetTaskLoads(loads);
+
+  lv_obj_t* infoTask = lv_table_create(lv_scr_act(), nullptr);
+  lv_table_set_col_cnt(infoTask, 3);
+  lv_table_set_row_cnt(infoTask, nb + 1);
+  lv_obj_set_style_local_pad_all(infoTask, LV_TABLE_PART_CELL1, LV_STATE_DEFAULT, 0);
+  lv_obj_set_style_local_border_color(infoTask, LV_TABLE_PART_CELL1, LV_STATE_DEFAULT, Colors::lightGray);
+
+  lv_table_set_cell_value(infoTask, 0, 0, "#");
+  lv_table_set_col_width(infoTask, 0, 30);
+  lv_table_set_cell_value(infoTask, 0, 1, "Task");
+  lv_table_set_col_width(infoTask, 1, 80);
+  lv_table_set_cell_value(infoTask, 0, 2, "CPU");
+  lv_table_set_col_width(infoTask, 2, 120);
+
+  for (uint8_t i = 0; i < nb; i++) {
+    char buffer[11] = {0};
+
+    snprintf(buffer, sizeof(buffer), "%d", loads[i].number);
+    lv_table_set_cell_value(infoTask, i + 1, 0, buffer);
+    lv_table_set_cell_value(infoTask, i + 1, 1, loads[i].name);
+    snprintf(buffer, sizeof(buffer), "%d.%d%%", loads[i].load / 10, loads[i].load % 10);
+    lv_table_set_cell_value(infoTask, i + 1, 2, buffer);
+  }
+  return std::make_unique<Screens::Label>(4, 7, infoTask);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen6() {
+  lv_obj_t* infoBoot = lv_table_create(lv_scr_act(), nullptr);
+  lv_table_set_col_cnt(infoBoot, 3);
+  lv_table_set_row_cnt(infoBoot, System::BootProfile::nbStages + 1);
+  lv_obj_set_style_local_pad_all(infoBoot, LV_TABLE_PART_CELL1, LV_STATE_DEFAULT, 0);
+  lv_obj_set_style_local_border_color(infoBoot, LV_TABLE_PART_CELL1, LV_STATE_DEFAULT, Colors::lightGray);
+
+  lv_table_set_cell_value(infoBoot, 0, 0, "Boot");
+  lv_table_set_col_width(infoBoot, 0, 90);
+  lv_table_set_cell_value(infoBoot, 0, 1, "Start");
+  lv_table_set_col_width(infoBoot, 1, 70);
+  lv_table_set_cell_value(infoBoot, 0, 2, "ms");
+  lv_table_set_col_width(infoBoot, 2, 70);
+
+  for (uint8_t i = 0; i < System::BootProfile::nbStages; i++) {
+    const auto stage = static_cast<System::BootProfile::Stages>(i);
+    const System::BootProfile::Stage times = bootProfile.Get(stage);
+    char buffer[11] = {0};
+
+    lv_table_set_cell_value(infoBoot, i + 1, 0, System::BootProfile::Name(stage));
+    snprintf(buffer, sizeof(buffer), "%lu", times.start);
+    lv_table_set_cell_value(infoBoot, i + 1, 1, buffer);
+    snprintf(buffer, sizeof(buffer), "%lu", times.end - times.start);
+    lv_table_set_cell_value(infoBoot, i + 1, 2, buffer);
+  }
+  return std::make_unique<Screens::Label>(5, 7, infoBoot);
+}
+
+std::unique_ptr<Screen> SystemInfo::CreateScreen7() {
   lv_obj_t* label = lv_label_create(lv_scr_act(), nullptr);
   lv_label_set_recolor(label, true);
   lv_label_set_text_static(label,
@@ -285,5 +368,5 @@ std::unique_ptr<Screen> SystemInfo::CreateScreen5() {
                            "#FFFF00 InfiniTime#");
   lv_label_set_align(label, LV_LABEL_ALIGN_CENTER);
   lv_obj_align(label, lv_scr_act(), LV_ALIGN_CENTER, 0, 0);
-  return std::make_unique<Screens::Label>(4, 5, label);
+  return std::make_unique<Screens::Label>(6, 7, label);
 }
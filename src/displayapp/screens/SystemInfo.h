@@ -16,6 +16,11 @@ namespace Pinetime {
     class Watchdog;
   }
 
+  namespace System {
+    class SystemMonitor;
+    class BootProfile;
+  }
+
   namespace Applications {
     class DisplayApp;
 
@@ -29,9 +34,13 @@ namespace Pinetime {
                             const Pinetime::Controllers::Ble& bleController,
                             const Pinetime::Drivers::Watchdog& watchdog,
                             Pinetime::Controllers::MotionController& motionController,
-                            const Pinetime::Drivers::Cst816S& touchPanel);
+                            const Pinetime::Drivers::Cst816S& touchPanel,
+                            const Pinetime::System::SystemMonitor& monitor,
+                            const Pinetime::System::BootProfile& bootProfile);
         ~SystemInfo() override;
         bool OnTouchEvent(TouchEvents event) override;
+        void Suspend() override;
+        void Resume() override;
 
       private:
         DisplayApp* app;
@@ -42,8 +51,10 @@ namespace Pinetime {
         const Pinetime::Drivers::Watchdog& watchdog;
         Pinetime::Controllers::MotionController& motionController;
         const Pinetime::Drivers::Cst816S& touchPanel;
+        const Pinetime::System::SystemMonitor& monitor;
+        const Pinetime::System::BootProfile& bootProfile;
 
-        ScreenList<5> screens;
+        ScreenList<7> screens;
 
         static bool sortById(const TaskStatus_t& lhs, const TaskStatus_t& rhs);
 
@@ -52,6 +63,8 @@ namespace Pinetime {
         std::unique_ptr<Screen> CreateScreen3();
         std::unique_ptr<Screen> CreateScreen4();
         std::unique_ptr<Screen> CreateScreen5();
+        std::unique_ptr<Screen> CreateScreen6();
+        std::unique_ptr<Screen> CreateScreen7();
       };
     }
   }
@@ -93,6 +93,17 @@ Tile::~Tile() {
   lv_obj_clean(lv_scr_act());
 }
 
+void Tile::Suspend() {
+  Screen::Suspend();
+  lv_task_set_prio(taskUpdate, LV_TASK_PRIO_OFF);
+}
+
+void Tile::Resume() {
+  Screen::Resume();
+  lv_task_set_prio(taskUpdate, LV_TASK_PRIO_MID);
+  lv_task_ready(taskUpdate);
+}
+
 void Tile::UpdateScreen() {
   lv_label_set_text(label_time, dateTimeController.FormattedTime().c_str());
   statusIcons.Update();
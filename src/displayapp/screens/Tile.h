@@ -33,6 +33,9 @@ namespace Pinetime {
 
         ~Tile() override;
 
+        void Suspend() override;
+        void Resume() override;
+
         void UpdateScreen();
         void OnValueChangedEvent(lv_obj_t* obj, uint32_t buttonId);
 
@@ -36,7 +36,6 @@ namespace Pinetime::Applications {
       lv_objmask_mask_t* btnMask;
       lv_objmask_mask_t* highlightMask;
 
-      lv_task_t* taskRefresh;
       Widgets::Counter minuteCounter = Widgets::Counter(0, 59, jetbrains_mono_76);
       Widgets::Counter secondCounter = Widgets::Counter(0, 59, jetbrains_mono_76);
 
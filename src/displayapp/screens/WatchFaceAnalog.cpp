@@ -1,5 +1,6 @@
 #include "displayapp/screens/WatchFaceAnalog.h"
-#include <cmath>
+#include <algorithm>
+#include <array>
 #include <lvgl/lvgl.h>
 #include "displayapp/screens/BatteryIcon.h"
 #include "displayapp/screens/BleIcon.h"
@@ -15,30 +16,70 @@ namespace {
   constexpr int16_t MinuteLength = 90;
   constexpr int16_t SecondLength = 110;
 
-  // sin(90) = 1 so the value of _lv_trigo_sin(90) is the scaling factor
-  const auto LV_TRIG_SCALE = _lv_trigo_sin(90);
+  constexpr double center = LV_HOR_RES_MAX / 2;
 
-  int16_t Cosine(int16_t angle) {
-    return _lv_trigo_sin(angle + 90);
-  }
-
-  int16_t Sine(int16_t angle) {
-    return _lv_trigo_sin(angle);
-  }
-
-  int16_t CoordinateXRelocate(int16_t x) {
-    return (x + LV_HOR_RES / 2);
+  // Sine of an angle in degrees, only evaluated at compile time
+  constexpr double Sine(double angle) {
+    while (angle >= 180) {
+      angle -= 360;
+    }
+    if (angle > 90) {
+      angle = 180 - angle;
+    } else if (angle < -90) {
+      angle = -180 - angle;
+    }
+    const double x = angle * 3.14159265358979323846 / 180;
+    double term = x;
+    double sum = x;
+    for (int n = 1; n < 10; n++) {
+      term *= -x * x / ((2 * n) * (2 * n + 1));
+      sum += term;
+    }
+    return sum;
   }
 
-  int16_t CoordinateYRelocate(int16_t y) {
-    return std::abs(y - LV_HOR_RES / 2);
+  // Screen coordinates of a point of a hand, they all fit in a byte
+  struct HandPoint {
+    uint8_t x;
+    uint8_t y;
+  };
+
+  // Points of a hand at the given distances from the center (negative beyond the center), for each of its positions
+  template <size_t nbPositions, size_t nbPoints>
+  constexpr std::array<std::array<HandPoint, nbPoints>, nbPositions> Hand(const std::array<int16_t, nbPoints>& radii) {
+    std::array<std::array<HandPoint, nbPoints>, nbPositions> hand {};
+    for (size_t position = 0; position < nbPositions; position++) {
+      const double angle = 360.0 * position / nbPositions;
+      for (size_t i = 0; i < nbPoints; i++) {
+        hand[position][i] = {static_cast<uint8_t>(center + radii[i] * Sine(angle) + 0.5),
+                             static_cast<uint8_t>(center - radii[i] * Sine(angle + 90) + 0.5)};
+      }
+    }
+    return hand;
   }
 
-  lv_point_t CoordinateRelocate(int16_t radius, int16_t angle) {
-    return lv_point_t {.x = CoordinateXRelocate(radius * static_cast<int32_t>(Sine(angle)) / LV_TRIG_SCALE),
-                       .y = CoordinateYRelocate(radius * static_cast<int32_t>(Cosine(angle)) / LV_TRIG_SCALE)};
+  // The trace of the hour and minute hands goes from the first point to the second one, their body from the second one to
+  // the last one. The hour hand moves every minute (720 positions), the second hand is made of nbSecondSegments segments.
+  constexpr auto hourHand = Hand<720, 3>({5, 30, HourLength});
+  constexpr auto minuteHand = Hand<60, 3>({5, 30, MinuteLength});
+  constexpr auto secondHand = Hand<60, 5>({-20, 12, 45, 78, SecondLength});
+
+  static_assert(secondHand[0][4].x == 120 && secondHand[0][4].y == 10);
+  static_assert(secondHand[15][4].x == 230 && secondHand[15][4].y == 120);
+  static_assert(hourHand[360][2].x == 120 && hourHand[360][2].y == 190);
+
+  /*
+   * The line objects only cover the bounding box of their points: when a hand moves, LVGL only redraws the old and the new
+   * bounding boxes instead of the area from the top left corner of the screen to the hand.
+   */
+  void SetLine(lv_obj_t* line, lv_point_t (&points)[2], HandPoint from, HandPoint to) {
+    const lv_coord_t x = std::min(from.x, to.x);
+    const lv_coord_t y = std::min(from.y, to.y);
+    points[0] = {static_cast<lv_coord_t>(from.x - x), static_cast<lv_coord_t>(from.y - y)};
+    points[1] = {static_cast<lv_coord_t>(to.x - x), static_cast<lv_coord_t>(to.y - y)};
+    lv_obj_set_pos(line, x, y);
+    lv_line_set_points(line, points, 2);
   }
-
 }
 
 WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
@@ -122,13 +163,17 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
   minute_body_trace = lv_line_create(lv_scr_act(), nullptr);
   hour_body = lv_line_create(lv_scr_act(), nullptr);
   hour_body_trace = lv_line_create(lv_scr_act(), nullptr);
-  second_body = lv_line_create(lv_scr_act(), nullptr);
+  for (auto& segment : second_body) {
+    segment = lv_line_create(lv_scr_act(), nullptr);
+  }
 
   lv_style_init(&second_line_style);
   lv_style_set_line_width(&second_line_style, LV_STATE_DEFAULT, 3);
   lv_style_set_line_color(&second_line_style, LV_STATE_DEFAULT, LV_COLOR_RED);
   lv_style_set_line_rounded(&second_line_style, LV_STATE_DEFAULT, true);
-  lv_obj_add_style(second_body, LV_LINE_PART_MAIN, &second_line_style);
+  for (auto* segment : second_body) {
+    lv_obj_add_style(segment, LV_LINE_PART_MAIN, &second_line_style);
+  }
 
   lv_style_init(&minute_line_style);
   lv_style_set_line_width(&minute_line_style, LV_STATE_DEFAULT, 7);
@@ -154,7 +199,8 @@ WatchFaceAnalog::WatchFaceAnalog(Controllers::DateTime& dateTimeController,
   lv_style_set_line_rounded(&hour_line_style_trace, LV_STATE_DEFAULT, false);
   lv_obj_add_style(hour_body_trace, LV_LINE_PART_MAIN, &hour_line_style_trace);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  refreshOnTimeChange = true;
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriod::TimeChange, LV_TASK_PRIO_MID, this);
 
   Refresh();
 }
@@ -177,39 +223,27 @@ void WatchFaceAnalog::UpdateClock() {
   uint8_t second = dateTimeController.Seconds();
 
   if (sMinute != minute) {
-    auto const angle = minute * 6;
-    minute_point[0] = CoordinateRelocate(30, angle);
-    minute_point[1] = CoordinateRelocate(MinuteLength, angle);
-
-    minute_point_trace[0] = CoordinateRelocate(5, angle);
-    minute_point_trace[1] = CoordinateRelocate(31, angle);
-
-    lv_line_set_points(minute_body, minute_point, 2);
-    lv_line_set_points(minute_body_trace, minute_point_trace, 2);
+    const auto& hand = minuteHand[minute];
+    SetLine(minute_body, minute_point, hand[1], hand[2]);
+    SetLine(minute_body_trace, minute_point_trace, hand[0], hand[1]);
   }
 
   if (sHour != hour || sMinute != minute) {
     sHour = hour;
     sMinute = minute;
-    auto const angle = (hour * 30 + minute / 2);
-
-    hour_point[0] = CoordinateRelocate(30, angle);
-    hour_point[1] = CoordinateRelocate(HourLength, angle);
 
-    hour_point_trace[0] = CoordinateRelocate(5, angle);
-    hour_point_trace[1] = CoordinateRelocate(31, angle);
-
-    lv_line_set_points(hour_body, hour_point, 2);
-    lv_line_set_points(hour_body_trace, hour_point_trace, 2);
+    const auto& hand = hourHand[(hour % 12) * 60 + minute];
+    SetLine(hour_body, hour_point, hand[1], hand[2]);
+    SetLine(hour_body_trace, hour_point_trace, hand[0], hand[1]);
   }
 
   if (sSecond != second) {
     sSecond = second;
-    auto const angle = second * 6;
 
-    second_point[0] = CoordinateRelocate(-20, angle);
-    second_point[1] = CoordinateRelocate(SecondLength, angle);
-    lv_line_set_points(second_body, second_point, 2);
+    const auto& hand = secondHand[second];
+    for (uint8_t i = 0; i < nbSecondSegments; i++) {
+      SetLine(second_body[i], second_point[i], hand[i], hand[i + 1]);
+    }
   }
 }
 
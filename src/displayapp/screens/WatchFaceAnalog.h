@@ -51,17 +51,20 @@ namespace Pinetime {
         lv_obj_t* large_scales;
         lv_obj_t* twelve;
 
+        // The second hand is split in segments, so that the areas redrawn when it moves stay small
+        static constexpr uint8_t nbSecondSegments = 4;
+
         lv_obj_t* hour_body;
         lv_obj_t* hour_body_trace;
         lv_obj_t* minute_body;
         lv_obj_t* minute_body_trace;
-        lv_obj_t* second_body;
+        lv_obj_t* second_body[nbSecondSegments];
 
         lv_point_t hour_point[2];
         lv_point_t hour_point_trace[2];
         lv_point_t minute_point[2];
         lv_point_t minute_point_trace[2];
-        lv_point_t second_point[2];
+        lv_point_t second_point[nbSecondSegments][2];
 
         lv_style_t hour_line_style;
         lv_style_t hour_line_style_trace;
@@ -84,8 +87,6 @@ namespace Pinetime {
 
         void UpdateClock();
         void SetBatteryIcon();
-
-        lv_task_t* taskRefresh;
       };
     }
 
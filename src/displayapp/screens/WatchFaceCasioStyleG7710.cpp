@@ -21,7 +21,8 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
                                                    Controllers::Settings& settingsController,
                                                    Controllers::HeartRateController& heartRateController,
                                                    Controllers::MotionController& motionController,
-                                                   Controllers::FS& filesystem)
+                                                   Controllers::FS& filesystem,
+                                                   Components::LittleVgl& lvgl)
   : currentDateTime {{}},
     batteryIcon(false),
     dateTimeController {dateTimeController},
@@ -30,7 +31,8 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
     notificatioManager {notificatioManager},
     settingsController {settingsController},
     heartRateController {heartRateController},
-    motionController {motionController} {
+    motionController {motionController},
+    backgroundLayer(lvgl, filesystem, "/cache/casio.bin", 0) {
 
   lfs_file f = {};
   if (filesystem.FileOpen(&f, "/fonts/lv_font_dots_40.bin", LFS_O_RDONLY) >= 0) {
@@ -100,20 +102,38 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
   lv_style_set_line_color(&style_border, LV_STATE_DEFAULT, color_text);
   lv_style_set_line_rounded(&style_border, LV_STATE_DEFAULT, true);
 
-  line_icons = lv_line_create(lv_scr_act(), nullptr);
-  lv_line_set_points(line_icons, line_icons_points, 3);
-  lv_obj_add_style(line_icons, LV_LINE_PART_MAIN, &style_line);
-  lv_obj_align(line_icons, nullptr, LV_ALIGN_IN_TOP_RIGHT, -10, 18);
-
-  line_day_of_week_number = lv_line_create(lv_scr_act(), nullptr);
-  lv_line_set_points(line_day_of_week_number, line_day_of_week_number_points, 4);
-  lv_obj_add_style(line_day_of_week_number, LV_LINE_PART_MAIN, &style_border);
-  lv_obj_align(line_day_of_week_number, nullptr, LV_ALIGN_IN_TOP_LEFT, 0, 8);
-
-  line_day_of_year = lv_line_create(lv_scr_act(), nullptr);
-  lv_line_set_points(line_day_of_year, line_day_of_year_points, 3);
-  lv_obj_add_style(line_day_of_year, LV_LINE_PART_MAIN, &style_line);
-  lv_obj_align(line_day_of_year, nullptr, LV_ALIGN_IN_TOP_RIGHT, 0, 60);
+  // The frame lines never change, draw them from the cached background when possible
+  if (!backgroundLayer.IsCached()) {
+    line_icons = lv_line_create(lv_scr_act(), nullptr);
+    lv_line_set_points(line_icons, line_icons_points, 3);
+    lv_obj_add_style(line_icons, LV_LINE_PART_MAIN, &style_line);
+    lv_obj_align(line_icons, nullptr, LV_ALIGN_IN_TOP_RIGHT, -10, 18);
+    backgroundLayer.Add(line_icons);
+
+    line_day_of_week_number = lv_line_create(lv_scr_act(), nullptr);
+    lv_line_set_points(line_day_of_week_number, line_day_of_week_number_points, 4);
+    lv_obj_add_style(line_day_of_week_number, LV_LINE_PART_MAIN, &style_border);
+    lv_obj_align(line_day_of_week_number, nullptr, LV_ALIGN_IN_TOP_LEFT, 0, 8);
+    backgroundLayer.Add(line_day_of_week_number);
+
+    line_day_of_year = lv_line_create(lv_scr_act(), nullptr);
+    lv_line_set_points(line_day_of_year, line_day_of_year_points, 3);
+    lv_obj_add_style(line_day_of_year, LV_LINE_PART_MAIN, &style_line);
+    lv_obj_align(line_day_of_year, nullptr, LV_ALIGN_IN_TOP_RIGHT, 0, 60);
+    backgroundLayer.Add(line_day_of_year);
+
+    line_date = lv_line_create(lv_scr_act(), nullptr);
+    lv_line_set_points(line_date, line_date_points, 3);
+    lv_obj_add_style(line_date, LV_LINE_PART_MAIN, &style_line);
+    lv_obj_align(line_date, nullptr, LV_ALIGN_IN_TOP_RIGHT, 0, 100);
+    backgroundLayer.Add(line_date);
+
+    line_time = lv_line_create(lv_scr_act(), nullptr);
+    lv_line_set_points(line_time, line_time_points, 3);
+    lv_obj_add_style(line_time, LV_LINE_PART_MAIN, &style_line);
+    lv_obj_align(line_time, nullptr, LV_ALIGN_IN_BOTTOM_RIGHT, 0, -25);
+    backgroundLayer.Add(line_time);
+  }
 
   label_date = lv_label_create(lv_scr_act(), nullptr);
   lv_obj_align(label_date, lv_scr_act(), LV_ALIGN_IN_TOP_LEFT, 100, 70);
@@ -121,21 +141,11 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
   lv_obj_set_style_local_text_font(label_date, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, font_segment40);
   lv_label_set_text_static(label_date, "6-30");
 
-  line_date = lv_line_create(lv_scr_act(), nullptr);
-  lv_line_set_points(line_date, line_date_points, 3);
-  lv_obj_add_style(line_date, LV_LINE_PART_MAIN, &style_line);
-  lv_obj_align(line_date, nullptr, LV_ALIGN_IN_TOP_RIGHT, 0, 100);
-
   label_time = lv_label_create(lv_scr_act(), nullptr);
   lv_obj_set_style_local_text_color(label_time, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, color_text);
   lv_obj_set_style_local_text_font(label_time, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, font_segment115);
   lv_obj_align(label_time, lv_scr_act(), LV_ALIGN_CENTER, 0, 40);
 
-  line_time = lv_line_create(lv_scr_act(), nullptr);
-  lv_line_set_points(line_time, line_time_points, 3);
-  lv_obj_add_style(line_time, LV_LINE_PART_MAIN, &style_line);
-  lv_obj_align(line_time, nullptr, LV_ALIGN_IN_BOTTOM_RIGHT, 0, -25);
-
   label_time_ampm = lv_label_create(lv_scr_act(), nullptr);
   lv_obj_set_style_local_text_color(label_time_ampm, LV_LABEL_PART_MAIN, LV_STATE_DEFAULT, color_text);
   lv_label_set_text_static(label_time_ampm, "");
@@ -168,7 +178,10 @@ WatchFaceCasioStyleG7710::WatchFaceCasioStyleG7710(Controllers::DateTime& dateTi
   lv_label_set_text_static(stepIcon, Symbols::shoe);
   lv_obj_align(stepIcon, stepValue, LV_ALIGN_OUT_LEFT_MID, -5, 0);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  backgroundLayer.Apply();
+
+  refreshOnTimeChange = true;
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriod::TimeChange, LV_TASK_PRIO_MID, this);
   Refresh();
 }
 
@@ -266,16 +279,12 @@ void WatchFaceCasioStyleG7710::Refresh() {
                                  // first day of week 1; days in the new year before this are in week 0. [ tm_year, tm_wday, tm_yday]
       }
 
-      time_t ttTime =
-        std::chrono::system_clock::to_time_t(std::chrono::time_point_cast<std::chrono::system_clock::duration>(currentDateTime.Get()));
-      tm* tmTime = std::localtime(&ttTime);
-
       // TODO: When we start using C++20, use std::chrono::year::is_leap
       int daysInCurrentYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0 ? 366 : 365;
       uint16_t daysTillEndOfYearNumber = daysInCurrentYear - dayOfYear;
 
       char buffer[8];
-      strftime(buffer, 8, weekNumberFormat, tmTime);
+      strftime(buffer, 8, weekNumberFormat, &dateTimeController.LocalTime());
       uint8_t weekNumber = atoi(buffer);
 
       lv_label_set_text_fmt(label_day_of_week, "%s", dateTimeController.DayOfWeekShortToString());
@@ -7,6 +7,7 @@
 #include <memory>
 #include <displayapp/Controllers.h>
 #include "displayapp/screens/Screen.h"
+#include "displayapp/widgets/StaticLayer.h"
 #include "components/datetime/DateTimeController.h"
 #include "components/ble/BleController.h"
 #include "utility/DirtyValue.h"
@@ -34,7 +35,8 @@ namespace Pinetime {
                                  Controllers::Settings& settingsController,
                                  Controllers::HeartRateController& heartRateController,
                                  Controllers::MotionController& motionController,
-                                 Controllers::FS& filesystem);
+                                 Controllers::FS& filesystem,
+                                 Components::LittleVgl& lvgl);
         ~WatchFaceCasioStyleG7710() override;
 
         void Refresh() override;
@@ -66,15 +68,15 @@ namespace Pinetime {
         lv_style_t style_border;
 
         lv_obj_t* label_time;
-        lv_obj_t* line_time;
+        lv_obj_t* line_time = nullptr;
         lv_obj_t* label_time_ampm;
         lv_obj_t* label_date;
-        lv_obj_t* line_date;
+        lv_obj_t* line_date = nullptr;
         lv_obj_t* label_day_of_week;
         lv_obj_t* label_week_number;
-        lv_obj_t* line_day_of_week_number;
+        lv_obj_t* line_day_of_week_number = nullptr;
         lv_obj_t* label_day_of_year;
-        lv_obj_t* line_day_of_year;
+        lv_obj_t* line_day_of_year = nullptr;
         lv_obj_t* backgroundLabel;
         lv_obj_t* bleIcon;
         lv_obj_t* batteryPlug;
@@ -84,7 +86,7 @@ namespace Pinetime {
         lv_obj_t* stepIcon;
         lv_obj_t* stepValue;
         lv_obj_t* notificationIcon;
-        lv_obj_t* line_icons;
+        lv_obj_t* line_icons = nullptr;
 
         BatteryIcon batteryIcon;
 
@@ -96,7 +98,8 @@ namespace Pinetime {
         Controllers::HeartRateController& heartRateController;
         Controllers::MotionController& motionController;
 
-        lv_task_t* taskRefresh;
+        Widgets::StaticLayer backgroundLayer;
+
         lv_font_t* font_dot40 = nullptr;
         lv_font_t* font_segment40 = nullptr;
         lv_font_t* font_segment115 = nullptr;
@@ -116,7 +119,8 @@ namespace Pinetime {
                                                      controllers.settingsController,
                                                      controllers.heartRateController,
                                                      controllers.motionController,
-                                                     controllers.filesystem);
+                                                     controllers.filesystem,
+                                                     controllers.lvgl);
       };
 
       static bool IsAvailable(Pinetime::Controllers::FS& filesystem) {
@@ -72,7 +72,8 @@ WatchFaceDigital::WatchFaceDigital(Controllers::DateTime& dateTimeController,
   lv_label_set_text_static(stepIcon, Symbols::shoe);
   lv_obj_align(stepIcon, stepValue, LV_ALIGN_OUT_LEFT_MID, -5, 0);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  refreshOnTimeChange = true;
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriod::TimeChange, LV_TASK_PRIO_MID, this);
   Refresh();
 }
 
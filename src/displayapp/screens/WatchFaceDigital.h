@@ -70,7 +70,6 @@ namespace Pinetime {
         Controllers::HeartRateController& heartRateController;
         Controllers::MotionController& motionController;
 
-        lv_task_t* taskRefresh;
         Widgets::StatusIcons statusIcons;
       };
     }
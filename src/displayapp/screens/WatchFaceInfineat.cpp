@@ -132,17 +132,16 @@ WatchFaceInfineat::WatchFaceInfineat(Controllers::DateTime& dateTimeController,
     bleController {bleController},
     notificationManager {notificationManager},
     settingsController {settingsController},
-    motionController {motionController} {
-  lfs_file f = {};
-  if (filesystem.FileOpen(&f, "/fonts/teko.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_teko = lv_font_load("F:/fonts/teko.bin");
-  }
+    motionController {motionController},
+    fontTeko {filesystem},
+    fontBebas {filesystem} {
+  // Date, steps and AM/PM
+  fontTeko.Open("/fonts/teko.bin", 16);
+  font_teko = fontTeko.Font();
 
-  if (filesystem.FileOpen(&f, "/fonts/bebas.bin", LFS_O_RDONLY) >= 0) {
-    filesystem.FileClose(&f);
-    font_bebas = lv_font_load("F:/fonts/bebas.bin");
-  }
+  // Two digits for the hours and two for the minutes
+  fontBebas.Open("/fonts/bebas.bin", 4);
+  font_bebas = fontBebas.Font();
 
   // Side Cover
   static constexpr lv_point_t linePoints[nLines][2] = {{{30, 25}, {68, -8}},
@@ -296,20 +295,14 @@ WatchFaceInfineat::WatchFaceInfineat(Controllers::DateTime& dateTimeController,
   lv_label_set_text_static(labelBtnSettings, Symbols::settings);
   lv_obj_set_hidden(btnSettings, true);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  refreshOnTimeChange = true;
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriod::TimeChange, LV_TASK_PRIO_MID, this);
   Refresh();
 }
 
 WatchFaceInfineat::~WatchFaceInfineat() {
   lv_task_del(taskRefresh);
 
-  if (font_bebas != nullptr) {
-    lv_font_free(font_bebas);
-  }
-  if (font_teko != nullptr) {
-    lv_font_free(font_teko);
-  }
-
   lv_obj_clean(lv_scr_act());
 }
 
@@ -487,18 +480,11 @@ void WatchFaceInfineat::ToggleBatteryIndicatorColor(bool showSideCover) {
 }
 
 bool WatchFaceInfineat::IsAvailable(Pinetime::Controllers::FS& filesystem) {
-  lfs_file file = {};
-
-  if (filesystem.FileOpen(&file, "/fonts/teko.bin", LFS_O_RDONLY) < 0) {
+  if (!Components::FontPack::IsValid(filesystem, "/fonts/teko.bin") || !Components::FontPack::IsValid(filesystem, "/fonts/bebas.bin")) {
     return false;
   }
 
-  filesystem.FileClose(&file);
-  if (filesystem.FileOpen(&file, "/fonts/bebas.bin", LFS_O_RDONLY) < 0) {
-    return false;
-  }
-
-  filesystem.FileClose(&file);
+  lfs_file file = {};
   if (filesystem.FileOpen(&file, "/images/pine_small.bin", LFS_O_RDONLY) < 0) {
     return false;
   }
@@ -6,6 +6,7 @@
 #include <memory>
 #include <displayapp/Controllers.h>
 #include "displayapp/screens/Screen.h"
+#include "displayapp/FontPack.h"
 #include "components/datetime/DateTimeController.h"
 #include "utility/DirtyValue.h"
 #include "displayapp/apps/Apps.h"
@@ -95,7 +96,8 @@ namespace Pinetime {
         void SetBatteryLevel(uint8_t batteryPercent);
         void ToggleBatteryIndicatorColor(bool showSideCover);
 
-        lv_task_t* taskRefresh;
+        Components::FontPack fontTeko;
+        Components::FontPack fontBebas;
         lv_font_t* font_teko = nullptr;
         lv_font_t* font_bebas = nullptr;
       };
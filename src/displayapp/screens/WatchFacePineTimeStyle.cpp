@@ -394,7 +394,8 @@ WatchFacePineTimeStyle::WatchFacePineTimeStyle(Controllers::DateTime& dateTimeCo
   lv_label_set_text_static(lblSetOpts, Symbols::settings);
   lv_obj_set_hidden(btnSetOpts, true);
 
-  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  refreshOnTimeChange = true;
+  taskRefresh = lv_task_create(RefreshTaskCallback, RefreshPeriod::TimeChange, LV_TASK_PRIO_MID, this);
   Refresh();
 }
 
@@ -116,8 +116,6 @@ namespace Pinetime {
 
         void SetBatteryIcon();
         void CloseMenu();
-
-        lv_task_t* taskRefresh;
       };
     }
 
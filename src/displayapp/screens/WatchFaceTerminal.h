@@ -65,8 +65,6 @@ namespace Pinetime {
         Controllers::Settings& settingsController;
         Controllers::HeartRateController& heartRateController;
         Controllers::MotionController& motionController;
-
-        lv_task_t* taskRefresh;
       };
     }
 
@@ -130,6 +130,17 @@ QuickSettings::~QuickSettings() {
   settingsController.SaveSettings();
 }
 
+void QuickSettings::Suspend() {
+  Screen::Suspend();
+  lv_task_set_prio(taskUpdate, LV_TASK_PRIO_OFF);
+}
+
+void QuickSettings::Resume() {
+  Screen::Resume();
+  lv_task_set_prio(taskUpdate, LV_TASK_PRIO_MID);
+  lv_task_ready(taskUpdate);
+}
+
 void QuickSettings::UpdateScreen() {
   lv_label_set_text(label_time, dateTimeController.FormattedTime().c_str());
   statusIcons.Update();
@@ -27,6 +27,9 @@ namespace Pinetime {
 
         ~QuickSettings() override;
 
+        void Suspend() override;
+        void Resume() override;
+
         void OnButtonEvent(lv_obj_t* object);
 
         void UpdateScreen();
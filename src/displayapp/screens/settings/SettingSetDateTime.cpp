@@ -12,6 +12,16 @@ bool SettingSetDateTime::OnTouchEvent(Pinetime::Applications::TouchEvents event)
   return screens.OnTouchEvent(event);
 }
 
+void SettingSetDateTime::Suspend() {
+  Screen::Suspend();
+  screens.Suspend();
+}
+
+void SettingSetDateTime::Resume() {
+  Screen::Resume();
+  screens.Resume();
+}
+
 SettingSetDateTime::SettingSetDateTime(Pinetime::Applications::DisplayApp* app,
                                        Pinetime::Controllers::DateTime& dateTimeController,
                                        Pinetime::Controllers::Settings& settingsController)
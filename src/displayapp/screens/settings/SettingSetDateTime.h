@@ -16,6 +16,8 @@ namespace Pinetime {
         ~SettingSetDateTime() override;
 
         bool OnTouchEvent(TouchEvents event) override;
+        void Suspend() override;
+        void Resume() override;
         void Advance();
         void Quit();
 
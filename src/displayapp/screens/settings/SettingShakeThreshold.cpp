@@ -68,7 +68,7 @@ SettingShakeThreshold::SettingShakeThreshold(Controllers::Settings& settingsCont
     EnableForCal = true;
     settingsController.setWakeUpMode(Pinetime::Controllers::Settings::WakeUpMode::Shake, true);
   }
-  refreshTask = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
+  taskRefresh = lv_task_create(RefreshTaskCallback, LV_DISP_DEF_REFR_PERIOD, LV_TASK_PRIO_MID, this);
 }
 
 SettingShakeThreshold::~SettingShakeThreshold() {
@@ -78,7 +78,7 @@ SettingShakeThreshold::~SettingShakeThreshold() {
     settingsController.setWakeUpMode(Pinetime::Controllers::Settings::WakeUpMode::Shake, false);
     EnableForCal = false;
   }
-  lv_task_del(refreshTask);
+  lv_task_del(taskRefresh);
   settingsController.SaveSettings();
   lv_obj_clean(lv_scr_act());
 }
@@ -30,7 +30,6 @@ namespace Pinetime {
         bool EnableForCal;
         uint32_t vDecay, vCalTime;
         lv_obj_t *positionArc, *animArc, *calButton, *calLabel;
-        lv_task_t* refreshTask;
       };
     }
   }
@@ -38,6 +38,16 @@ bool SettingWatchFace::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
   return screens.OnTouchEvent(event);
 }
 
+void SettingWatchFace::Suspend() {
+  Screen::Suspend();
+  screens.Suspend();
+}
+
+void SettingWatchFace::Resume() {
+  Screen::Resume();
+  screens.Resume();
+}
+
 std::unique_ptr<Screen> SettingWatchFace::CreateScreen(unsigned int screenNum) const {
   std::array<Screens::CheckboxList::Item, settingsPerScreen> watchfacesOnThisScreen;
   for (int i = 0; i < settingsPerScreen; i++) {
@@ -26,6 +26,8 @@ namespace Pinetime {
         ~SettingWatchFace() override;
 
         bool OnTouchEvent(TouchEvents event) override;
+        void Suspend() override;
+        void Resume() override;
 
       private:
         DisplayApp* app;
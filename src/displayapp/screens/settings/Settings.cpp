@@ -32,6 +32,16 @@ bool Settings::OnTouchEvent(Pinetime::Applications::TouchEvents event) {
   return screens.OnTouchEvent(event);
 }
 
+void Settings::Suspend() {
+  Screen::Suspend();
+  screens.Suspend();
+}
+
+void Settings::Resume() {
+  Screen::Resume();
+  screens.Resume();
+}
+
 std::unique_ptr<Screen> Settings::CreateScreen(unsigned int screenNum) const {
   std::array<List::Applications, entriesPerScreen> screens;
   for (int i = 0; i < entriesPerScreen; i++) {
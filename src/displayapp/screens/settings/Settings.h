@@ -18,6 +18,8 @@ namespace Pinetime {
         ~Settings() override;
 
         bool OnTouchEvent(Pinetime::Applications::TouchEvents event) override;
+        void Suspend() override;
+        void Resume() override;
 
       private:
         DisplayApp* app;
@@ -0,0 +1,222 @@
+#include "displayapp/widgets/StaticLayer.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include "components/fs/FS.h"
+#include "displayapp/ImageDecoder.h"
+#include "Version.h"
+
+using namespace Pinetime::Applications::Widgets;
+using Pinetime::Components::ImageDecoder;
+
+namespace {
+  constexpr const char* cacheDirectory = "/cache";
+  // Attribute of the cache file that holds its key, set once the whole image is written
+  constexpr uint8_t keyAttribute = 0;
+
+  // FNV-1a, mixes the firmware version into the key so that the cache is rendered again after an update
+  uint32_t Hash(uint32_t hash, const char* str) {
+    while (*str != '\0') {
+      hash = (hash ^ static_cast<uint8_t>(*str++)) * 16777619;
+    }
+    return hash;
+  }
+
+  lv_img_header_t ImageHeader() {
+    lv_img_header_t header {};
+    header.cf = LV_IMG_CF_USER_ENCODED_0;
+    header.w = LV_HOR_RES_MAX;
+    header.h = LV_VER_RES_MAX;
+    return header;
+  }
+}
+
+StaticLayer::StaticLayer(Components::LittleVgl& lvgl, Controllers::FS& filesystem, const char* path, uint32_t key)
+  : lvgl {lvgl}, filesystem {filesystem}, path {path} {
+  this->key = Hash(Hash(2166136261 ^ key, Version::VersionString()), Version::GitCommitHash());
+  snprintf(imageSource, sizeof(imageSource), "F:%s", path);
+  cached = IsCacheValid();
+}
+
+StaticLayer::~StaticLayer() {
+  FreeImage();
+}
+
+void StaticLayer::Add(lv_obj_t* obj) {
+  if (nbObjects < maxObjects) {
+    objects[nbObjects++] = obj;
+  }
+}
+
+void StaticLayer::Apply() {
+  if (!cached) {
+    if (!Store()) {
+      filesystem.FileDelete(path);
+    }
+    // Keep the live objects this time, the cache will be used the next time the screen is created
+    return;
+  }
+
+  image = lv_img_create(lv_scr_act(), nullptr);
+  if (LoadInRam()) {
+    lv_img_set_src(image, &ramImageDsc);
+  } else {
+    lv_img_set_src(image, imageSource);
+  }
+  lv_obj_set_pos(image, 0, 0);
+  lv_obj_move_background(image);
+  for (uint8_t i = 0; i < nbObjects; i++) {
+    lv_obj_set_hidden(objects[i], true);
+  }
+}
+
+void StaticLayer::Release() {
+  if (image == nullptr) {
+    return;
+  }
+  for (uint8_t i = 0; i < nbObjects; i++) {
+    lv_obj_set_hidden(objects[i], false);
+  }
+  lv_obj_del(image);
+  image = nullptr;
+  FreeImage();
+}
+
+void StaticLayer::FreeImage() {
+  // The image cache of LVGL keeps the decoder of the image open after the image object is deleted
+  if (ramImage != nullptr) {
+    lv_img_cache_invalidate_src(&ramImageDsc);
+    lv_mem_free(ramImage);
+    ramImage = nullptr;
+  }
+}
+
+bool StaticLayer::IsCacheValid() {
+  uint32_t storedKey = 0;
+  return filesystem.GetAttribute(path, keyAttribute, &storedKey, sizeof(storedKey)) == sizeof(storedKey) && storedKey == key;
+}
+
+bool StaticLayer::LoadInRam() {
+  lfs_info info;
+  if (filesystem.Stat(path, &info) != LFS_ERR_OK || info.size > maxRamSize) {
+    return false;
+  }
+  ramImage = static_cast<uint8_t*>(lv_mem_alloc(info.size));
+  if (ramImage == nullptr) {
+    return false;
+  }
+
+  lfs_file_t file;
+  bool loaded = false;
+  if (filesystem.FileOpen(&file, path, LFS_O_RDONLY) == LFS_ERR_OK) {
+    loaded = filesystem.FileRead(&file, ramImage, info.size) == static_cast<int>(info.size);
+    filesystem.FileClose(&file);
+  }
+  if (!loaded) {
+    lv_mem_free(ramImage);
+    ramImage = nullptr;
+    return false;
+  }
+
+  ramImageDsc.header = ImageHeader();
+  ramImageDsc.data_size = info.size;
+  ramImageDsc.data = ramImage;
+  return true;
+}
+
+bool StaticLayer::Store() {
+  // Only the static objects must end up in the image: temporarily hide everything else
+  std::array<lv_obj_t*, 64> hiddenObjects;
+  uint8_t nbHiddenObjects = 0;
+  for (lv_obj_t* child = lv_obj_get_child(lv_scr_act(), nullptr); child != nullptr; child = lv_obj_get_child(lv_scr_act(), child)) {
+    bool isStatic = false;
+    for (uint8_t i = 0; i < nbObjects; i++) {
+      isStatic |= (objects[i] == child);
+    }
+    if (!isStatic && !lv_obj_get_hidden(child)) {
+      if (nbHiddenObjects == hiddenObjects.size()) {
+        break;
+      }
+      lv_obj_set_hidden(child, true);
+      hiddenObjects[nbHiddenObjects++] = child;
+    }
+  }
+
+  auto restoreHiddenObjects = [&]() {
+    for (uint8_t i = 0; i < nbHiddenObjects; i++) {
+      lv_obj_set_hidden(hiddenObjects[i], false);
+    }
+  };
+
+  if (nbHiddenObjects == hiddenObjects.size()) {
+    restoreHiddenObjects();
+    return false;
+  }
+
+  // The image cache of LVGL may still have the previous file open, and its key must not survive a partial write
+  lv_img_cache_invalidate_src(nullptr);
+  filesystem.FileDelete(path);
+  filesystem.DirCreate(cacheDirectory);
+  lfs_file_t file;
+  if (filesystem.FileOpen(&file, path, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    restoreHiddenObjects();
+    return false;
+  }
+  storeRow = static_cast<uint8_t*>(lv_mem_alloc(sizeof(uint16_t) + maxRowSize));
+  if (storeRow == nullptr) {
+    filesystem.FileClose(&file);
+    restoreHiddenObjects();
+    return false;
+  }
+
+  // The headers and the index are written again once the size of the rows is known
+  const lv_img_header_t imgHeader = ImageHeader();
+  ImageDecoder::Header header {};
+  header.format = LV_IMG_CF_TRUE_COLOR;
+  header.compression = ImageDecoder::Compressions::Rle;
+  header.rowsPerIndex = rowsPerIndex;
+  storeIndex.fill(0);
+  storeFile = &file;
+  storeOffset = sizeof(imgHeader) + sizeof(header) + sizeof(storeIndex);
+  storeNextRow = 0;
+  storeLargestRow = 0;
+
+  bool success = filesystem.FileSeek(&file, storeOffset) >= 0 && lvgl.Render(*this);
+  if (success) {
+    header.maxRowSize = storeLargestRow;
+    success = filesystem.FileSeek(&file, 0) >= 0 &&
+              filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&imgHeader), sizeof(imgHeader)) == sizeof(imgHeader) &&
+              filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(&header), sizeof(header)) == sizeof(header) &&
+              filesystem.FileWrite(&file, reinterpret_cast<const uint8_t*>(storeIndex.data()), sizeof(storeIndex)) == sizeof(storeIndex);
+  }
+  filesystem.FileClose(&file);
+  lv_mem_free(storeRow);
+  storeRow = nullptr;
+  storeFile = nullptr;
+
+  success = success && filesystem.SetAttribute(path, keyAttribute, &key, sizeof(key)) == LFS_ERR_OK;
+  restoreHiddenObjects();
+  return success;
+}
+
+bool StaticLayer::WriteRow(const lv_color_t* pixels) {
+  if (storeNextRow % rowsPerIndex == 0) {
+    storeIndex[storeNextRow / rowsPerIndex] = storeOffset;
+  }
+  const uint16_t size = ImageDecoder::EncodeRle(reinterpret_cast<const uint8_t*>(pixels),
+                                                LV_HOR_RES_MAX * sizeof(lv_color_t),
+                                                storeRow + sizeof(size),
+                                                maxRowSize,
+                                                sizeof(lv_color_t));
+  if (size == 0) {
+    return false;
+  }
+  std::memcpy(storeRow, &size, sizeof(size));
+  if (filesystem.FileWrite(storeFile, storeRow, sizeof(size) + size) != static_cast<int>(sizeof(size) + size)) {
+    return false;
+  }
+  storeOffset += sizeof(size) + size;
+  storeNextRow++;
+  storeLargestRow = std::max(storeLargestRow, size);
+  return true;
+}
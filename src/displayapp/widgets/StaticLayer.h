@@ -0,0 +1,90 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <lvgl/lvgl.h>
+#include "displayapp/LittleVgl.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS;
+  }
+
+  namespace Applications {
+    namespace Widgets {
+      /**
+       * Caches the static objects of a screen (backgrounds, frames, decorations) as a single image in the file system.
+       *
+       * The first time the screen is created, the static objects are rendered into the cache file. The next times, the cached
+       * image is drawn instead and the static objects are hidden: they still work as alignment references, but LVGL doesn't
+       * have to draw them anymore. The cache is rendered again when the key (computed from the settings that change the look
+       * of the static objects) or the firmware version changes.
+       *
+       * The image is compressed row by row (see Components::ImageDecoder): the background of the static objects is mostly
+       * uniform, so the layer of a watch face is a few KB instead of 115 KB of RGB565 pixels. When it is smaller than
+       * maxRamSize, it is read once into RAM while the screen is displayed, instead of reading the rows from the SPI flash each
+       * time LVGL redraws an area of the screen.
+       */
+      class StaticLayer : private Components::LittleVgl::RenderTarget {
+      public:
+        StaticLayer(Components::LittleVgl& lvgl, Controllers::FS& filesystem, const char* path, uint32_t key);
+        ~StaticLayer();
+
+        StaticLayer(const StaticLayer&) = delete;
+        StaticLayer& operator=(const StaticLayer&) = delete;
+
+        /** @return true if the cached image is up to date. Static objects that are not used as alignment references don't need to be
+         * created in this case. */
+        bool IsCached() const {
+          return cached;
+        }
+
+        /** Adds an object to the layer. Static objects must not have children. */
+        void Add(lv_obj_t* obj);
+
+        /** Must be called once all the objects of the screen are created */
+        void Apply();
+
+        /** Switches back to the live objects, e.g. when their style is about to change */
+        void Release();
+
+      private:
+        static constexpr uint32_t maxRamSize = 4096;
+        static constexpr uint8_t rowsPerIndex = 16;
+        static constexpr uint8_t nbIndex = (LV_VER_RES_MAX + rowsPerIndex - 1) / rowsPerIndex;
+        // A row of literal pixels, with a control byte every 128 pixels, after the size of the row
+        static constexpr uint16_t maxRowSize = LV_HOR_RES_MAX * sizeof(lv_color_t) + (LV_HOR_RES_MAX + 127) / 128;
+
+        bool IsCacheValid();
+        bool Store();
+        bool LoadInRam();
+        void FreeImage();
+        bool WriteRow(const lv_color_t* pixels) override;
+
+        Components::LittleVgl& lvgl;
+        Controllers::FS& filesystem;
+        const char* path;
+        uint32_t key;
+        bool cached;
+
+        static constexpr uint8_t maxObjects = 12;
+        std::array<lv_obj_t*, maxObjects> objects;
+        uint8_t nbObjects = 0;
+
+        lv_obj_t* image = nullptr;
+        char imageSource[32];
+        // Content of the cache file, when it is small enough to be kept in RAM
+        uint8_t* ramImage = nullptr;
+        lv_img_dsc_t ramImageDsc {};
+
+        // State of Store(), while the rows are rendered into the file
+        lfs_file_t* storeFile = nullptr;
+        uint8_t* storeRow = nullptr;
+        uint32_t storeOffset = 0;
+        uint16_t storeNextRow = 0;
+        uint16_t storeLargestRow = 0;
+        std::array<uint32_t, nbIndex> storeIndex;
+      };
+    }
+  }
+}
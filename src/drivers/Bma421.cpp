@@ -1,12 +1,19 @@
 #include "drivers/Bma421.h"
 #include <libraries/delay/nrf_delay.h>
 #include <libraries/log/nrf_log.h>
+#include <FreeRTOS.h>
+#include <task.h>
 #include "drivers/TwiMaster.h"
 #include <drivers/Bma421_C/bma423.h>
 
 using namespace Pinetime::Drivers;
 
 namespace {
+  // Size of the bursts in which the config file (6KB) is uploaded. The BMA API limits it to the size of the feature config
+  // (70 bytes), and it must divide the size of the config file.
+  constexpr uint16_t configBurstSize = 64;
+  static_assert(configBurstSize <= Pinetime::Drivers::TwiMaster::maxDataSize);
+
   int8_t user_i2c_read(uint8_t reg_addr, uint8_t* reg_data, uint32_t length, void* intf_ptr) {
     auto bma421 = static_cast<Bma421*>(intf_ptr);
     bma421->Read(reg_addr, reg_data, length);
@@ -20,7 +27,13 @@ namespace {
   }
 
   void user_delay(uint32_t period_us, void* /*intf_ptr*/) {
-    nrf_delay_us(period_us);
+    // Let the other tasks run during the long waits, like the initialization of the ASIC (150ms) after the config upload
+    if (period_us >= 1000) {
+      // vTaskDelay() can return up to 1 tick early
+      vTaskDelay((period_us * configTICK_RATE_HZ + 999999) / 1000000 + 1);
+    } else {
+      nrf_delay_us(period_us);
+    }
   }
 }
 
@@ -31,7 +44,7 @@ Bma421::Bma421(TwiMaster& twiMaster, uint8_t twiAddress) : twiMaster {twiMaster}
   bma.variant = BMA42X_VARIANT;
   bma.intf_ptr = this;
   bma.delay_us = user_delay;
-  bma.read_write_len = 16;
+  bma.read_write_len = configBurstSize;
 }
 
 void Bma421::Init() {
@@ -37,3 +37,11 @@ void Spi::Wakeup() {
   nrf_gpio_pin_set(pinCsn);
   NRF_LOG_INFO("[SPI] Wakeup")
 }
+
+void Spi::Acquire() {
+  spiMaster.Acquire();
+}
+
+void Spi::Release() {
+  spiMaster.Release();
+}
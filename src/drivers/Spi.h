@@ -19,6 +19,8 @@ namespace Pinetime {
       bool WriteCmdAndBuffer(const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize);
       void Sleep();
       void Wakeup();
+      void Acquire();
+      void Release();
 
     private:
       SpiMaster& spiMaster;
@@ -14,6 +14,10 @@ bool SpiMaster::Init() {
     mutex = xSemaphoreCreateBinary();
     ASSERT(mutex != nullptr);
   }
+  if (powerMutex == nullptr) {
+    powerMutex = xSemaphoreCreateMutex();
+    ASSERT(powerMutex != nullptr);
+  }
 
   /* Configure GPIO pins used for pselsck, pselmosi, pselmiso and pselss for SPI0 */
   nrf_gpio_pin_set(params.pinSCK);
@@ -90,6 +94,7 @@ bool SpiMaster::Init() {
   NRFX_IRQ_PRIORITY_SET(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn, 2);
   NRFX_IRQ_ENABLE(SPIM0_SPIS0_TWIM0_TWIS0_SPI0_TWI0_IRQn);
 
+  enabled = true;
   xSemaphoreGive(mutex);
   return true;
 }
@@ -247,21 +252,63 @@ bool SpiMaster::Read(uint8_t pinCsn, uint8_t* cmd, size_t cmdSize, uint8_t* data
 }
 
 void SpiMaster::Sleep() {
+  xSemaphoreTake(powerMutex, portMAX_DELAY);
+  systemAwake = false;
+  if (users == 0) {
+    Disable();
+  }
+  xSemaphoreGive(powerMutex);
+}
+
+void SpiMaster::Wakeup() {
+  xSemaphoreTake(powerMutex, portMAX_DELAY);
+  systemAwake = true;
+  Enable();
+  xSemaphoreGive(powerMutex);
+}
+
+void SpiMaster::Acquire() {
+  xSemaphoreTake(powerMutex, portMAX_DELAY);
+  users++;
+  Enable();
+  xSemaphoreGive(powerMutex);
+}
+
+void SpiMaster::Release() {
+  xSemaphoreTake(powerMutex, portMAX_DELAY);
+  users--;
+  if (users == 0 && !systemAwake) {
+    Disable();
+  }
+  xSemaphoreGive(powerMutex);
+}
+
+void SpiMaster::Enable() {
+  if (enabled) {
+    return;
+  }
+  Init();
+  NRF_LOG_INFO("[SPIMASTER] Wakeup");
+}
+
+void SpiMaster::Disable() {
+  if (!enabled) {
+    return;
+  }
+  // Wait for the end of the current transfer
+  xSemaphoreTake(mutex, portMAX_DELAY);
   while (spiBaseAddress->ENABLE != 0) {
     spiBaseAddress->ENABLE = (SPIM_ENABLE_ENABLE_Disabled << SPIM_ENABLE_ENABLE_Pos);
   }
   nrf_gpio_cfg_default(params.pinSCK);
   nrf_gpio_cfg_default(params.pinMOSI);
   nrf_gpio_cfg_default(params.pinMISO);
+  enabled = false;
+  xSemaphoreGive(mutex);
 
   NRF_LOG_INFO("[SPIMASTER] sleep")
 }
 
-void SpiMaster::Wakeup() {
-  Init();
-  NRF_LOG_INFO("[SPIMASTER] Wakeup");
-}
-
 bool SpiMaster::WriteCmdAndBuffer(uint8_t pinCsn, const uint8_t* cmd, size_t cmdSize, const uint8_t* data, size_t dataSize) {
   xSemaphoreTake(mutex, portMAX_DELAY);
 
@@ -39,10 +39,17 @@ namespace Pinetime {
       void OnStartedEvent();
       void OnEndEvent();
 
+      // Sleep() and Wakeup() follow the state of the system. Acquire() and Release() keep the bus enabled
+      // for the drivers that are used while the system sleeps (e.g. the external flash).
       void Sleep();
       void Wakeup();
+      void Acquire();
+      void Release();
 
     private:
+      void Enable();
+      void Disable();
+
       void SetupWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void DisableWorkaroundForFtpan58(NRF_SPIM_Type* spim, uint32_t ppi_channel, uint32_t gpiote_channel);
       void PrepareTx(const volatile uint32_t bufferAddress, const volatile size_t size);
@@ -58,6 +65,11 @@ namespace Pinetime {
       volatile size_t currentBufferSize = 0;
       volatile TaskHandle_t taskToNotify;
       SemaphoreHandle_t mutex = nullptr;
+
+      SemaphoreHandle_t powerMutex = nullptr;
+      bool enabled = false;
+      bool systemAwake = true;
+      uint8_t users = 0;
     };
   }
 }
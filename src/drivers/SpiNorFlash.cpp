@@ -10,6 +10,9 @@ SpiNorFlash::SpiNorFlash(Spi& spi) : spi {spi} {
 }
 
 void SpiNorFlash::Init() {
+  if (powerMutex == nullptr) {
+    powerMutex = xSemaphoreCreateMutex();
+  }
   device_id = ReadIdentificaion();
   NRF_LOG_INFO("[SpiNorFlash] Manufacturer : %d, Memory type : %d, memory density : %d",
                device_id.manufacturer,
@@ -21,12 +24,54 @@ void SpiNorFlash::Uninit() {
 }
 
 void SpiNorFlash::Sleep() {
+  xSemaphoreTake(powerMutex, portMAX_DELAY);
+  systemAwake = false;
+  if (users == 0) {
+    EnterDeepPowerDown();
+  }
+  xSemaphoreGive(powerMutex);
+}
+
+void SpiNorFlash::Wakeup() {
+  xSemaphoreTake(powerMutex, portMAX_DELAY);
+  systemAwake = true;
+  ExitDeepPowerDown();
+  xSemaphoreGive(powerMutex);
+}
+
+void SpiNorFlash::Acquire() {
+  xSemaphoreTake(powerMutex, portMAX_DELAY);
+  spi.Acquire();
+  users++;
+  ExitDeepPowerDown();
+  xSemaphoreGive(powerMutex);
+}
+
+void SpiNorFlash::Release() {
+  xSemaphoreTake(powerMutex, portMAX_DELAY);
+  users--;
+  if (users == 0 && !systemAwake) {
+    EnterDeepPowerDown();
+  }
+  spi.Release();
+  xSemaphoreGive(powerMutex);
+}
+
+void SpiNorFlash::EnterDeepPowerDown() {
+  if (sleeping) {
+    return;
+  }
   auto cmd = static_cast<uint8_t>(Commands::DeepPowerDown);
   spi.Write(&cmd, sizeof(uint8_t));
+  sleeping = true;
   NRF_LOG_INFO("[SpiNorFlash] Sleep")
 }
 
-void SpiNorFlash::Wakeup() {
+void SpiNorFlash::ExitDeepPowerDown() {
+  if (!sleeping) {
+    return;
+  }
+  sleeping = false;
   // send Commands::ReleaseFromDeepPowerDown then 3 dummy bytes before reading Device ID
   static constexpr uint8_t cmdSize = 4;
   uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::ReleaseFromDeepPowerDown), 0x01, 0x02, 0x03};
@@ -85,11 +130,40 @@ void SpiNorFlash::WriteEnable() {
 }
 
 void SpiNorFlash::SectorErase(uint32_t sectorAddress) {
+  Erase(Commands::SectorErase, sectorAddress);
+}
+
+void SpiNorFlash::BlockErase32K(uint32_t blockAddress) {
+  Erase(Commands::BlockErase32K, blockAddress);
+}
+
+void SpiNorFlash::BlockErase64K(uint32_t blockAddress) {
+  Erase(Commands::BlockErase64K, blockAddress);
+}
+
+void SpiNorFlash::EraseRange(uint32_t address, size_t size) {
+  const uint32_t end = address + size;
+  while (address < end) {
+    const uint32_t remaining = end - address;
+    if ((address % block64KSize) == 0 && remaining >= block64KSize) {
+      BlockErase64K(address);
+      address += block64KSize;
+    } else if ((address % block32KSize) == 0 && remaining >= block32KSize) {
+      BlockErase32K(address);
+      address += block32KSize;
+    } else {
+      SectorErase(address);
+      address += sectorSize;
+    }
+  }
+}
+
+void SpiNorFlash::Erase(Commands command, uint32_t address) {
   static constexpr uint8_t cmdSize = 4;
-  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(Commands::SectorErase),
-                          static_cast<uint8_t>(sectorAddress >> 16U),
-                          static_cast<uint8_t>(sectorAddress >> 8U),
-                          static_cast<uint8_t>(sectorAddress)};
+  uint8_t cmd[cmdSize] = {static_cast<uint8_t>(command),
+                          static_cast<uint8_t>(address >> 16U),
+                          static_cast<uint8_t>(address >> 8U),
+                          static_cast<uint8_t>(address)};
 
   WriteEnable();
   while (!WriteEnabled())
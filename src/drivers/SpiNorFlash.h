@@ -1,6 +1,8 @@
 #pragma once
 #include <cstddef>
 #include <cstdint>
+#include <FreeRTOS.h>
+#include <semphr.h>
 
 namespace Pinetime {
   namespace Drivers {
@@ -14,6 +16,10 @@ namespace Pinetime {
       SpiNorFlash(SpiNorFlash&&) = delete;
       SpiNorFlash& operator=(SpiNorFlash&&) = delete;
 
+      static constexpr uint32_t sectorSize = 0x1000;
+      static constexpr uint32_t block32KSize = 0x8000;
+      static constexpr uint32_t block64KSize = 0x10000;
+
       struct __attribute__((packed)) Identification {
         uint8_t manufacturer = 0;
         uint8_t type = 0;
@@ -29,6 +35,11 @@ namespace Pinetime {
       void Write(uint32_t address, const uint8_t* buffer, size_t size);
       void WriteEnable();
       void SectorErase(uint32_t sectorAddress);
+      void BlockErase32K(uint32_t blockAddress);
+      void BlockErase64K(uint32_t blockAddress);
+      // Erases [address, address + size) with the largest erase units allowed by the alignment. Both must be multiples of
+      // the sector size.
+      void EraseRange(uint32_t address, size_t size);
       uint8_t ReadSecurityRegister();
       bool ProgramFailed();
       bool EraseFailed();
@@ -36,10 +47,17 @@ namespace Pinetime {
       void Init();
       void Uninit();
 
+      // Sleep() and Wakeup() follow the state of the system. While the system sleeps, Acquire() wakes the flash
+      // from deep power-down for an access, and Release() puts it back in deep power-down once there are no users left.
       void Sleep();
       void Wakeup();
+      void Acquire();
+      void Release();
 
     private:
+      void EnterDeepPowerDown();
+      void ExitDeepPowerDown();
+
       enum class Commands : uint8_t {
         PageProgram = 0x02,
         Read = 0x03,
@@ -48,14 +66,24 @@ namespace Pinetime {
         ReadConfigurationRegister = 0x15,
         SectorErase = 0x20,
         ReadSecurityRegister = 0x2B,
+        BlockErase32K = 0x52,
         ReadIdentification = 0x9F,
         ReleaseFromDeepPowerDown = 0xAB,
-        DeepPowerDown = 0xB9
+        DeepPowerDown = 0xB9,
+        BlockErase64K = 0xD8
       };
       static constexpr uint16_t pageSize = 256;
 
+      void Erase(Commands command, uint32_t address);
+
       Spi& spi;
       Identification device_id;
+
+      SemaphoreHandle_t powerMutex = nullptr;
+      // The bootloader may leave the flash in deep power-down
+      bool sleeping = true;
+      bool systemAwake = false;
+      uint8_t users = 0;
     };
   }
 }
@@ -1,7 +1,8 @@
 #include "drivers/St7789.h"
 #include <hal/nrf_gpio.h>
-#include <libraries/delay/nrf_delay.h>
 #include <nrfx_log.h>
+#include <FreeRTOS.h>
+#include <task.h>
 #include "drivers/Spi.h"
 
 using namespace Pinetime::Drivers;
@@ -29,6 +30,11 @@ void St7789::Init() {
   DisplayOn();
 }
 
+void St7789::Delay(uint32_t ms) {
+  // vTaskDelay() can return up to 1 tick early
+  vTaskDelay((ms * configTICK_RATE_HZ + 999) / 1000 + 1);
+}
+
 void St7789::WriteCommand(uint8_t cmd) {
   nrf_gpio_pin_clear(pinDataCommand);
   WriteSpi(&cmd, 1);
@@ -45,7 +51,7 @@ void St7789::WriteSpi(const uint8_t* data, size_t size) {
 
 void St7789::SoftwareReset() {
   WriteCommand(static_cast<uint8_t>(Commands::SoftwareReset));
-  nrf_delay_ms(150);
+  Delay(150);
 }
 
 void St7789::SleepOut() {
@@ -59,7 +65,7 @@ void St7789::SleepIn() {
 void St7789::ColMod() {
   WriteCommand(static_cast<uint8_t>(Commands::ColMod));
   WriteData(0x55);
-  nrf_delay_ms(10);
+  Delay(10);
 }
 
 void St7789::MemoryDataAccessControl() {
@@ -96,12 +102,12 @@ void St7789::RowAddressSet() {
 
 void St7789::DisplayInversionOn() {
   WriteCommand(static_cast<uint8_t>(Commands::DisplayInversionOn));
-  nrf_delay_ms(10);
+  Delay(10);
 }
 
 void St7789::NormalModeOn() {
   WriteCommand(static_cast<uint8_t>(Commands::NormalModeOn));
-  nrf_delay_ms(10);
+  Delay(10);
 }
 
 void St7789::DisplayOn() {
@@ -137,7 +143,7 @@ void St7789::SetVdv() {
 
 void St7789::DisplayOff() {
   WriteCommand(static_cast<uint8_t>(Commands::DisplayOff));
-  nrf_delay_ms(500);
+  Delay(500);
 }
 
 void St7789::VerticalScrollDefinition(uint16_t topFixedLines, uint16_t scrollLines, uint16_t bottomFixedLines) {
@@ -172,14 +178,22 @@ void St7789::DrawPixel(uint16_t x, uint16_t y, uint32_t color) {
 }
 
 void St7789::DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size) {
+  BeginDrawBuffer(x, y, width, height);
+  ContinueDrawBuffer(data, size);
+}
+
+void St7789::BeginDrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height) {
   SetAddrWindow(x, y, x + width - 1, y + height - 1);
   nrf_gpio_pin_set(pinDataCommand);
+}
+
+void St7789::ContinueDrawBuffer(const uint8_t* data, size_t size) {
   WriteSpi(data, size);
 }
 
 void St7789::HardwareReset() {
   nrf_gpio_pin_clear(pinReset);
-  nrf_delay_ms(10);
+  Delay(10);
   nrf_gpio_pin_set(pinReset);
 }
 
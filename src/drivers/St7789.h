@@ -22,6 +22,11 @@ namespace Pinetime {
       void VerticalScrollStartAddress(uint16_t line);
 
       void DrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height, const uint8_t* data, size_t size);
+      // Sets the window in which the pixels sent by the following calls to ContinueDrawBuffer() are drawn, so that a large
+      // area can be drawn in several chunks with a single address window setup.
+      void BeginDrawBuffer(uint16_t x, uint16_t y, uint16_t width, uint16_t height);
+      // The transfer is asynchronous: data must not be modified until the next call to the SPI bus returns.
+      void ContinueDrawBuffer(const uint8_t* data, size_t size);
 
       void Sleep();
       void Wakeup();
@@ -32,6 +37,9 @@ namespace Pinetime {
       uint8_t pinReset;
       uint8_t verticalScrollingStartAddress = 0;
 
+      // Waits for at least ms, letting the other tasks run
+      static void Delay(uint32_t ms);
+
       void HardwareReset();
       void SoftwareReset();
       void SleepOut();
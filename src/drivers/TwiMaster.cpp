@@ -83,10 +83,11 @@ TwiMaster::ErrorCodes TwiMaster::Read(uint8_t deviceAddress, uint8_t* buffer, si
   twiBaseAddress->EVENTS_RXSTARTED = 0x0UL;
 
   txStartedCycleCount = DWT->CYCCNT;
+  const uint32_t freezedDelay = HwFreezedDelay + size * HwFreezedDelayPerByte;
   uint32_t currentCycleCount;
   while (!twiBaseAddress->EVENTS_LASTRX && !twiBaseAddress->EVENTS_ERROR) {
     currentCycleCount = DWT->CYCCNT;
-    if ((currentCycleCount - txStartedCycleCount) > HwFreezedDelay) {
+    if ((currentCycleCount - txStartedCycleCount) > freezedDelay) {
       FixHwFreezed();
       return ErrorCodes::TransactionFailed;
     }
@@ -124,10 +125,11 @@ TwiMaster::ErrorCodes TwiMaster::Write(uint8_t deviceAddress, const uint8_t* dat
   twiBaseAddress->EVENTS_TXSTARTED = 0x0UL;
 
   txStartedCycleCount = DWT->CYCCNT;
+  const uint32_t freezedDelay = HwFreezedDelay + size * HwFreezedDelayPerByte;
   uint32_t currentCycleCount;
   while (!twiBaseAddress->EVENTS_LASTTX && !twiBaseAddress->EVENTS_ERROR) {
     currentCycleCount = DWT->CYCCNT;
-    if ((currentCycleCount - txStartedCycleCount) > HwFreezedDelay) {
+    if ((currentCycleCount - txStartedCycleCount) > freezedDelay) {
       FixHwFreezed();
       return ErrorCodes::TransactionFailed;
     }
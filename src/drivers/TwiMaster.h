@@ -9,6 +9,8 @@ namespace Pinetime {
     class TwiMaster {
     public:
       enum class ErrorCodes { NoError, TransactionFailed };
+      // Maximum size of the data passed to Write()
+      static constexpr uint8_t maxDataSize {64};
 
       TwiMaster(NRF_TWIM_Type* module, uint32_t frequency, uint8_t pinSda, uint8_t pinScl);
 
@@ -31,11 +33,14 @@ namespace Pinetime {
       uint32_t frequency;
       uint8_t pinSda;
       uint8_t pinScl;
-      static constexpr uint8_t maxDataSize {16};
       static constexpr uint8_t registerSize {1};
+      // EasyDMA can only read from RAM: the register address and the data (which is often const, in flash) are copied in
+      // internalBuffer and sent in a single transfer
       uint8_t internalBuffer[maxDataSize + registerSize];
       uint32_t txStartedCycleCount = 0;
       static constexpr uint32_t HwFreezedDelay {161000};
+      // Time to transfer a byte at ~390KHz, in CPU cycles, so that long transfers are not mistaken for a freeze
+      static constexpr uint32_t HwFreezedDelayPerByte {1500};
     };
   }
 }
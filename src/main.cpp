@@ -98,13 +98,14 @@ Pinetime::Applications::HeartRateTask heartRateApp(heartRateSensor, heartRateCon
 
 Pinetime::Controllers::FS fs {spiNorFlash};
 Pinetime::Controllers::Settings settingsController {fs};
-Pinetime::Controllers::MotorController motorController {};
+Pinetime::Controllers::TimerWheel timerWheel;
+Pinetime::Controllers::MotorController motorController;
 
-Pinetime::Controllers::DateTime dateTimeController {settingsController};
+Pinetime::Controllers::DateTime dateTimeController {settingsController, timerWheel};
 Pinetime::Drivers::Watchdog watchdog;
-Pinetime::Controllers::NotificationManager notificationManager;
+Pinetime::Controllers::NotificationManager notificationManager {fs};
 Pinetime::Controllers::MotionController motionController;
-Pinetime::Controllers::AlarmController alarmController {dateTimeController};
+Pinetime::Controllers::AlarmController alarmController {dateTimeController, timerWheel};
 Pinetime::Controllers::TouchHandler touchHandler;
 Pinetime::Controllers::ButtonHandler buttonHandler;
 Pinetime::Controllers::BrightnessController brightnessController {};
@@ -123,7 +124,8 @@ Pinetime::Applications::DisplayApp displayApp(lcd,
                                               alarmController,
                                               brightnessController,
                                               touchHandler,
-                                              fs);
+                                              fs,
+                                              timerWheel);
 
 Pinetime::System::SystemTask systemTask(spi,
                                         spiNorFlash,
@@ -161,9 +163,10 @@ void vApplicationStackOverflowHook(TaskHandle_t /*xTask*/, char* /*pcTaskName*/)
 */
 extern uint32_t __start_noinit_data;
 extern uint32_t __stop_noinit_data;
-static constexpr uint32_t NoInit_MagicValue = 0xDEAD0000;
+static constexpr uint32_t NoInit_MagicValue = 0xDEAD0002;
 uint32_t NoInit_MagicWord __attribute__((section(".noinit")));
 std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> NoInit_BackUpTime __attribute__((section(".noinit")));
+bool NoInit_IsValid = false;
 
 void nrfx_gpiote_evt_handler(nrfx_gpiote_pin_t pin, nrf_gpiote_polarity_t action) {
   if (pin == Pinetime::PinMap::Cst816sIrq) {
@@ -225,6 +228,17 @@ void RTC0_IRQHandler(void) {
   ((void (*)()) rtc0_isr_addr)();
 }
 
+void RTC2_IRQHandler(void) {
+  timerWheel.OnInterrupt();
+}
+
+void PWM0_IRQHandler(void) {
+  if (NRF_PWM0->EVENTS_STOPPED == 1) {
+    NRF_PWM0->EVENTS_STOPPED = 0;
+    motorController.OnStoppedEvent();
+  }
+}
+
 void WDT_IRQHandler(void) {
   nrf_wdt_event_clear(NRF_WDT_EVENT_TIMEOUT);
 }
@@ -322,6 +336,8 @@ int main() {
   while (!nrf_clock_lf_is_running()) {
   }
 
+  timerWheel.Init();
+
 // The RC source for the LF clock has to be calibrated
 #if (CLOCK_CONFIG_LF_SRC == NRF_CLOCK_LFCLK_RC)
   nrf_drv_clock_calibration_start(0, calibrate_lf_clock_rc);
@@ -349,6 +365,7 @@ int main() {
 
   if (NoInit_MagicWord == NoInit_MagicValue) {
     dateTimeController.SetCurrentTime(NoInit_BackUpTime);
+    NoInit_IsValid = true;
   } else {
     // Clear Memory to known state
     memset(&__start_noinit_data, 0, (uintptr_t) &__stop_noinit_data - (uintptr_t) &__start_noinit_data);
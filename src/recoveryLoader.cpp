@@ -11,6 +11,7 @@
 #include <hal/nrf_wdt.h>
 #include <cstring>
 #include <components/gfx/Gfx.h>
+#include <components/gfx/RleBlitter.h>
 #include <drivers/St7789.h>
 #include <components/brightness/BrightnessController.h>
 #include <algorithm>
@@ -49,6 +50,7 @@ Pinetime::Drivers::Spi lcdSpi {spi, Pinetime::PinMap::SpiLcdCsn};
 Pinetime::Drivers::St7789 lcd {lcdSpi, Pinetime::PinMap::LcdDataCommand, Pinetime::PinMap::LcdReset};
 
 Pinetime::Components::Gfx gfx {lcd};
+Pinetime::Components::RleBlitter blitter {lcd};
 Pinetime::Controllers::BrightnessController brightnessController;
 
 void DisplayProgressBar(uint8_t percent, uint16_t color);
@@ -98,8 +100,11 @@ void Process(void* /*instance*/) {
   DisplayLogo();
 
   NRF_LOG_INFO("Erasing...");
-  for (uint32_t erased = 0; erased < sizeof(recoveryImage); erased += 0x1000) {
-    spiNorFlash.SectorErase(erased);
+  // Erase by 64 KB blocks to keep refreshing the watchdog, EraseRange() uses sectors for the end of the image
+  static constexpr uint32_t eraseSize =
+    (sizeof(recoveryImage) + Pinetime::Drivers::SpiNorFlash::sectorSize - 1) & ~(Pinetime::Drivers::SpiNorFlash::sectorSize - 1);
+  for (uint32_t erased = 0; erased < eraseSize; erased += Pinetime::Drivers::SpiNorFlash::block64KSize) {
+    spiNorFlash.EraseRange(erased, std::min(eraseSize - erased, Pinetime::Drivers::SpiNorFlash::block64KSize));
     RefreshWatchdog();
   }
 
@@ -122,11 +127,7 @@ void Process(void* /*instance*/) {
 
 void DisplayLogo() {
   Pinetime::Tools::RleDecoder rleDecoder(infinitime_nb, sizeof(infinitime_nb));
-  for (int i = 0; i < displayWidth; i++) {
-    rleDecoder.DecodeNext(displayBuffer, displayWidth * bytesPerPixel);
-    ulTaskNotifyTake(pdTRUE, 500);
-    lcd.DrawBuffer(0, i, displayWidth, 1, reinterpret_cast<const uint8_t*>(displayBuffer), displayWidth * bytesPerPixel);
-  }
+  blitter.Draw(rleDecoder, 0, 0, displayWidth, displayHeight);
 }
 
 void DisplayProgressBar(uint8_t percent, uint16_t color) {
@@ -8,6 +8,8 @@ import typing
 import os.path
 import argparse
 import subprocess
+import re
+import struct
 
 class Source(object):
     def __init__(self, d):
@@ -34,6 +36,73 @@ def gen_lvconv_line(lv_font_conv: str, dest: str, size: int, bpp: int, format: s
 
     return args
 
+def parse_c_array(source: str, name: str) -> typing.List[int]:
+    match = re.search(r'\b' + name + r'\[\]\s*=\s*\{(.*?)\};', source, re.S)
+    if not match:
+        return []
+    body = re.sub(r'/\*.*?\*/', '', match.group(1), flags=re.S)
+    return [int(value, 0) for value in re.findall(r'-?(?:0x[0-9a-fA-F]+|\d+)', body)]
+
+
+def convert_to_pack(source_path: str, dest: str, bpp: int):
+    """Converts a font generated by lv_font_conv (format lvgl, not compressed) to the glyph pack read by
+    Components::FontPack: a header, an index of the glyphs sorted by code point, and the glyph bitmaps."""
+    with open(source_path, 'r') as fd:
+        source = fd.read()
+
+    bitmaps = bytes(parse_c_array(source, 'glyph_bitmap'))
+    glyphs = []
+    for dsc in re.findall(r'\{(\.bitmap_index[^}]*)\}', source):
+        fields = dict((key, int(value)) for key, value in re.findall(r'\.(\w+)\s*=\s*(-?\d+)', dsc))
+        glyphs.append(fields)
+
+    code_points = {}
+    for cmap in re.findall(r'\{\s*(\.range_start[^}]*)\}', source, re.S):
+        fields = dict(re.findall(r'\.(\w+)\s*=\s*([\w-]+)', cmap))
+        range_start = int(fields['range_start'])
+        range_length = int(fields['range_length'])
+        glyph_id_start = int(fields['glyph_id_start'])
+        unicode_list = parse_c_array(source, fields['unicode_list']) if fields['unicode_list'] != 'NULL' else []
+        id_list = parse_c_array(source, fields['glyph_id_ofs_list']) if fields['glyph_id_ofs_list'] != 'NULL' else []
+        cmap_type = fields['type']
+        if cmap_type.endswith('FORMAT0_TINY'):
+            for i in range(range_length):
+                code_points[range_start + i] = glyph_id_start + i
+        elif cmap_type.endswith('FORMAT0_FULL'):
+            for i in range(range_length):
+                code_points[range_start + i] = glyph_id_start + id_list[i]
+        elif cmap_type.endswith('SPARSE_TINY'):
+            for i, offset in enumerate(unicode_list):
+                code_points[range_start + offset] = glyph_id_start + i
+        elif cmap_type.endswith('SPARSE_FULL'):
+            for i, offset in enumerate(unicode_list):
+                code_points[range_start + offset] = glyph_id_start + id_list[i]
+        else:
+            sys.exit(f'Error: unsupported cmap type {cmap_type} in {source_path}')
+
+    def font_field(name):
+        match = re.search(r'\.' + name + r'\s*=\s*(-?\d+)', source)
+        return int(match.group(1)) if match else 0
+
+    header_size = 16
+    entry_size = 16
+    bitmap_start = header_size + entry_size * len(code_points)
+
+    header = struct.pack('<IHBBhhbBH', 0x4b504647, len(code_points), bpp, 1, font_field('line_height'),
+                         font_field('base_line'), font_field('underline_position'), font_field('underline_thickness'), 0)
+    index = b''
+    data = b''
+    for code_point in sorted(code_points):
+        glyph = glyphs[code_points[code_point]]
+        size = (glyph['box_w'] * glyph['box_h'] * bpp + 7) // 8
+        index += struct.pack('<IIHBBbbH', code_point, bitmap_start + len(data), glyph['adv_w'], glyph['box_w'], glyph['box_h'],
+                             glyph['ofs_x'], glyph['ofs_y'], 0)
+        data += bitmaps[glyph['bitmap_index']:glyph['bitmap_index'] + size]
+
+    with open(dest, 'wb') as fd:
+        fd.write(header + index + data)
+
+
 def main():
     ap = argparse.ArgumentParser(description='auto generate LVGL font files from fonts')
     ap.add_argument('config', type=str, help='config file to use')
@@ -66,10 +135,17 @@ def main():
         sources = font.pop('sources')
         patches = font.pop('patches') if 'patches' in font else  []
         font['sources'] = [Source(thing) for thing in sources]
-        extension = 'c' if font['format'] != 'bin' else 'bin'
+        extension = 'c' if font['format'] not in ('bin', 'pack') else 'bin'
         font.pop('target_path')
-        line = gen_lvconv_line(args.lv_font_conv, f'{name}.{extension}', **font)
-        subprocess.check_call(line)
+        if font['format'] == 'pack':
+            # Glyph packs are built from the C output of lv_font_conv, which describes each glyph plainly
+            font['format'] = 'lvgl'
+            line = gen_lvconv_line(args.lv_font_conv, f'{name}.pack.c', **font)
+            subprocess.check_call(line)
+            convert_to_pack(f'{name}.pack.c', f'{name}.{extension}', font['bpp'])
+        else:
+            line = gen_lvconv_line(args.lv_font_conv, f'{name}.{extension}', **font)
+            subprocess.check_call(line)
         if patches:
             for patch in patches:
                 subprocess.check_call(['/usr/bin/env', 'patch', name+'.'+extension, patch])
@@ -1,9 +1,30 @@
 #!/usr/bin/env python3
 import argparse
 import pathlib
+import struct
 import sys
 import decimal
-from PIL import Image
+
+# LVGL color formats (lv_img_cf_t)
+LV_CF = {
+    "CF_TRUE_COLOR": 4,
+    "CF_TRUE_COLOR_ALPHA": 5,
+    "CF_INDEXED_1_BIT": 7,
+    "CF_INDEXED_2_BIT": 8,
+    "CF_INDEXED_4_BIT": 9,
+    "CF_INDEXED_8_BIT": 10,
+}
+INDEXED_BITS = {
+    "CF_INDEXED_1_BIT": 1,
+    "CF_INDEXED_2_BIT": 2,
+    "CF_INDEXED_4_BIT": 4,
+    "CF_INDEXED_8_BIT": 8,
+}
+
+# Images compressed row by row, decoded by src/displayapp/ImageDecoder.cpp
+LV_CF_USER_ENCODED_0 = 24
+COMPRESSIONS = {"none": 0, "rle": 1, "lz4": 2}
+ROWS_PER_INDEX = 16
 
 
 def classify_pixel(value, bits):
@@ -23,6 +44,261 @@ def classify_pixel(value, bits):
     return val
 
 
+def rgb565_rbswap(r, g, b):
+    """RGB565 color, most significant byte first (LV_COLOR_16_SWAP)"""
+    r_act = min(classify_pixel(r, 5), 0xF8)
+    g_act = min(classify_pixel(g, 6), 0xFC)
+    b_act = min(classify_pixel(b, 5), 0xF8)
+    c16 = ((r_act) << 8) | ((g_act) << 3) | ((b_act) >> 3) # RGR565
+    return bytes([(c16 >> 8) & 0xFF, c16 & 0xFF])
+
+
+def convert_true_color(img, alpha):
+    """:return: the palette (empty) and the rows, 2 bytes (+ alpha) per pixel"""
+    img = img.convert("RGBA")
+    rows = []
+    for y in range(img.height):
+        row = bytearray()
+        for x in range(img.width):
+            r, g, b, a = img.getpixel((x, y))
+            row += rgb565_rbswap(r, g, b)
+            if alpha:
+                row.append(a)
+        rows.append(bytes(row))
+    return b"", rows
+
+
+def convert_indexed_1_bit(img):
+    """Black and transparent / white and opaque, from the lowest bit of the first channel"""
+    w = (img.width + 7) >> 3
+    rows = []
+    for y in range(img.height):
+        row = bytearray(w)
+        for x in range(img.width):
+            c, a = img.getpixel((x,y))
+            row[x >> 3] |= (c & 0x1) << (7 - (x & 0x7))
+        rows.append(bytes(row))
+    # write palette information, for indexed-1-bit we need palette with two values
+    # Normally there is much math behind this, but for the current use case this is close enough
+    # only needs to be more complicated if we have more than 2 colors in the palette
+    palette = bytes([0, 0, 0, 0, 255, 255, 255, 255])
+    return palette, rows
+
+
+def convert_indexed(img, bits):
+    """:return: the palette (BGRA) and the rows of indices, or None if the image has too many colors"""
+    img = img.convert("RGBA")
+    colors = {}
+    indices = []
+    for y in range(img.height):
+        for x in range(img.width):
+            pixel = img.getpixel((x, y))
+            if pixel not in colors:
+                if len(colors) == (1 << bits):
+                    return None
+                colors[pixel] = len(colors)
+            indices.append(colors[pixel])
+
+    palette = bytearray(4 << bits)
+    for (r, g, b, a), i in colors.items():
+        palette[i * 4:i * 4 + 4] = bytes([b, g, r, a])
+
+    pixels_per_byte = 8 // bits
+    rows = []
+    for y in range(img.height):
+        row = bytearray((img.width * bits + 7) // 8)
+        for x in range(img.width):
+            shift = 8 - bits * (x % pixels_per_byte + 1)
+            row[x // pixels_per_byte] |= indices[y * img.width + x] << shift
+        rows.append(bytes(row))
+    return bytes(palette), rows
+
+
+def rle_encode(data, unit):
+    """Control byte n, followed by n + 1 literal units (n < 0x80) or by a unit repeated (n & 0x7F) + 2 times"""
+    units = [data[i:i + unit] for i in range(0, len(data), unit)]
+    out = bytearray()
+    literals = []
+
+    def flush():
+        while literals:
+            chunk = literals[:128]
+            out.append(len(chunk) - 1)
+            out.extend(b"".join(chunk))
+            del literals[:128]
+
+    i = 0
+    while i < len(units):
+        run = 1
+        while i + run < len(units) and units[i + run] == units[i] and run < 129:
+            run += 1
+        if run >= 2:
+            flush()
+            out.append(0x80 | (run - 2))
+            out.extend(units[i])
+            i += run
+        else:
+            literals.append(units[i])
+            i += 1
+    flush()
+    return bytes(out)
+
+
+def rle_decode(data, unit):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        n = data[i]
+        i += 1
+        if n & 0x80:
+            out.extend(data[i:i + unit] * ((n & 0x7F) + 2))
+            i += unit
+        else:
+            out.extend(data[i:i + (n + 1) * unit])
+            i += (n + 1) * unit
+    return bytes(out)
+
+
+def lz4_compress(data):
+    """LZ4 block format, greedy matching"""
+    def append_length(out, length):
+        while length >= 255:
+            out.append(255)
+            length -= 255
+        out.append(length)
+
+    def emit(out, literals, offset=0, match_length=0):
+        token = min(len(literals), 15) << 4
+        if offset:
+            token |= min(match_length - 4, 15)
+        out.append(token)
+        if len(literals) >= 15:
+            append_length(out, len(literals) - 15)
+        out.extend(literals)
+        if offset:
+            out.extend(struct.pack("<H", offset))
+            if match_length - 4 >= 15:
+                append_length(out, match_length - 4 - 15)
+
+    n = len(data)
+    out = bytearray()
+    table = {}
+    anchor = 0
+    i = 0
+    # The format requires the last match to start 12 bytes before the end, and the last 5 bytes to be literals
+    while i + 12 <= n:
+        key = data[i:i + 4]
+        candidate = table.get(key)
+        table[key] = i
+        if candidate is not None and i - candidate <= 0xFFFF:
+            length = 4
+            while i + length < n - 5 and data[candidate + length] == data[i + length]:
+                length += 1
+            emit(out, data[anchor:i], i - candidate, length)
+            i += length
+            anchor = i
+        else:
+            i += 1
+    emit(out, data[anchor:])
+    return bytes(out)
+
+
+def lz4_decompress(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        token = data[i]
+        i += 1
+        length = token >> 4
+        if length == 15:
+            while True:
+                length += data[i]
+                i += 1
+                if data[i - 1] != 255:
+                    break
+        out.extend(data[i:i + length])
+        i += length
+        if i >= len(data):
+            break
+        offset = data[i] | (data[i + 1] << 8)
+        i += 2
+        length = token & 0x0F
+        if length == 15:
+            while True:
+                length += data[i]
+                i += 1
+                if data[i - 1] != 255:
+                    break
+        for _ in range(length + 4):
+            out.append(out[-offset])
+    return bytes(out)
+
+
+def lv_header(lv_cf, width, height):
+    return struct.pack("<I", lv_cf | (width << 10) | (height << 21))
+
+
+def encode_plain(lv_cf, width, height, palette, rows):
+    """Standard LVGL binary image, read by the built-in decoder of LVGL"""
+    return lv_header(lv_cf, width, height) + palette + b"".join(rows)
+
+
+def encode_compressed(lv_cf, width, height, palette, rows, compression):
+    """
+    LVGL header (LV_IMG_CF_USER_ENCODED_0)
+    format (lv_img_cf_t of the rows), compression, rows per index entry, 0, size of the largest row (uint16), 0 (uint16)
+    palette (indexed formats)
+    offset of every ROWS_PER_INDEX-th row from the start of the file (uint32)
+    rows: size (uint16) and compressed data
+    """
+    unit = 3 if lv_cf == LV_CF["CF_TRUE_COLOR_ALPHA"] else 2 if lv_cf == LV_CF["CF_TRUE_COLOR"] else 1
+    if compression == "rle":
+        payloads = [rle_encode(row, unit) for row in rows]
+    elif compression == "lz4":
+        payloads = [lz4_compress(row) for row in rows]
+    else:
+        payloads = rows
+
+    max_size = max(len(p) for p in payloads)
+    nb_index = (height + ROWS_PER_INDEX - 1) // ROWS_PER_INDEX
+    offset = 4 + 8 + len(palette) + 4 * nb_index
+    index = bytearray()
+    data = bytearray()
+    for y, payload in enumerate(payloads):
+        if y % ROWS_PER_INDEX == 0:
+            index += struct.pack("<I", offset + len(data))
+        data += struct.pack("<H", len(payload)) + payload
+
+    header = struct.pack("<BBBBHH", lv_cf, COMPRESSIONS[compression], ROWS_PER_INDEX, 0, max_size, 0)
+    return lv_header(LV_CF_USER_ENCODED_0, width, height) + header + palette + bytes(index) + bytes(data)
+
+
+def color_format_candidates(img, color_format):
+    """:return: the conversions of the image to try, as tuples (color format, palette, rows)"""
+    if color_format == "CF_TRUE_COLOR_ALPHA":
+        return [(color_format, *convert_true_color(img, True))]
+    if color_format == "CF_TRUE_COLOR":
+        return [(color_format, *convert_true_color(img, False))]
+    if color_format == "CF_INDEXED_1_BIT":
+        return [(color_format, *convert_indexed_1_bit(img))]
+    if color_format in INDEXED_BITS:
+        converted = convert_indexed(img, INDEXED_BITS[color_format])
+        if converted is None:
+            sys.exit(f"Error: the image has more than {1 << INDEXED_BITS[color_format]} colors")
+        return [(color_format, *converted)]
+
+    # CF_AUTO: the smallest palette that holds all the colors, and true color
+    opaque = all(pixel[3] == 255 for pixel in img.convert("RGBA").getdata())
+    candidates = [("CF_TRUE_COLOR", *convert_true_color(img, False))] if opaque else []
+    candidates.append(("CF_TRUE_COLOR_ALPHA", *convert_true_color(img, True)))
+    for name in ["CF_INDEXED_1_BIT", "CF_INDEXED_2_BIT", "CF_INDEXED_4_BIT", "CF_INDEXED_8_BIT"]:
+        converted = convert_indexed(img, INDEXED_BITS[name])
+        if converted is not None:
+            candidates.append((name, *converted))
+            break
+    return candidates
+
+
 def test_classify_pixel():
     # test difference between round() and round_half_up()
     assert classify_pixel(18, 5) == 16
@@ -30,6 +306,24 @@ def test_classify_pixel():
     assert classify_pixel(18, 6) == 20
 
 
+def test_compression():
+    samples = [
+        b"",
+        b"\x01",
+        bytes(240 * 3),
+        bytes(range(256)) * 3,
+        b"\x00\x00\xff" * 40 + bytes(range(60)) + b"\x12\x34\x56" * 200,
+        bytes((i * 7) & 0xF0 for i in range(720)),
+    ]
+    for sample in samples:
+        assert lz4_decompress(lz4_compress(sample)) == sample
+        assert rle_decode(rle_encode(sample, 1), 1) == sample
+        if len(sample) % 3 == 0:
+            assert rle_decode(rle_encode(sample, 3), 3) == sample
+    assert len(rle_encode(bytes(240 * 3), 3)) == 2 * 4
+    assert len(lz4_compress(bytes(720))) < 20
+
+
 def main():
     parser = argparse.ArgumentParser()
 
@@ -44,13 +338,13 @@ def main():
     parser.add_argument("-i", "--image-name",
         help="name of image structure (not implemented)")
     parser.add_argument("-c", "--color-format",
-        help="color format of image",
+        help="color format of image, CF_AUTO for the smallest one that represents the image exactly",
         default="CF_TRUE_COLOR_ALPHA",
         choices=[
             "CF_ALPHA_1_BIT", "CF_ALPHA_2_BIT", "CF_ALPHA_4_BIT",
             "CF_ALPHA_8_BIT", "CF_INDEXED_1_BIT", "CF_INDEXED_2_BIT", "CF_INDEXED_4_BIT",
             "CF_INDEXED_8_BIT", "CF_RAW", "CF_RAW_CHROMA", "CF_RAW_ALPHA",
-            "CF_TRUE_COLOR", "CF_TRUE_COLOR_ALPHA", "CF_TRUE_COLOR_CHROMA", "CF_RGB565A8",
+            "CF_TRUE_COLOR", "CF_TRUE_COLOR_ALPHA", "CF_TRUE_COLOR_CHROMA", "CF_RGB565A8", "CF_AUTO",
         ],
         required=True)
     parser.add_argument("-t", "--output-format",
@@ -61,6 +355,10 @@ def main():
         help="binary color format (needed if output-format is binary)",
         default="ARGB8565_RBSWAP",
         choices=["ARGB8332", "ARGB8565", "ARGB8565_RBSWAP", "ARGB8888"])
+    parser.add_argument("--compression",
+        help="compression of the rows, auto for the smallest file (compressed images need the decoder of InfiniTime)",
+        default="none",
+        choices=["none", "rle", "lz4", "auto"])
     parser.add_argument("-s", "--swap-endian",
         help="swap endian of image (not implemented)",
         action="store_true")
@@ -79,12 +377,12 @@ def main():
         if args.force:
             print(f"overwriting {args.output_file}")
         else:
-            pritn(f"Error: refusing to overwrite {args.output_file} without -f specified.")
+            print(f"Error: refusing to overwrite {args.output_file} without -f specified.")
             return 1
     out.touch()
 
     # only implemented the bare minimum, everything else is not implemented
-    if args.color_format not in ["CF_INDEXED_1_BIT", "CF_TRUE_COLOR_ALPHA"]:
+    if args.color_format not in ["CF_AUTO", "CF_TRUE_COLOR", "CF_TRUE_COLOR_ALPHA"] + list(INDEXED_BITS):
         raise NotImplementedError(f"argument --color-format '{args.color_format}' not implemented")
     if args.output_format != "bin":
         raise NotImplementedError(f"argument --output-format '{args.output_format}' not implemented")
@@ -97,11 +395,15 @@ def main():
     if args.dither:
         raise NotImplementedError(f"argument --dither not implemented")
 
-    # open image using Pillow
+    # open image using Pillow, imported here so that the encoders can be used (and tested) without it
+    from PIL import Image
     img = Image.open(img_path)
     img_height = img.height
     img_width = img.width
+
     if args.color_format == "CF_TRUE_COLOR_ALPHA" and args.binary_format == "ARGB8888":
+        if args.compression != "none":
+            raise NotImplementedError(f"argument --compression '{args.compression}' not implemented for ARGB8888")
         buf = bytearray(img_height*img_width*4) # 4 bytes (32 bit) per pixel
         for y in range(img_height):
             for x in range(img_width):
@@ -112,69 +414,21 @@ def main():
                 buf[i + 1] = g
                 buf[i + 2] = b
                 buf[i + 3] = a
-
-    elif args.color_format == "CF_TRUE_COLOR_ALPHA" and args.binary_format == "ARGB8565_RBSWAP":
-        buf = bytearray(img_height*img_width*3) # 3 bytes (24 bit) per pixel
-        for y in range(img_height):
-            for x in range(img_width):
-                i = (y*img_width + x)*3 # buffer-index
-                pixel = img.getpixel((x,y))
-                r_act = classify_pixel(pixel[0], 5)
-                g_act = classify_pixel(pixel[1], 6)
-                b_act = classify_pixel(pixel[2], 5)
-                a = pixel[3]
-                r_act = min(r_act, 0xF8)
-                g_act = min(g_act, 0xFC)
-                b_act = min(b_act, 0xF8)
-                c16 = ((r_act) << 8) | ((g_act) << 3) | ((b_act) >> 3) # RGR565
-                buf[i + 0] = (c16 >> 8) & 0xFF
-                buf[i + 1] = c16 & 0xFF
-                buf[i + 2] = a
-
-    elif args.color_format == "CF_INDEXED_1_BIT": # ignore binary format, use color format as binary format
-        w = img_width >> 3
-        if img_width & 0x07:
-            w+=1
-        max_p = w * (img_height-1) + ((img_width-1) >> 3) + 8  # +8 for the palette
-        buf = bytearray(max_p+1)
-
-        for y in range(img_height):
-            for x in range(img_width):
-                c, a = img.getpixel((x,y))
-                p = w * y + (x >> 3) + 8  # +8 for the palette
-                buf[p] |= (c & 0x1) << (7 - (x & 0x7))
-        # write palette information, for indexed-1-bit we need palette with two values
-        # write 8 palette bytes
-        buf[0] = 0
-        buf[1] = 0
-        buf[2] = 0
-        buf[3] = 0
-        # Normally there is much math behind this, but for the current use case this is close enough
-        # only needs to be more complicated if we have more than 2 colors in the palette
-        buf[4] = 255
-        buf[5] = 255
-        buf[6] = 255
-        buf[7] = 255
+        buf_out = lv_header(LV_CF["CF_TRUE_COLOR_ALPHA"], img_width, img_height) + buf
     else:
-        # raise just to be sure
-        raise NotImplementedError(f"args.color_format '{args.color_format}' with args.binary_format '{args.binary_format}' not implemented")
-
-    # write header
-    match args.color_format:
-        case "CF_TRUE_COLOR_ALPHA":
-            lv_cf = 5
-        case "CF_INDEXED_1_BIT":
-            lv_cf = 7
-        case _:
-            # raise just to be sure
-            raise NotImplementedError(f"args.color_format '{args.color_format}' not implemented")
-    header_32bit = lv_cf | (img_width << 10) | (img_height << 21)
-    buf_out = bytearray(4 + len(buf))
-    buf_out[0] = header_32bit & 0xFF
-    buf_out[1] = (header_32bit & 0xFF00) >> 8
-    buf_out[2] = (header_32bit & 0xFF0000) >> 16
-    buf_out[3] = (header_32bit & 0xFF000000) >> 24
-    buf_out[4:] = buf
+        # the indexed formats ignore the binary format and use the color format as binary format
+        compressions = ["none", "rle", "lz4"] if args.compression == "auto" else [args.compression]
+        variants = []
+        for color_format, palette, rows in color_format_candidates(img, args.color_format):
+            lv_cf = LV_CF[color_format]
+            for compression in compressions:
+                if compression == "none":
+                    data = encode_plain(lv_cf, img_width, img_height, palette, rows)
+                else:
+                    data = encode_compressed(lv_cf, img_width, img_height, palette, rows, compression)
+                variants.append((len(data), color_format, compression, data))
+        size, color_format, compression, buf_out = min(variants, key=lambda v: v[0])
+        print(f"{color_format}, compression {compression}: {size} bytes")
 
     # write byte buffer to file
     with open(out, "wb") as f:
@@ -187,6 +441,7 @@ if __name__ == '__main__':
         # run small set of tests and exit
         print("running tests")
         test_classify_pixel()
+        test_compression()
         print("success!")
         sys.exit(0)
     # run normal program
@@ -0,0 +1,73 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <FreeRTOS.h>
+#include <task.h>
+
+namespace Pinetime {
+  namespace System {
+    /**
+     * Start and end of each stage of the boot, in ms since the scheduler was started.
+     * The stages are recorded by the task that runs them (SystemTask, or DisplayApp for the display), and some of them overlap.
+     */
+    class BootProfile {
+    public:
+      enum class Stages : uint8_t { Flash, FileSystem, Settings, Display, ClockFace, Ble, Touch, Motion, HeartRate };
+      static constexpr uint8_t nbStages = static_cast<uint8_t>(Stages::HeartRate) + 1;
+
+      struct Stage {
+        uint32_t start = 0;
+        uint32_t end = 0;
+      };
+
+      void Begin(Stages stage) {
+        stages[static_cast<uint8_t>(stage)].start = Now();
+      }
+
+      void End(Stages stage) {
+        stages[static_cast<uint8_t>(stage)].end = Now();
+      }
+
+      // For the stages that are a single event, like the first frame of the clock face
+      void Mark(Stages stage) {
+        const uint32_t now = Now();
+        stages[static_cast<uint8_t>(stage)] = {now, now};
+      }
+
+      Stage Get(Stages stage) const {
+        return stages[static_cast<uint8_t>(stage)];
+      }
+
+      static const char* Name(Stages stage) {
+        switch (stage) {
+          case Stages::Flash:
+            return "Flash";
+          case Stages::FileSystem:
+            return "FS";
+          case Stages::Settings:
+            return "Settings";
+          case Stages::Display:
+            return "Display";
+          case Stages::ClockFace:
+            return "Clock";
+          case Stages::Ble:
+            return "BLE";
+          case Stages::Touch:
+            return "Touch";
+          case Stages::Motion:
+            return "Motion";
+          case Stages::HeartRate:
+            return "HRS";
+        }
+        return "???";
+      }
+
+    private:
+      static uint32_t Now() {
+        return xTaskGetTickCount() * 1000 / configTICK_RATE_HZ;
+      }
+
+      std::array<Stage, nbStages> stages {};
+    };
+  }
+}
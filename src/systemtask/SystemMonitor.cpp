@@ -1,15 +1,20 @@
 #include "systemtask/SystemTask.h"
+#include <cstddef>
+#include <heap_infinitime.h>
 #if configUSE_TRACE_FACILITY == 1
   // FreeRtosMonitor
   #include <FreeRTOS.h>
   #include <task.h>
+  #include <algorithm>
+  #include <cstring>
   #include <nrf_log.h>
 
 void Pinetime::System::SystemMonitor::Process() {
   if (xTaskGetTickCount() - lastTick > 10000) {
     NRF_LOG_INFO("---------------------------------------\nFree heap : %d", xPortGetFreeHeapSize());
-    TaskStatus_t tasksStatus[10];
-    auto nb = uxTaskGetSystemState(tasksStatus, 10, nullptr);
+    TaskStatus_t tasksStatus[maxTasks];
+    uint32_t totalRunTime = 0;
+    auto nb = uxTaskGetSystemState(tasksStatus, maxTasks, &totalRunTime);
     for (uint32_t i = 0; i < nb; i++) {
       NRF_LOG_INFO("Task [%s] - %d", tasksStatus[i].pcTaskName, tasksStatus[i].usStackHighWaterMark);
       if (tasksStatus[i].usStackHighWaterMark < 20)
@@ -17,11 +22,97 @@ void Pinetime::System::SystemMonitor::Process() {
                      tasksStatus[i].pcTaskName,
                      tasksStatus[i].usStackHighWaterMark * 4);
     }
+  #if configGENERATE_RUN_TIME_STATS == 1
+    UpdateLoads(tasksStatus, nb, totalRunTime);
+  #endif
     lastTick = xTaskGetTickCount();
   }
 }
+
+  #if configGENERATE_RUN_TIME_STATS == 1
+void Pinetime::System::SystemMonitor::UpdateLoads(const TaskStatus_t* tasksStatus, uint8_t nb, uint32_t totalRunTime) {
+  // The run time counters wrap around, only their difference over the period is meaningful
+  const uint32_t elapsed = totalRunTime - previousTotalRunTime;
+
+  std::array<TaskLoad, maxTasks> loads;
+  std::array<TaskRunTime, maxTasks> runTimes;
+  for (uint8_t i = 0; i < nb; i++) {
+    uint32_t previousRunTime = 0;
+    for (uint8_t j = 0; j < nbPreviousRunTimes; j++) {
+      if (previousRunTimes[j].number == tasksStatus[i].xTaskNumber) {
+        previousRunTime = previousRunTimes[j].runTime;
+        break;
+      }
+    }
+    const uint32_t runTime = tasksStatus[i].ulRunTimeCounter - previousRunTime;
+
+    loads[i].number = tasksStatus[i].xTaskNumber;
+    std::strncpy(loads[i].name, tasksStatus[i].pcTaskName, sizeof(loads[i].name) - 1);
+    loads[i].name[sizeof(loads[i].name) - 1] = '\0';
+    loads[i].load = (elapsed == 0) ? 0 : std::min<uint64_t>(static_cast<uint64_t>(runTime) * 1000 / elapsed, 1000);
+    runTimes[i] = {static_cast<uint8_t>(tasksStatus[i].xTaskNumber), tasksStatus[i].ulRunTimeCounter};
+  }
+  std::sort(loads.begin(), loads.begin() + nb, [](const TaskLoad& lhs, const TaskLoad& rhs) {
+    return lhs.number < rhs.number;
+  });
+  previousRunTimes = runTimes;
+  nbPreviousRunTimes = nb;
+  previousTotalRunTime = totalRunTime;
+
+  // The loads are read by DisplayApp and the BLE host task
+  taskENTER_CRITICAL();
+  taskLoads = loads;
+  nbTaskLoads = nb;
+  taskEXIT_CRITICAL();
+}
+
+uint8_t Pinetime::System::SystemMonitor::GetTaskLoads(std::array<TaskLoad, maxTasks>& loads) const {
+  taskENTER_CRITICAL();
+  loads = taskLoads;
+  const uint8_t nb = nbTaskLoads;
+  taskEXIT_CRITICAL();
+  return nb;
+}
+  #else
+uint8_t Pinetime::System::SystemMonitor::GetTaskLoads(std::array<TaskLoad, maxTasks>& /*loads*/) const {
+  return 0;
+}
+  #endif
 #else
 // DummyMonitor
 void Pinetime::System::SystemMonitor::Process() {
 }
+
+uint8_t Pinetime::System::SystemMonitor::GetTaskLoads(std::array<TaskLoad, maxTasks>& /*loads*/) const {
+  return 0;
+}
+#endif
+
+#if configHEAP_PROFILER == 1
+void Pinetime::System::SystemMonitor::SaveHeapFailure(Controllers::FS& fs) {
+  if (xTaskGetTickCount() - lastHeapFailureCheck < 10000) {
+    return;
+  }
+  lastHeapFailureCheck = xTaskGetTickCount();
+
+  // Too large for the stack of the system task
+  static HeapFailure_t failure;
+  vPortGetLastHeapFailure(&failure);
+  if (failure.ulFailures == nbSavedHeapFailures) {
+    return;
+  }
+  nbSavedHeapFailures = failure.ulFailures;
+
+  // Same encoding as the last heap failure characteristic of the system stats service
+  const size_t size = offsetof(HeapFailure_t, xSnapshot.xTags) + failure.xSnapshot.ulNbTags * sizeof(HeapTagStats_t);
+  lfs_file_t file;
+  if (fs.FileOpen(&file, "/heapfail.bin", LFS_O_WRONLY | LFS_O_CREAT | LFS_O_TRUNC) != LFS_ERR_OK) {
+    return;
+  }
+  fs.FileWrite(&file, reinterpret_cast<const uint8_t*>(&failure), size);
+  fs.FileClose(&file);
+}
+#else
+void Pinetime::System::SystemMonitor::SaveHeapFailure(Controllers::FS& /*fs*/) {
+}
 #endif
@@ -1,15 +1,60 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <FreeRTOS.h> // declares configUSE_TRACE_FACILITY
 #include <task.h>
 
 namespace Pinetime {
+  namespace Controllers {
+    class FS;
+  }
+
   namespace System {
     class SystemMonitor {
     public:
+      static constexpr uint8_t maxTasks = 10;
+
+      struct TaskLoad {
+        uint8_t number;
+        char name[configMAX_TASK_NAME_LEN];
+        // CPU time used by the task during the last period, in 1/10 %
+        uint16_t load;
+      };
+
       void Process();
-#if configUSE_TRACE_FACILITY == 1
+
+      /**
+       * Copies the CPU load of each task, measured during the last period (10s), ordered by task number.
+       * The run time of the idle task includes the time spent in sleep mode.
+       * @return the number of tasks copied in loads
+       */
+      uint8_t GetTaskLoads(std::array<TaskLoad, maxTasks>& loads) const;
+
+      // Saves the record of the last failed heap allocation to /heapfail.bin when there is a new one (heap profiler builds only)
+      void SaveHeapFailure(Controllers::FS& fs);
+
     private:
+#if configHEAP_PROFILER == 1
+      TickType_t lastHeapFailureCheck = 0;
+      uint32_t nbSavedHeapFailures = 0;
+#endif
+#if configUSE_TRACE_FACILITY == 1
       mutable TickType_t lastTick = 0;
+  #if configGENERATE_RUN_TIME_STATS == 1
+      struct TaskRunTime {
+        uint8_t number;
+        uint32_t runTime;
+      };
+
+      void UpdateLoads(const TaskStatus_t* tasksStatus, uint8_t nb, uint32_t totalRunTime);
+
+      std::array<TaskRunTime, maxTasks> previousRunTimes {};
+      uint8_t nbPreviousRunTimes = 0;
+      uint32_t previousTotalRunTime = 0;
+
+      std::array<TaskLoad, maxTasks> taskLoads {};
+      uint8_t nbTaskLoads = 0;
+  #endif
 #endif
     };
   }
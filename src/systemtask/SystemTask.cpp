@@ -17,6 +17,7 @@
 #include "main.h"
 #include "BootErrors.h"
 
+#include <algorithm>
 #include <memory>
 
 using namespace Pinetime::System;
@@ -25,6 +26,22 @@ namespace {
   inline bool in_isr() {
     return (SCB->ICSR & SCB_ICSR_VECTACTIVE_Msk) != 0;
   }
+
+  // Records of the record store, never change their layout without changing their key
+  struct TimeRecord {
+    int64_t seconds;
+  };
+
+  struct StepsRecord {
+    // Day (since the epoch) of the steps, they are only restored on the same day
+    uint32_t day;
+    uint32_t steps;
+    uint32_t tripSteps;
+  };
+
+  int64_t Seconds(std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> time) {
+    return std::chrono::duration_cast<std::chrono::seconds>(time.time_since_epoch()).count();
+  }
 }
 
 void MeasureBatteryTimerCallback(TimerHandle_t xTimer) {
@@ -104,14 +121,43 @@ void SystemTask::Work() {
   NRF_LOG_INFO("Last reset reason : %s", Pinetime::Drivers::ResetReasonToString(watchdog.GetResetReason()));
   APP_GPIOTE_INIT(2);
 
+  // The stages are ordered by dependency. The display is started as soon as the settings it needs are loaded: it is
+  // initialized by DisplayApp on the SPI bus while the devices on the TWI bus are initialized here, and the clock face is
+  // shown during the delays of their initialization. Both tasks use the file system from there (fonts and images on one side,
+  // BLE bonds and records on the other): FS serializes the accesses to littlefs.
+  bootProfile.Begin(BootProfile::Stages::Flash);
   spi.Init();
   spiNorFlash.Init();
   spiNorFlash.Wakeup();
+  bootProfile.End(BootProfile::Stages::Flash);
 
+  bootProfile.Begin(BootProfile::Stages::FileSystem);
   fs.Init();
+  notificationManager.Init();
+  bootProfile.End(BootProfile::Stages::FileSystem);
+
+  bootProfile.Begin(BootProfile::Stages::Settings);
+  settingsController.Init();
+  bootProfile.End(BootProfile::Stages::Settings);
+
+  dateTimeController.Register(this);
+  batteryController.Register(this);
+
+  // Only the time is restored here, so that the clock shows it, the steps are restored once the motion sensor is initialized
+  recordStore.Init();
+  RestoreTime();
+
+  displayApp.Register(this);
+  displayApp.Register(&nimbleController.weather());
+  displayApp.Register(&nimbleController.music());
+  displayApp.Register(&nimbleController.navigation());
+  displayApp.Start(bootError);
 
+  bootProfile.Begin(BootProfile::Stages::Ble);
   nimbleController.Init();
+  bootProfile.End(BootProfile::Stages::Ble);
 
+  bootProfile.Begin(BootProfile::Stages::Touch);
   twiMaster.Init();
   /*
    * TODO We disable this warning message until we ensure it won't be displayed
@@ -122,8 +168,9 @@ void SystemTask::Work() {
   }
    */
   touchPanel.Init();
-  dateTimeController.Register(this);
-  batteryController.Register(this);
+  bootProfile.End(BootProfile::Stages::Touch);
+
+  bootProfile.Begin(BootProfile::Stages::Motion);
   motionSensor.SoftReset();
   alarmController.Init(this);
 
@@ -133,17 +180,14 @@ void SystemTask::Work() {
 
   motionSensor.Init();
   motionController.Init(motionSensor.DeviceType());
-  settingsController.Init();
-
-  displayApp.Register(this);
-  displayApp.Register(&nimbleController.weather());
-  displayApp.Register(&nimbleController.music());
-  displayApp.Register(&nimbleController.navigation());
-  displayApp.Start(bootError);
+  RestoreSteps();
+  bootProfile.End(BootProfile::Stages::Motion);
 
+  bootProfile.Begin(BootProfile::Stages::HeartRate);
   heartRateSensor.Init();
   heartRateSensor.Disable();
   heartRateApp.Start();
+  bootProfile.End(BootProfile::Stages::HeartRate);
 
   buttonHandler.Init(this);
 
@@ -184,7 +228,7 @@ void SystemTask::Work() {
     UpdateMotion();
 
     Messages msg;
-    if (xQueueReceive(systemTasksMsgQueue, &msg, 100) == pdTRUE) {
+    if (xQueueReceive(systemTasksMsgQueue, &msg, QueueTimeout()) == pdTRUE) {
       switch (msg) {
         case Messages::EnableSleeping:
           // Make sure that exiting an app doesn't enable sleeping,
@@ -240,6 +284,7 @@ void SystemTask::Work() {
           heartRateApp.PushMessage(Pinetime::Applications::HeartRateTask::Messages::GoToSleep);
           break;
         case Messages::OnNewTime:
+          recordStore.Write(Controllers::RecordStore::Keys::Time, TimeRecord {Seconds(dateTimeController.CurrentDateTime())});
           displayApp.PushMessage(Pinetime::Applications::Display::Messages::RestoreBrightness);
           displayApp.PushMessage(Pinetime::Applications::Display::Messages::UpdateDateTime);
           if (alarmController.State() == Controllers::AlarmController::AlarmState::Set) {
@@ -402,9 +447,15 @@ void SystemTask::Work() {
     }
 
     monitor.Process();
+    monitor.SaveHeapFailure(fs);
     uint32_t systick_counter = nrf_rtc_counter_get(portNRF_RTC_REG);
+    auto previousSeconds = dateTimeController.Seconds();
     dateTimeController.UpdateTime(systick_counter);
+    if (state == SystemTaskState::Running && dateTimeController.Seconds() != previousSeconds) {
+      displayApp.PushMessage(Pinetime::Applications::Display::Messages::UpdateDateTime);
+    }
     NoInit_BackUpTime = dateTimeController.CurrentDateTime();
+    SaveState();
     if (nrf_gpio_pin_read(PinMap::Button) == 0) {
       watchdog.Reload();
     }
@@ -424,6 +475,7 @@ void SystemTask::UpdateMotion() {
 
   if (stepCounterMustBeReset) {
     motionSensor.ResetStepCounter();
+    motionController.ResetSteps();
     stepCounterMustBeReset = false;
   }
 
@@ -445,6 +497,55 @@ void SystemTask::UpdateMotion() {
   }
 }
 
+void SystemTask::RestoreTime() {
+  // After a reset that kept the RAM, the time backed up in the .noinit section is more recent. The record is only used
+  // after a power loss: it is up to stateSavePeriod old, and the local time may have been set back since it was written.
+  TimeRecord time;
+  if (!NoInit_IsValid && recordStore.Read(Controllers::RecordStore::Keys::Time, time)) {
+    dateTimeController.SetCurrentTime(
+      std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds>(std::chrono::seconds(time.seconds)));
+  }
+}
+
+void SystemTask::RestoreSteps() {
+  StepsRecord steps;
+  if (recordStore.Read(Controllers::RecordStore::Keys::Steps, steps) &&
+      steps.day == Seconds(dateTimeController.CurrentDateTime()) / secondsPerDay) {
+    motionController.RestoreSteps(steps.steps, steps.tripSteps);
+  }
+}
+
+void SystemTask::SaveState() {
+  if (xTaskGetTickCount() - lastStateSave < stateSavePeriod) {
+    return;
+  }
+  lastStateSave = xTaskGetTickCount();
+
+  const int64_t now = Seconds(dateTimeController.CurrentDateTime());
+  recordStore.Write(Controllers::RecordStore::Keys::Time, TimeRecord {now});
+  // Until the step counter is reset, the steps belong to the previous day
+  if (!stepCounterMustBeReset) {
+    const StepsRecord steps {static_cast<uint32_t>(now / secondsPerDay), motionController.NbSteps(), motionController.GetTripSteps()};
+    recordStore.Write(Controllers::RecordStore::Keys::Steps, steps);
+  }
+  // The erase stalls the CPU for ~85 ms, which would make the BLE stack miss its connection events
+  if (!bleController.IsConnected()) {
+    recordStore.EraseSpare();
+  }
+}
+
+TickType_t SystemTask::QueueTimeout() const {
+  if (state != SystemTaskState::Sleeping || isBleDiscoveryTimerRunning ||
+      settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::RaiseWrist) ||
+      settingsController.isWakeUpModeOn(Pinetime::Controllers::Settings::WakeUpMode::Shake)) {
+    return pollingPeriod;
+  }
+
+  // Nothing to poll: sleep until the next minute rollover (chimes, new day), but reload the watchdog in time
+  uint32_t ticksToNextMinute = dateTimeController.TicksToNextMinute(nrf_rtc_counter_get(portNRF_RTC_REG));
+  return std::min<TickType_t>(ticksToNextMinute + 1, maxIdlePeriod);
+}
+
 void SystemTask::HandleButtonAction(Controllers::ButtonActions action) {
   if (IsSleeping()) {
     return;
@@ -13,10 +13,12 @@
 #include <components/motion/MotionController.h>
 
 #include "systemtask/SystemMonitor.h"
+#include "systemtask/BootProfile.h"
 #include "components/ble/NimbleController.h"
 #include "components/ble/NotificationManager.h"
 #include "components/alarm/AlarmController.h"
 #include "components/fs/FS.h"
+#include "components/recordstore/RecordStore.h"
 #include "touchhandler/TouchHandler.h"
 #include "buttonhandler/ButtonHandler.h"
 #include "buttonhandler/ButtonActions.h"
@@ -32,6 +34,8 @@
 #include "systemtask/Messages.h"
 
 extern std::chrono::time_point<std::chrono::system_clock, std::chrono::nanoseconds> NoInit_BackUpTime;
+// True if the .noinit section was kept by the last reset, and the time was restored from NoInit_BackUpTime
+extern bool NoInit_IsValid;
 
 namespace Pinetime {
   namespace Drivers {
@@ -90,6 +94,14 @@ namespace Pinetime {
         return nimbleController;
       };
 
+      const SystemMonitor& Monitor() const {
+        return monitor;
+      }
+
+      BootProfile& GetBootProfile() {
+        return bootProfile;
+      }
+
       bool IsSleeping() const {
         return state == SystemTaskState::Sleeping || state == SystemTaskState::WakingUp;
       }
@@ -135,10 +147,24 @@ namespace Pinetime {
 
       void GoToRunning();
       void UpdateMotion();
+      void RestoreTime();
+      void RestoreSteps();
+      void SaveState();
+      TickType_t QueueTimeout() const;
       bool stepCounterMustBeReset = false;
       static constexpr TickType_t batteryMeasurementPeriod = pdMS_TO_TICKS(10 * 60 * 1000);
+      static constexpr TickType_t pollingPeriod = 100;
+      // Must stay below the watchdog timeout (7s)
+      static constexpr TickType_t maxIdlePeriod = pdMS_TO_TICKS(5000);
+      // Each save appends 36 bytes to the record store, a page of internal flash is erased every ~9 hours
+      static constexpr TickType_t stateSavePeriod = pdMS_TO_TICKS(5 * 60 * 1000);
+      static constexpr int64_t secondsPerDay = 24 * 60 * 60;
+      TickType_t lastStateSave = 0;
+
+      Controllers::RecordStore recordStore;
 
       SystemMonitor monitor;
+      BootProfile bootProfile;
     };
   }
 }
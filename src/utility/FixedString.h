@@ -0,0 +1,55 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+namespace Pinetime {
+  namespace Utility {
+    // Length of the longest prefix of str (length bytes) that fits in maxLength bytes without splitting a UTF-8 sequence
+    inline size_t Utf8Prefix(const char* str, size_t length, size_t maxLength) {
+      if (length <= maxLength) {
+        return length;
+      }
+      // The first byte left out is a continuation byte (10xxxxxx): leave out the whole sequence it belongs to
+      size_t prefix = maxLength;
+      while (prefix > 0 && (static_cast<uint8_t>(str[prefix]) & 0xc0) == 0x80) {
+        prefix--;
+      }
+      return prefix;
+    }
+
+    // String with an inline buffer of N bytes, that never allocates. Longer strings are truncated, on a UTF-8 character boundary.
+    // The content is always null-terminated, so View().data() can be passed to the C APIs (LVGL labels...).
+    template <size_t N>
+    class FixedString {
+    public:
+      FixedString() = default;
+
+      explicit FixedString(const char* str) {
+        Assign(str, std::strlen(str));
+      }
+
+      void Assign(const char* str, size_t length) {
+        length = Utf8Prefix(str, length, N);
+        std::memcpy(buffer.data(), str, length);
+        buffer[length] = '\0';
+        size = length;
+      }
+
+      std::string_view View() const {
+        return {buffer.data(), size};
+      }
+
+      static constexpr size_t Capacity() {
+        return N;
+      }
+
+    private:
+      std::array<char, N + 1> buffer {};
+      size_t size = 0;
+    };
+  }
+}
@@ -1,28 +1,35 @@
+#pragma once
+
 #include <array>
 #include <cstddef>
 
 namespace Pinetime {
   namespace Utility {
+    // Stack of at most N elements. Pushing on a full stack is ignored, and popping from an empty stack returns T {}.
     template <typename T, size_t N>
     class StaticStack {
     public:
       T Pop();
       void Push(T element);
       void Reset();
-      T Top();
+      T Top() const;
+
+      bool Empty() const {
+        return stackPointer == 0;
+      }
 
     private:
-      std::array<T, N> elementArray;
+      std::array<T, N> elementArray {};
       // Number of elements in stack, points to the next empty slot
       size_t stackPointer = 0;
     };
 
-    // Returns random data when popping from empty array.
     template <typename T, size_t N>
     T StaticStack<T, N>::Pop() {
-      if (stackPointer > 0) {
-        stackPointer--;
+      if (stackPointer == 0) {
+        return T {};
       }
+      stackPointer--;
       return elementArray[stackPointer];
     }
 
@@ -40,7 +47,10 @@ namespace Pinetime {
     }
 
     template <typename T, size_t N>
-    T StaticStack<T, N>::Top() {
+    T StaticStack<T, N>::Top() const {
+      if (stackPointer == 0) {
+        return T {};
+      }
       return elementArray[stackPointer - 1];
     }
   }
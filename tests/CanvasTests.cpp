@@ -0,0 +1,209 @@
+#include <algorithm>
+#include <array>
+#include <cstdlib>
+#include <random>
+#include <vector>
+#include "Test.h"
+#include "displayapp/Canvas.h"
+
+using namespace Pinetime;
+using Components::Canvas;
+
+namespace {
+  constexpr lv_coord_t width = LV_HOR_RES_MAX;
+  constexpr lv_coord_t height = LV_VER_RES_MAX;
+  constexpr uint8_t brushSize = 10;
+
+  struct Rect {
+    uint8_t x;
+    lv_coord_t y;
+    uint8_t width;
+    lv_coord_t height;
+  };
+
+  // Fills its frame buffer as the display would, from the line of the canvas
+  struct Display : Canvas::Target {
+    void FillRect(uint8_t x, lv_coord_t y, uint8_t width, lv_coord_t height, lv_color_t color, lv_color_t* line, size_t lineSize)
+      override {
+      if (line[0].full != color.full) {
+        std::fill(line, line + lineSize, color);
+        lineFills++;
+      }
+      CHECK(std::all_of(line, line + lineSize, [color](lv_color_t pixel) {
+        return pixel.full == color.full;
+      }));
+      for (lv_coord_t row = y; row < y + height; row++) {
+        for (uint8_t column = x; column < x + width; column++) {
+          pixels[row * ::width + column] = line[(row * ::width + column) % lineSize].full;
+        }
+      }
+      rects.push_back({x, y, width, height});
+    }
+
+    uint16_t Pixel(lv_coord_t x, lv_coord_t y) const {
+      return pixels[y * ::width + x];
+    }
+
+    std::array<uint16_t, width * height> pixels {};
+    std::vector<Rect> rects;
+    size_t lineFills = 0;
+  };
+
+  // What the stamp must paint: the square of the brush centered on the point, clipped to the display
+  void Paint(std::array<uint16_t, width * height>& pixels, lv_coord_t x, lv_coord_t y, uint8_t size, lv_color_t color) {
+    for (lv_coord_t row = std::max(y - size / 2, 0); row <= std::min(y - size / 2 + size - 1, height - 1); row++) {
+      for (lv_coord_t column = std::max(x - size / 2, 0); column <= std::min(x - size / 2 + size - 1, width - 1); column++) {
+        pixels[row * width + column] = color.full;
+      }
+    }
+  }
+
+  const lv_color_t white = lv_color_make(0xff, 0xff, 0xff);
+  const lv_color_t red = lv_color_make(0xff, 0, 0);
+
+  void TestMerging() {
+    Display display;
+    Canvas canvas {display};
+    canvas.Flush();
+    CHECK(display.rects.empty());
+
+    // Overlapping stamps: one span per line, and a rectangle per group of lines with the same span
+    canvas.Stamp(50, 50, brushSize, white);
+    canvas.Stamp(55, 52, brushSize, white);
+    CHECK(display.rects.empty());
+    canvas.Flush();
+    CHECK(display.rects.size() == 3);
+    CHECK(display.rects[0].x == 45 && display.rects[0].y == 45 && display.rects[0].width == 10 && display.rects[0].height == 2);
+    CHECK(display.rects[1].x == 45 && display.rects[1].y == 47 && display.rects[1].width == 15 && display.rects[1].height == 8);
+    CHECK(display.rects[2].x == 50 && display.rects[2].y == 55 && display.rects[2].width == 10 && display.rects[2].height == 2);
+    std::array<uint16_t, width * height> expected {};
+    Paint(expected, 50, 50, brushSize, white);
+    Paint(expected, 55, 52, brushSize, white);
+    CHECK(display.pixels == expected);
+
+    // Stamps that touch on the same lines are merged too, stamps on other lines are in the same frame
+    display.rects.clear();
+    canvas.Stamp(100, 100, brushSize, white);
+    canvas.Stamp(110, 100, brushSize, white);
+    canvas.Stamp(100, 200, brushSize, white);
+    canvas.Flush();
+    CHECK(display.rects.size() == 2);
+    CHECK(display.rects[0].x == 95 && display.rects[0].width == 20 && display.rects[0].height == brushSize);
+
+    // A gap on the same lines, or another color, sends the frame first
+    display.rects.clear();
+    canvas.Stamp(20, 120, brushSize, white);
+    canvas.Stamp(100, 124, brushSize, white);
+    CHECK(display.rects.size() == 1);
+    canvas.Stamp(100, 124, brushSize, red);
+    CHECK(display.rects.size() == 2);
+    canvas.Flush();
+    CHECK(display.rects.size() == 3);
+    CHECK(display.Pixel(100, 124) == red.full && display.Pixel(20, 120) == white.full);
+
+    // The stamps are clipped to the display
+    display.rects.clear();
+    canvas.Stamp(-20, -20, brushSize, red);
+    canvas.Flush();
+    CHECK(display.rects.empty());
+    canvas.Stamp(0, 0, brushSize, red);
+    canvas.Stamp(width - 1, height - 1, brushSize, red);
+    canvas.Flush();
+    CHECK(display.rects.size() == 2);
+    CHECK(display.rects[0].x == 0 && display.rects[0].y == 0 && display.rects[0].width == 5 && display.rects[0].height == 5);
+    CHECK(display.rects[1].x == width - 6 && display.rects[1].y == height - 6);
+    CHECK(display.rects[1].width == 6 && display.rects[1].height == 6);
+  }
+
+  // Whatever the order of the stamps and the colors, the display shows the same as stamps painted one by one
+  void TestRandomStamps(std::mt19937& random) {
+    Display display;
+    Canvas canvas {display};
+    std::array<uint16_t, width * height> expected {};
+    const lv_color_t colors[] = {white, red, lv_color_make(0, 0, 0xff)};
+    lv_color_t color = white;
+    size_t stamps = 0;
+    for (int frame = 0; frame < 200; frame++) {
+      for (uint32_t i = random() % 20; i > 0; i--) {
+        if (random() % 10 == 0) {
+          color = colors[random() % 3];
+        }
+        const lv_coord_t x = static_cast<lv_coord_t>(random() % (width + 20)) - 10;
+        const lv_coord_t y = static_cast<lv_coord_t>(random() % (height + 20)) - 10;
+        const uint8_t size = 1 + random() % 20;
+        canvas.Stamp(x, y, size, color);
+        Paint(expected, x, y, size, color);
+        stamps++;
+      }
+      canvas.Flush();
+    }
+    CHECK(display.pixels == expected);
+    CHECK(display.rects.size() < stamps * 2);
+  }
+
+  // Distance from the point to the segment [a, b], in the largest of the horizontal and vertical directions
+  double Distance(double x, double y, lv_point_t a, lv_point_t b) {
+    const double dx = b.x - a.x;
+    const double dy = b.y - a.y;
+    const double t = std::clamp(((x - a.x) * dx + (y - a.y) * dy) / (dx * dx + dy * dy), 0.0, 1.0);
+    return std::max(std::abs(x - (a.x + t * dx)), std::abs(y - (a.y + t * dy)));
+  }
+
+  // A fast stroke is one sample every few tens of pixels: the samples are joined by stamps, without gaps
+  void TestStroke() {
+    const lv_point_t segments[][2] = {{{20, 20}, {200, 120}}, {{200, 30}, {30, 40}}, {{120, 10}, {125, 230}}, {{230, 230}, {10, 100}}};
+    for (const auto& segment : segments) {
+      Display display;
+      Canvas canvas {display};
+      canvas.Stroke(segment[0].x, segment[0].y, brushSize, white);
+      canvas.Stroke(segment[1].x, segment[1].y, brushSize, white);
+      canvas.Stroke(segment[1].x, segment[1].y, brushSize, white);
+      canvas.Flush();
+      for (lv_coord_t y = 0; y < height; y++) {
+        for (lv_coord_t x = 0; x < width; x++) {
+          const double distance = Distance(x, y, segment[0], segment[1]);
+          // The brush keeps (almost) its width all along the stroke, and doesn't paint beyond it. The stamps are centered on
+          // pixels of the segment, rounded towards its start.
+          if (distance <= 2) {
+            CHECK(display.Pixel(x, y) == white.full);
+          } else if (distance > brushSize / 2 + 2) {
+            CHECK(display.Pixel(x, y) == 0);
+          }
+        }
+      }
+    }
+
+    // The stroke ends when the finger is lifted: the next touch starts a new stroke
+    Display display;
+    Canvas canvas {display};
+    canvas.Stroke(20, 120, brushSize, white);
+    canvas.EndStroke();
+    canvas.Stroke(200, 120, brushSize, white);
+    canvas.Flush();
+    CHECK(display.Pixel(20, 120) == white.full && display.Pixel(200, 120) == white.full);
+    CHECK(display.Pixel(110, 120) == 0);
+    CHECK(display.lineFills == 1);
+  }
+
+  void Benchmarks() {
+    Display display;
+    Canvas canvas {display};
+    Tests::Benchmark("Canvas: stroke of 8 samples and flush", 10000, [&](size_t i) {
+      const lv_coord_t offset = static_cast<lv_coord_t>(i % 40);
+      for (lv_coord_t sample = 0; sample < 8; sample++) {
+        canvas.Stroke(10 + sample * 28, 20 + offset + sample * 20, brushSize, white);
+      }
+      canvas.EndStroke();
+      canvas.Flush();
+    });
+  }
+}
+
+int main() {
+  std::mt19937 random {1};
+  TestMerging();
+  TestRandomStamps(random);
+  TestStroke();
+  Benchmarks();
+  return Tests::Result();
+}
@@ -0,0 +1,203 @@
+#include <cstring>
+#include <random>
+#include <vector>
+#include "Test.h"
+#include "components/fs/FS.h"
+#include "displayapp/FontPack.h"
+
+using namespace Pinetime;
+using Components::FontPack;
+
+namespace {
+  constexpr const char* path = "/fonts/bebas.bin";
+  constexpr lv_coord_t lineHeight = 120;
+  constexpr lv_coord_t baseLine = 20;
+  // Rows of the draw buffer of DisplayApp
+  constexpr lv_coord_t stripHeight = 4;
+
+  struct Glyph {
+    uint32_t codePoint;
+    uint8_t width;
+    uint8_t height;
+  };
+
+  // Close to the 120 px digits of Bebas Neue, 1 bpp: about 500 bytes per digit
+  // Sorted by code point, like the index of the pack
+  constexpr Glyph glyphs[] = {
+    {'0', 50, 86},
+    {'1', 30, 86},
+    {'2', 48, 86},
+    {'3', 48, 86},
+    {'4', 52, 86},
+    {'5', 47, 86},
+    {'6', 50, 86},
+    {'7', 45, 86},
+    {'8', 50, 86},
+    {'9', 50, 86},
+    {':', 12, 60},
+  };
+
+  size_t BitmapSize(const Glyph& glyph) {
+    return (glyph.width * glyph.height + 7) / 8;
+  }
+
+  // Same layout as generate-fonts.py: header, index sorted by code point, bitmaps
+  std::vector<uint8_t> MakePack(std::mt19937& random) {
+    FontPack::Header header {};
+    header.magic = FontPack::magic;
+    header.nbGlyphs = std::size(glyphs);
+    header.bpp = 1;
+    header.version = FontPack::version;
+    header.lineHeight = lineHeight;
+    header.baseLine = baseLine;
+
+    std::vector<uint8_t> pack(sizeof(header) + sizeof(glyphs) / sizeof(Glyph) * sizeof(FontPack::GlyphEntry));
+    std::memcpy(pack.data(), &header, sizeof(header));
+    for (size_t i = 0; i < std::size(glyphs); i++) {
+      FontPack::GlyphEntry entry {};
+      entry.codePoint = glyphs[i].codePoint;
+      entry.bitmapOffset = pack.size();
+      entry.advanceWidth = (glyphs[i].width + 4) * 16;
+      entry.boxWidth = glyphs[i].width;
+      entry.boxHeight = glyphs[i].height;
+      std::memcpy(&pack[sizeof(header) + i * sizeof(entry)], &entry, sizeof(entry));
+      for (size_t j = 0; j < BitmapSize(glyphs[i]); j++) {
+        pack.push_back(static_cast<uint8_t>(random()));
+      }
+    }
+    return pack;
+  }
+
+  const uint8_t* ExpectedBitmap(const std::vector<uint8_t>& pack, uint32_t codePoint) {
+    for (size_t i = 0; i < std::size(glyphs); i++) {
+      FontPack::GlyphEntry entry;
+      std::memcpy(&entry, &pack[sizeof(FontPack::Header) + i * sizeof(entry)], sizeof(entry));
+      if (entry.codePoint == codePoint) {
+        return &pack[entry.bitmapOffset];
+      }
+    }
+    return nullptr;
+  }
+
+  struct Label {
+    const char* text;
+    lv_coord_t y;
+  };
+
+  // As LVGL draws the labels of Infineat: a strip of a few rows at a time, with the descriptor of every letter of the label
+  // and the bitmap of the letters that cross the strip
+  void Redraw(const lv_font_t* font, const Label* labels, size_t nbLabels) {
+    for (lv_coord_t stripY = 0; stripY < 240; stripY += stripHeight) {
+      for (size_t i = 0; i < nbLabels; i++) {
+        if (stripY + stripHeight <= labels[i].y || stripY >= labels[i].y + lineHeight) {
+          continue;
+        }
+        for (const char* letter = labels[i].text; *letter != '\0'; letter++) {
+          lv_font_glyph_dsc_t dsc;
+          CHECK(font->get_glyph_dsc(font, &dsc, *letter, letter[1]));
+          const lv_coord_t top = labels[i].y + (font->line_height - font->base_line) - dsc.box_h - dsc.ofs_y;
+          if (stripY + stripHeight > top && stripY < top + dsc.box_h) {
+            const uint8_t* bitmap = font->get_glyph_bitmap(font, *letter);
+            CHECK(bitmap != nullptr);
+            Tests::DoNotOptimize(bitmap);
+          }
+        }
+      }
+    }
+  }
+
+  constexpr Label timeLabels[] = {{"20", 0}, {"48", 120}};
+
+  void TestGlyphs(Controllers::FS& fs) {
+    const auto& pack = fs.files[path];
+    FontPack fontPack {fs};
+    CHECK(FontPack::IsValid(fs, path));
+    CHECK(fontPack.Open(path, 4));
+    const lv_font_t* font = fontPack.Font();
+    CHECK(font != nullptr);
+    CHECK(font->line_height == lineHeight);
+    CHECK(font->base_line == baseLine);
+
+    // More glyphs than the cache holds, twice, with the glyphs that are not in the pack
+    for (int pass = 0; pass < 2; pass++) {
+      for (const Glyph& glyph : glyphs) {
+        lv_font_glyph_dsc_t dsc;
+        CHECK(font->get_glyph_dsc(font, &dsc, glyph.codePoint, 0));
+        CHECK(dsc.box_w == glyph.width);
+        CHECK(dsc.box_h == glyph.height);
+        CHECK(dsc.adv_w == glyph.width + 4);
+        CHECK(dsc.bpp == 1);
+        const uint8_t* bitmap = font->get_glyph_bitmap(font, glyph.codePoint);
+        CHECK(bitmap != nullptr && std::memcmp(bitmap, ExpectedBitmap(pack, glyph.codePoint), BitmapSize(glyph)) == 0);
+      }
+      lv_font_glyph_dsc_t dsc;
+      CHECK(!font->get_glyph_dsc(font, &dsc, 'A', 0));
+      CHECK(font->get_glyph_bitmap(font, 'A') == nullptr);
+    }
+
+    fontPack.Close();
+    CHECK(fontPack.Font() == nullptr);
+  }
+
+  // The cache holds the largest glyphs in use, so that redrawing the time doesn't read the file again
+  void TestCacheSize(Controllers::FS& fs) {
+    FontPack fontPack {fs};
+    CHECK(fontPack.Open(path, 4));
+    // '4' and three of the 50 px digits
+    CHECK(fontPack.GetStats().cacheSize == (52 * 86 + 7) / 8 + 3 * ((50 * 86 + 7) / 8));
+
+    Redraw(fontPack.Font(), timeLabels, std::size(timeLabels));
+    const auto stats = fontPack.GetStats();
+    CHECK(stats.misses == 4);
+    const uint32_t bytesRead = fs.bytesRead;
+    Redraw(fontPack.Font(), timeLabels, std::size(timeLabels));
+    CHECK(fontPack.GetStats().misses == stats.misses);
+    CHECK(fontPack.GetStats().hits > stats.hits);
+    CHECK(fs.bytesRead == bytesRead);
+
+    // All the glyphs of the pack don't fit in the 4 KB that the cache is limited to
+    CHECK(fontPack.Open(path, 100));
+    CHECK(fontPack.GetStats().cacheSize == 4096);
+    Redraw(fontPack.Font(), timeLabels, std::size(timeLabels));
+  }
+
+  void TestInvalid(Controllers::FS& fs) {
+    fs.files["/fonts/old.bin"] = std::vector<uint8_t>(64, 0);
+    FontPack fontPack {fs};
+    CHECK(!FontPack::IsValid(fs, "/fonts/old.bin"));
+    CHECK(!fontPack.Open("/fonts/old.bin", 4));
+    CHECK(fontPack.Font() == nullptr);
+    CHECK(!fontPack.Open("/fonts/missing.bin", 4));
+
+    // Truncated index
+    fs.files["/fonts/truncated.bin"] = std::vector<uint8_t>(fs.files[path].begin(), fs.files[path].begin() + 40);
+    CHECK(!fontPack.Open("/fonts/truncated.bin", 4));
+    CHECK(fontPack.Font() == nullptr);
+  }
+
+  void Benchmarks(Controllers::FS& fs) {
+    FontPack fontPack {fs};
+    fontPack.Open(path, 4);
+    Redraw(fontPack.Font(), timeLabels, std::size(timeLabels));
+    const uint32_t bytesRead = fs.bytesRead;
+    constexpr size_t iterations = 10000;
+    Tests::Benchmark("FontPack: redraw of 20:48 with 120 px digits", iterations, [&](size_t) {
+      Redraw(fontPack.Font(), timeLabels, std::size(timeLabels));
+    });
+    std::printf("%-48s %10.1f bytes read/op %6u bytes of cache\n",
+                "FontPack: redraw of 20:48 with 120 px digits",
+                static_cast<double>(fs.bytesRead - bytesRead) / static_cast<double>(iterations + iterations / 10),
+                fontPack.GetStats().cacheSize);
+  }
+}
+
+int main() {
+  std::mt19937 random {1};
+  Controllers::FS fs;
+  fs.files[path] = MakePack(random);
+  TestGlyphs(fs);
+  TestCacheSize(fs);
+  TestInvalid(fs);
+  Benchmarks(fs);
+  return Tests::Result();
+}
@@ -0,0 +1,223 @@
+#include <cstring>
+#include <string>
+#include <vector>
+#include "ImageVectors.h"
+#include "Test.h"
+#include "displayapp/ImageDecoder.h"
+
+using namespace Pinetime;
+using Components::ImageDecoder;
+
+namespace {
+  bool Decode(const ImageVectors::Compressed& vector, const uint8_t* encoded, size_t encodedSize, uint8_t* dst, size_t dstSize) {
+    if (std::strcmp(vector.compression, "Lz4") == 0) {
+      return ImageDecoder::DecodeLz4(encoded, encodedSize, dst, dstSize);
+    }
+    return ImageDecoder::DecodeRle(encoded, encodedSize, dst, dstSize, vector.unitSize);
+  }
+
+  // The data compressed by lv_img_conv.py is decompressed exactly, and the encoder of StaticLayer produces the same RLE stream
+  void TestCompressed() {
+    for (const auto& vector : ImageVectors::compressed) {
+      std::vector<uint8_t> decoded(vector.data.size());
+      CHECK(Decode(vector, vector.encoded.data(), vector.encoded.size(), decoded.data(), decoded.size()));
+      CHECK(decoded == vector.data);
+
+      // The size of the row is part of the check: the data must decompress to exactly the size of the row
+      CHECK(!Decode(vector, vector.encoded.data(), vector.encoded.size(), decoded.data(), decoded.size() - 1));
+      decoded.push_back(0);
+      CHECK(!Decode(vector, vector.encoded.data(), vector.encoded.size(), decoded.data(), decoded.size()));
+      decoded.pop_back();
+      CHECK(!Decode(vector, vector.encoded.data(), vector.encoded.size() - 1, decoded.data(), decoded.size()));
+
+      if (std::strcmp(vector.compression, "Rle") == 0) {
+        std::vector<uint8_t> encoded(vector.encoded.size());
+        CHECK(ImageDecoder::EncodeRle(vector.data.data(), vector.data.size(), encoded.data(), encoded.size(), vector.unitSize) ==
+              encoded.size());
+        CHECK(encoded == vector.encoded);
+        CHECK(ImageDecoder::EncodeRle(vector.data.data(), vector.data.size(), encoded.data(), encoded.size() - 1, vector.unitSize) ==
+              0);
+      }
+    }
+  }
+
+  // The line that the built-in decoder would give for the row: the indexed formats converted to colors with an alpha byte
+  std::vector<uint8_t> ExpectedLine(const ImageVectors::Image& image, uint16_t y) {
+    if (image.format == LV_IMG_CF_TRUE_COLOR || image.format == LV_IMG_CF_TRUE_COLOR_ALPHA) {
+      const size_t stride = image.rows.size() / image.height;
+      return {image.rows.begin() + y * stride, image.rows.begin() + (y + 1) * stride};
+    }
+    const uint8_t bits = 1 << (image.format - LV_IMG_CF_INDEXED_1BIT);
+    const size_t stride = (image.width * bits + 7) / 8;
+    std::vector<uint8_t> line;
+    for (uint16_t x = 0; x < image.width; x++) {
+      const uint8_t byte = image.rows[y * stride + x * bits / 8];
+      const uint8_t index = (byte >> (8 - bits - (x * bits) % 8)) & ((1 << bits) - 1);
+      const uint8_t* bgra = &image.palette[index * 4];
+      const lv_color_t color = lv_color_make(bgra[2], bgra[1], bgra[0]);
+      line.push_back(color.full & 0xFF);
+      line.push_back(color.full >> 8);
+      line.push_back(bgra[3]);
+    }
+    return line;
+  }
+
+  std::vector<uint8_t> ReadLine(lv_img_decoder_dsc_t& dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t pixelSize) {
+    std::vector<uint8_t> line(len * pixelSize);
+    if (lv_img_decoder_read_line(&dsc, x, y, len, line.data()) != LV_RES_OK) {
+      line.clear();
+    }
+    return line;
+  }
+
+  void CheckCompressedImage(const ImageVectors::Image& image, const void* src) {
+    const uint8_t pixelSize = (image.format == LV_IMG_CF_TRUE_COLOR) ? 2 : LV_IMG_PX_SIZE_ALPHA_BYTE;
+    lv_img_header_t header;
+    CHECK(lv_img_decoder_get_info(src, &header) == LV_RES_OK);
+    CHECK(header.cf == (image.format == LV_IMG_CF_TRUE_COLOR ? LV_IMG_CF_TRUE_COLOR : LV_IMG_CF_TRUE_COLOR_ALPHA));
+    CHECK(header.w == image.width && header.h == image.height);
+
+    lv_img_decoder_dsc_t dsc;
+    CHECK(lv_img_decoder_open(&dsc, src) == LV_RES_OK);
+    CHECK(dsc.img_data == nullptr);
+    // From the top, as LVGL draws the image
+    for (uint16_t y = 0; y < image.height; y++) {
+      CHECK(ReadLine(dsc, 0, y, image.width, pixelSize) == ExpectedLine(image, y));
+    }
+    // Anywhere, from the index: the rows of an area that was invalidated, from the bottom up, and parts of rows
+    for (int y = image.height - 1; y >= 0; y -= 3) {
+      const std::vector<uint8_t> expected = ExpectedLine(image, y);
+      CHECK(ReadLine(dsc, 0, y, image.width, pixelSize) == expected);
+      const std::vector<uint8_t> part(expected.begin() + 3 * pixelSize, expected.begin() + 10 * pixelSize);
+      CHECK(ReadLine(dsc, 3, y, 7, pixelSize) == part);
+    }
+    CHECK(ReadLine(dsc, 0, image.height, 1, pixelSize).empty());
+    CHECK(ReadLine(dsc, image.width - 1, 0, 2, pixelSize).empty());
+    lv_img_decoder_close(&dsc);
+    CHECK(lvMemBlocks == 0);
+  }
+
+  // Every file image is opened once to get its header, whichever decoder it is for
+  void TestFiles() {
+    for (size_t i = 0; i < ImageVectors::images.size(); i++) {
+      const auto& image = ImageVectors::images[i];
+      const std::string path = "F:/images/" + std::to_string(i) + ".bin";
+      lvFsFiles[path] = image.file;
+      lvImgBuiltInCalls = {};
+      uint32_t opens = lvFsOpens;
+
+      lv_img_header_t header;
+      CHECK(lv_img_decoder_get_info(path.c_str(), &header) == LV_RES_OK);
+      CHECK(lvFsOpens - opens == 1);
+      CHECK(lvImgBuiltInCalls.info == 0);
+
+      if (image.compressed) {
+        opens = lvFsOpens;
+        CheckCompressedImage(image, path.c_str());
+        CHECK(lvImgBuiltInCalls.open == 0 && lvImgBuiltInCalls.readLine == 0 && lvImgBuiltInCalls.close == 0);
+      } else {
+        CHECK(header.cf == image.format && header.w == image.width && header.h == image.height);
+        opens = lvFsOpens;
+        lv_img_decoder_dsc_t dsc;
+        CHECK(lv_img_decoder_open(&dsc, path.c_str()) == LV_RES_OK);
+        uint8_t line[3];
+        CHECK(lv_img_decoder_read_line(&dsc, 0, 0, 1, line) == LV_RES_OK);
+        lv_img_decoder_close(&dsc);
+        // The header for the built-in decoder is the one read by this decoder
+        CHECK(lvFsOpens - opens == 1);
+        CHECK(lvImgBuiltInCalls.info == 0);
+        CHECK(lvImgBuiltInCalls.open == 1 && lvImgBuiltInCalls.readLine == 1 && lvImgBuiltInCalls.close == 1);
+      }
+      CHECK(lvFsOpenFiles == 0);
+    }
+
+    lv_img_header_t header;
+    CHECK(lv_img_decoder_get_info("F:/images/missing.bin", &header) == LV_RES_INV);
+  }
+
+  // The images in RAM, like the background of StaticLayer, are decoded without any I/O
+  void TestVariables() {
+    for (const auto& image : ImageVectors::images) {
+      lv_img_dsc_t dsc {};
+      std::memcpy(&dsc.header, image.file.data(), sizeof(dsc.header));
+      dsc.data = image.file.data();
+      dsc.data_size = image.file.size();
+      lvImgBuiltInCalls = {};
+      const uint32_t opens = lvFsOpens;
+      if (image.compressed) {
+        CheckCompressedImage(image, &dsc);
+        CHECK(lvImgBuiltInCalls.info == 0);
+      } else {
+        // The built-in decoder reads plain images in RAM directly
+        dsc.data += sizeof(dsc.header);
+        dsc.data_size -= sizeof(dsc.header);
+        lv_img_header_t header;
+        CHECK(lv_img_decoder_get_info(&dsc, &header) == LV_RES_OK);
+        CHECK(lvImgBuiltInCalls.info == 1);
+      }
+      CHECK(lvFsOpens == opens);
+    }
+  }
+
+  // The rows that are cut or corrupted are reported to LVGL, and the memory is released
+  void TestCorrupted() {
+    for (const auto& image : ImageVectors::images) {
+      if (!image.compressed) {
+        continue;
+      }
+      const uint8_t pixelSize = (image.format == LV_IMG_CF_TRUE_COLOR) ? 2 : LV_IMG_PX_SIZE_ALPHA_BYTE;
+      lvFsFiles["F:/truncated.bin"] = std::vector<uint8_t>(image.file.begin(), image.file.end() - 5);
+      lv_img_decoder_dsc_t dsc;
+      CHECK(lv_img_decoder_open(&dsc, "F:/truncated.bin") == LV_RES_OK);
+      CHECK(ReadLine(dsc, 0, 0, image.width, pixelSize) == ExpectedLine(image, 0));
+      CHECK(ReadLine(dsc, 0, image.height - 1, image.width, pixelSize).empty());
+      lv_img_decoder_close(&dsc);
+
+      // Rows per index entry of 0
+      std::vector<uint8_t> file = image.file;
+      file[sizeof(lv_img_header_t) + 2] = 0;
+      lvFsFiles["F:/corrupted.bin"] = file;
+      CHECK(lvImgDecoders[0]->info_cb(lvImgDecoders[0], "F:/corrupted.bin", &dsc.header) == LV_RES_INV);
+
+      // Cut in the palette or the index
+      lvFsFiles["F:/truncated.bin"] = std::vector<uint8_t>(image.file.begin(), image.file.begin() + sizeof(lv_img_header_t) + 10);
+      dsc = {};
+      dsc.decoder = lvImgDecoders[0];
+      dsc.src = "F:/truncated.bin";
+      CHECK(dsc.decoder->info_cb(dsc.decoder, dsc.src, &dsc.header) == LV_RES_OK);
+      if (dsc.decoder->open_cb(dsc.decoder, &dsc) == LV_RES_OK) {
+        CHECK(ReadLine(dsc, 0, 0, image.width, pixelSize).empty());
+        lv_img_decoder_close(&dsc);
+      }
+      CHECK(lvMemBlocks == 0 && lvFsOpenFiles == 0);
+    }
+  }
+
+  void Benchmarks() {
+    for (const auto& image : ImageVectors::images) {
+      if (!image.compressed) {
+        continue;
+      }
+      lvFsFiles["F:/benchmark.bin"] = image.file;
+      lv_img_decoder_dsc_t dsc;
+      lv_img_decoder_open(&dsc, "F:/benchmark.bin");
+      std::vector<uint8_t> line(image.width * LV_IMG_PX_SIZE_ALPHA_BYTE);
+      const std::string name = std::string("ImageDecoder: row of ") + image.name;
+      Tests::Benchmark(name.c_str(), 100000, [&](size_t i) {
+        lv_img_decoder_read_line(&dsc, 0, i % image.height, image.width, line.data());
+        Tests::DoNotOptimize(line.data());
+      });
+      lv_img_decoder_close(&dsc);
+    }
+  }
+}
+
+int main() {
+  ImageDecoder::Register();
+  TestCompressed();
+  TestFiles();
+  TestVariables();
+  TestCorrupted();
+  Benchmarks();
+  return Tests::Result();
+}
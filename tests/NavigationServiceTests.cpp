@@ -0,0 +1,150 @@
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include "Test.h"
+#include "components/ble/NavigationService.h"
+
+using namespace Pinetime;
+using Controllers::NavigationService;
+
+namespace {
+  // The characteristics in the order of the service definition: flag, narrative, distance, progress
+  enum class Characteristic : uint8_t { Flag, Narrative, ManDist, Progress };
+
+  // Writes the characteristics as the companion app does
+  struct Client {
+    explicit Client(NavigationService& service) : service {service} {
+    }
+
+    void Prepare(Characteristic characteristic, std::string_view value) {
+      mbuf.length = static_cast<uint16_t>(std::min(value.size(), sizeof(mbuf.data)));
+      std::copy_n(value.begin(), mbuf.length, mbuf.data);
+      ctxt.op = BLE_GATT_ACCESS_OP_WRITE_CHR;
+      ctxt.om = &mbuf;
+      ctxt.chr = &Definition(characteristic);
+    }
+
+    void Write(Characteristic characteristic, std::string_view value) {
+      Prepare(characteristic, value);
+      service.OnCommand(&ctxt);
+    }
+
+    const ble_gatt_chr_def& Definition(Characteristic characteristic);
+
+    NavigationService& service;
+    os_mbuf mbuf {};
+    ble_gatt_access_ctxt ctxt {};
+  };
+
+  // 0001yyxx-78fc-48fe-8e23-433b3a1942d0, as in NavigationService.cpp
+  const ble_uuid128_t uuids[] = {
+    {{BLE_UUID_TYPE_128}, {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, 0x01, 0x00, 0x01, 0x00}},
+    {{BLE_UUID_TYPE_128}, {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, 0x02, 0x00, 0x01, 0x00}},
+    {{BLE_UUID_TYPE_128}, {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, 0x03, 0x00, 0x01, 0x00}},
+    {{BLE_UUID_TYPE_128}, {0xd0, 0x42, 0x19, 0x3a, 0x3b, 0x43, 0x23, 0x8e, 0xfe, 0x48, 0xfc, 0x78, 0x04, 0x00, 0x01, 0x00}},
+  };
+
+  const ble_gatt_chr_def& Client::Definition(Characteristic characteristic) {
+    static ble_gatt_chr_def definitions[4];
+    definitions[static_cast<uint8_t>(characteristic)].uuid = &uuids[static_cast<uint8_t>(characteristic)].u;
+    return definitions[static_cast<uint8_t>(characteristic)];
+  }
+
+  // What Screens::Navigation::Refresh() does with the service: the texts are only read when their revision changed
+  struct Screen {
+    uint32_t textRevision = 0;
+    std::string_view flag;
+    std::string_view narrative;
+    std::string_view manDist;
+    int progress = 0;
+    uint32_t updates = 0;
+
+    void Refresh(NavigationService& service) {
+      if (textRevision != service.TextRevision()) {
+        textRevision = service.TextRevision();
+        flag = service.getFlag();
+        narrative = service.getNarrative();
+        manDist = service.getManDist();
+        updates++;
+      }
+      progress = service.getProgress();
+    }
+  };
+
+  void TestTexts() {
+    NavigationService service;
+    Client client {service};
+    Screen screen;
+    screen.Refresh(service);
+    CHECK(screen.updates == 1);
+    screen.Refresh(service);
+    CHECK(screen.updates == 1);
+
+    client.Write(Characteristic::Flag, "turn-left");
+    client.Write(Characteristic::Narrative, "Turn left onto Main Street");
+    client.Write(Characteristic::ManDist, "150 m");
+    client.Write(Characteristic::Progress, std::string_view("\x2a", 1));
+    screen.Refresh(service);
+    CHECK(screen.updates == 2);
+    CHECK(screen.flag == "turn-left");
+    CHECK(screen.narrative == "Turn left onto Main Street");
+    CHECK(screen.manDist == "150 m");
+    CHECK(screen.progress == 42);
+    // The views are passed to LVGL as C strings
+    CHECK(screen.narrative.data()[screen.narrative.size()] == '\0');
+
+    // A narrative longer than 80 bytes is cut before the character that doesn't fit in full ("é" is 2 bytes)
+    std::string narrative(79, 'a');
+    narrative += "\xc3\xa9 and more";
+    client.Write(Characteristic::Narrative, narrative);
+    screen.Refresh(service);
+    CHECK(screen.narrative == std::string(79, 'a'));
+    narrative = std::string(78, 'a') + "\xc3\xa9 and more";
+    client.Write(Characteristic::Narrative, narrative);
+    screen.Refresh(service);
+    CHECK(screen.narrative == std::string(78, 'a') + "\xc3\xa9");
+    // The flag and the distance are shorter
+    client.Write(Characteristic::ManDist, "123456789012345\xe2\x82\xac");
+    screen.Refresh(service);
+    CHECK(screen.manDist == "123456789012345");
+  }
+
+  // Writing a text and refreshing the screen don't touch the heap, whether the texts changed or not
+  void TestRefreshDoesNotAllocate() {
+    NavigationService service;
+    Client client {service};
+    Screen screen;
+    const std::string narratives[] = {"Turn right", "Keep left at the fork, then continue on the A7 towards the city centre", ""};
+
+    size_t allocations = 0;
+    for (int i = 0; i < 10000; i++) {
+      if (i % 100 == 0) {
+        client.Prepare(Characteristic::Narrative, narratives[(i / 100) % 3]);
+        const size_t before = Tests::AllocationCount();
+        service.OnCommand(&client.ctxt);
+        allocations += Tests::AllocationCount() - before;
+      }
+      const size_t before = Tests::AllocationCount();
+      screen.Refresh(service);
+      allocations += Tests::AllocationCount() - before;
+    }
+    CHECK(allocations == 0);
+    CHECK(screen.updates == 100);
+    CHECK(screen.narrative == narratives[99 % 3]);
+
+    Tests::Benchmark("Navigation: refresh, text unchanged", 1000000, [&](size_t) {
+      screen.Refresh(service);
+    });
+    client.Prepare(Characteristic::Narrative, narratives[1]);
+    Tests::Benchmark("Navigation: write of the narrative and refresh", 1000000, [&](size_t) {
+      service.OnCommand(&client.ctxt);
+      screen.Refresh(service);
+    });
+  }
+}
+
+int main() {
+  TestTexts();
+  TestRefreshDoesNotAllocate();
+  return Tests::Result();
+}
@@ -0,0 +1,216 @@
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+#include "Test.h"
+#include "components/ble/NotificationManager.h"
+#include "components/fs/FS.h"
+
+using namespace Pinetime;
+using Controllers::NotificationManager;
+
+namespace {
+  constexpr size_t historySize = 256;
+  constexpr const char* logPath = "/notifs.log";
+
+  struct Expected {
+    NotificationManager::Id id;
+    std::string title;
+    std::string message;
+  };
+
+  void Push(NotificationManager& manager, const std::string& title, const std::string& message) {
+    NotificationManager::Notification notification;
+    const std::string text = title + '\0' + message;
+    notification.size = static_cast<uint8_t>(std::min<size_t>(text.size() + 1, NotificationManager::MessageSize + 1));
+    std::memcpy(notification.message.data(), text.c_str(), notification.size);
+    manager.Push(std::move(notification));
+  }
+
+  // Walks the whole history from the newest notification, and checks every getter against the model
+  void CheckHistory(NotificationManager& manager, const std::deque<Expected>& model) {
+    CHECK(manager.NbNotifications() == model.size());
+    CHECK(manager.IsEmpty() == model.empty());
+    auto view = manager.GetLastNotification();
+    if (model.empty()) {
+      CHECK(!view.valid);
+      return;
+    }
+
+    for (size_t i = model.size(); i-- > 0;) {
+      const auto& expected = model[i];
+      CHECK(view.valid && view.id == expected.id);
+      if (!view.valid) {
+        return;
+      }
+      const auto notification = manager.Get(view.id);
+      CHECK(notification.valid);
+      CHECK(notification.Title() == expected.title);
+      CHECK(notification.Message() == expected.message);
+      CHECK(manager.IndexOf(view.id) == model.size() - 1 - i);
+
+      view = manager.GetPrevious(view.id);
+      if (i == 0) {
+        CHECK(!view.valid);
+      } else {
+        CHECK(view.valid && manager.GetNext(view.id).id == expected.id);
+      }
+    }
+  }
+
+  // Random pushes and dismissals, until the ids wrap around
+  void TestHistory(std::mt19937& random, bool logAvailable) {
+    Controllers::FS fs;
+    fs.failing = !logAvailable;
+    NotificationManager manager {fs};
+    manager.Init();
+    fs.failing = false;
+
+    std::deque<Expected> model;
+    uint32_t nextId = 0;
+    for (int i = 0; i < 100000; i++) {
+      if (random() % 10 < 7) {
+        const std::string title = "T" + std::to_string(nextId);
+        std::string message(random() % 120, static_cast<char>('a' + nextId % 26));
+        Push(manager, title, message);
+        // The title, the body and their terminators are truncated to MessageSize + 1 bytes
+        message.resize(std::min(message.size(), NotificationManager::MessageSize - title.size() - 1));
+        model.push_back({static_cast<NotificationManager::Id>(nextId), title, message});
+        nextId++;
+        while (!model.empty() && static_cast<NotificationManager::Id>(nextId - model.front().id) > historySize) {
+          model.pop_front();
+        }
+      } else if (!model.empty()) {
+        const size_t index = random() % model.size();
+        manager.Dismiss(model[index].id);
+        model.erase(model.begin() + static_cast<std::ptrdiff_t>(index));
+      }
+
+      if (!logAvailable) {
+        // Only the notifications that fit in the RAM arena are kept
+        while (model.size() > manager.NbNotifications()) {
+          model.pop_front();
+        }
+      }
+      if (i % 97 == 0 || i > 99000) {
+        CheckHistory(manager, model);
+      }
+    }
+    CHECK(nextId > 0x10000);
+    CHECK(manager.IndexOf(static_cast<NotificationManager::Id>(nextId)) == manager.NbNotifications());
+    if (logAvailable) {
+      // The log is only appended to, and compacted into a new file when it is full
+      CHECK(fs.overwrites == 0);
+      CHECK(fs.renames > 100);
+      CHECK(fs.files[logPath].size() <= 32 * 1024);
+    }
+  }
+
+  // Checks that every notification of the history has the text it was pushed with
+  void CheckTexts(NotificationManager& manager, const std::vector<std::string>& titles) {
+    size_t count = 0;
+    for (auto view = manager.GetLastNotification(); view.valid; view = manager.GetPrevious(view.id)) {
+      CHECK(view.id < titles.size() && titles[view.id] == view.Title());
+      count++;
+    }
+    CHECK(count == manager.NbNotifications());
+  }
+
+  // A compaction that fails keeps the previous log: only the notification being spilled is lost
+  void TestCompactionFailure() {
+    Controllers::FS fs;
+    NotificationManager manager {fs};
+    manager.Init();
+    std::vector<std::string> titles;
+    auto pushNext = [&]() {
+      titles.push_back("T" + std::to_string(titles.size()));
+      Push(manager, titles.back(), std::string(60, 'x'));
+    };
+
+    while (fs.renames == 0) {
+      pushNext();
+    }
+    // Same sizes: the next compaction happens after as many pushes as this one
+    const uint32_t renamesBefore = fs.renames;
+    size_t pushesBetweenCompactions = 0;
+    while (fs.renames == renamesBefore) {
+      pushNext();
+      pushesBetweenCompactions++;
+    }
+    for (size_t i = 0; i < pushesBetweenCompactions - 1; i++) {
+      pushNext();
+    }
+    CHECK(manager.NbNotifications() == historySize);
+
+    const auto log = fs.files[logPath];
+    fs.failingRename = true;
+    pushNext();
+    fs.failingRename = false;
+    CHECK(fs.files[logPath] == log);
+    CHECK(fs.files.count("/notifs.tmp") == 0);
+    CHECK(manager.NbNotifications() == historySize - 1);
+    CheckTexts(manager, titles);
+
+    // The next spill compacts the log again, and the history fills up once the lost notification leaves it
+    for (size_t i = 0; i < historySize; i++) {
+      pushNext();
+    }
+    CHECK(manager.NbNotifications() == historySize);
+    CheckTexts(manager, titles);
+    CHECK(fs.overwrites == 0);
+  }
+
+  void TestNewNotificationFlag() {
+    Controllers::FS fs;
+    NotificationManager manager {fs};
+    manager.Init();
+    CHECK(!manager.AreNewNotificationsAvailable());
+    Push(manager, "Title", "Body");
+    CHECK(manager.AreNewNotificationsAvailable());
+    CHECK(manager.ClearNewNotificationFlag());
+    CHECK(!manager.AreNewNotificationsAvailable());
+    CHECK(!manager.ClearNewNotificationFlag());
+  }
+
+  void Benchmarks() {
+    Controllers::FS fs;
+    NotificationManager manager {fs};
+    manager.Init();
+    NotificationManager::Notification notification;
+    const std::string text = "Title" + std::string(1, '\0') + std::string(60, 'x');
+    std::memcpy(notification.message.data(), text.c_str(), text.size() + 1);
+    notification.size = static_cast<uint8_t>(text.size() + 1);
+
+    Tests::Benchmark("NotificationManager: Push (spills to the log)", 100000, [&](size_t) {
+      auto copy = notification;
+      manager.Push(std::move(copy));
+    });
+
+    const auto newest = manager.GetLastNotification().id;
+    Tests::Benchmark("NotificationManager: Get (in the RAM arena)", 1000000, [&](size_t) {
+      Tests::DoNotOptimize(manager.Get(newest));
+    });
+    const auto oldest = static_cast<NotificationManager::Id>(newest - historySize + 1);
+    Tests::Benchmark("NotificationManager: Get (paged from the log)", 100000, [&](size_t) {
+      Tests::DoNotOptimize(manager.Get(oldest));
+    });
+    Tests::Benchmark("NotificationManager: IndexOf (oldest of 256)", 100000, [&](size_t) {
+      Tests::DoNotOptimize(manager.IndexOf(oldest));
+    });
+    Tests::Benchmark("NotificationManager: GetPrevious", 1000000, [&](size_t) {
+      Tests::DoNotOptimize(manager.GetPrevious(newest));
+    });
+  }
+}
+
+int main() {
+  std::mt19937 random {1};
+  TestHistory(random, true);
+  TestHistory(random, false);
+  TestCompactionFailure();
+  TestNewNotificationFlag();
+  Benchmarks();
+  return Tests::Result();
+}
@@ -0,0 +1,86 @@
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <vector>
+#include "Test.h"
+#include "components/rle/RleDecoder.h"
+
+using namespace Pinetime;
+
+namespace {
+  constexpr size_t nbPixels = 240 * 240;
+
+  // Random runs covering a whole screen. Short runs are the worst case of the decoder.
+  std::vector<uint8_t> Encode(std::mt19937& random, uint32_t maxRunLength) {
+    std::vector<uint8_t> encoded;
+    size_t total = 0;
+    while (total < nbPixels) {
+      const size_t runLength = std::min<size_t>(random() % (maxRunLength + 1), nbPixels - total);
+      encoded.push_back(static_cast<uint8_t>(runLength));
+      total += runLength;
+    }
+    return encoded;
+  }
+
+  // One pixel at a time, big endian, starting with the background color
+  std::vector<uint8_t> Reference(const std::vector<uint8_t>& encoded, uint16_t foreground, uint16_t background) {
+    std::vector<uint8_t> pixels;
+    uint16_t color = background;
+    for (const uint8_t runLength : encoded) {
+      for (uint8_t i = 0; i < runLength; i++) {
+        pixels.push_back(static_cast<uint8_t>(color >> 8));
+        pixels.push_back(static_cast<uint8_t>(color & 0xff));
+      }
+      color = (color == background) ? foreground : background;
+    }
+    return pixels;
+  }
+
+  void TestDecode(std::mt19937& random) {
+    for (int t = 0; t < 200; t++) {
+      const auto encoded = Encode(random, (t % 3 == 0) ? 4 : 255);
+      const auto expected = Reference(encoded, 0x1234, 0x0f00);
+
+      // Decode in chunks of random sizes, with an output that isn't always word-aligned
+      Tools::RleDecoder decoder {encoded.data(), encoded.size(), 0x1234, 0x0f00};
+      std::vector<uint16_t> output(nbPixels + 1);
+      const size_t first = t % 2;
+      size_t position = first;
+      size_t written;
+      do {
+        const size_t chunk = std::min<size_t>(1 + random() % 1000, output.size() - position);
+        written = decoder.DecodeNext(&output[position], chunk);
+        position += written;
+        CHECK(written == chunk || position == first + nbPixels);
+      } while (written > 0 && position < output.size());
+      CHECK(position == first + nbPixels);
+      CHECK(std::memcmp(expected.data(), &output[first], expected.size()) == 0);
+      CHECK(decoder.DecodeNext(output.data(), output.size()) == 0);
+    }
+  }
+
+  void Benchmarks(std::mt19937& random) {
+    std::vector<uint16_t> line(240);
+    const auto shortRuns = Encode(random, 4);
+    Tests::Benchmark("RleDecoder: 240x240, runs of 0-4 pixels", 200, [&](size_t) {
+      Tools::RleDecoder decoder {shortRuns.data(), shortRuns.size(), 0xffff, 0};
+      while (decoder.DecodeNext(line.data(), line.size()) > 0) {
+        Tests::DoNotOptimize(line.data());
+      }
+    });
+    const auto longRuns = Encode(random, 255);
+    Tests::Benchmark("RleDecoder: 240x240, runs of 0-255 pixels", 200, [&](size_t) {
+      Tools::RleDecoder decoder {longRuns.data(), longRuns.size(), 0xffff, 0};
+      while (decoder.DecodeNext(line.data(), line.size()) > 0) {
+        Tests::DoNotOptimize(line.data());
+      }
+    });
+  }
+}
+
+int main() {
+  std::mt19937 random {1};
+  TestDecode(random);
+  Benchmarks(random);
+  return Tests::Result();
+}
@@ -0,0 +1,256 @@
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "Test.h"
+#include "displayapp/LvglPool.h"
+#include "displayapp/ScreenMemoryBudget.h"
+
+using namespace Pinetime;
+using Applications::Apps;
+using Components::LvglPool::GetStats;
+
+namespace {
+  // Mostly objects and styles, a few label texts and tables
+  size_t AllocationSize(std::mt19937& random) {
+    switch (random() % 8) {
+      case 0:
+      case 1:
+      case 2:
+        return 60 + random() % 20;
+      case 3:
+      case 4:
+        return 8 + random() % 40;
+      case 5:
+        return 1 + random() % 16;
+      default:
+        return 1 + random() % 256;
+    }
+  }
+
+  // Opens every app one after the other, each one allocating its whole budget, as DisplayApp does with an empty pool
+  void TestEveryAppFitsInPool(std::mt19937& random) {
+    for (uint8_t i = 0; i <= static_cast<uint8_t>(Apps::Weather); i++) {
+      const auto app = static_cast<Apps>(i);
+      const size_t budget = Applications::ScreenMemoryBudget(app);
+      CHECK(budget > 0);
+      CHECK(budget <= Components::LvglPool::maxScreenBudget);
+      CHECK(budget < Components::LvglPool::poolSize);
+
+      Components::LvglPool::BeginScreen(budget);
+      std::vector<void*> blocks;
+      while (GetStats().screenUsed + 256 <= budget) {
+        void* block = LvglPoolAlloc(AllocationSize(random));
+        CHECK(block != nullptr);
+        blocks.push_back(block);
+      }
+      const auto stats = GetStats();
+      CHECK(stats.fallbackCount == 0);
+      CHECK(stats.screenHighWater <= budget);
+
+      std::shuffle(blocks.begin(), blocks.end(), random);
+      for (void* block : blocks) {
+        LvglPoolFree(block);
+      }
+      CHECK(GetStats().used == 0);
+      CHECK(GetStats().freeInPages == Components::LvglPool::poolSize);
+      CHECK(Components::LvglPool::Fragmentation() == 0);
+    }
+  }
+
+  // Past the pool, the allocations fall back to the heap and are still accounted to the screen
+  void TestFallback() {
+    Components::LvglPool::BeginScreen(0);
+    std::vector<void*> blocks;
+    while (GetStats().fallbackCount == 0) {
+      blocks.push_back(LvglPoolAlloc(200));
+    }
+    void* large = LvglPoolAlloc(1000);
+    CHECK(GetStats().fallbackCount == 2);
+    CHECK(GetStats().fallbackUsed == 1200);
+    CHECK(GetStats().screenUsed == GetStats().used + 1200);
+    LvglPoolFree(large);
+    for (void* block : blocks) {
+      LvglPoolFree(block);
+    }
+    CHECK(GetStats().fallbackUsed == 0);
+    CHECK(GetStats().used == 0);
+  }
+
+  // A screen and the LVGL blocks it allocated
+  struct Screen {
+    Apps app = Apps::None;
+    std::vector<void*> blocks;
+    std::vector<size_t> sizes;
+  };
+
+  void FreeScreen(Screen& screen) {
+    for (void* block : screen.blocks) {
+      LvglPoolFree(block);
+    }
+    screen.blocks.clear();
+    screen.sizes.clear();
+    screen.app = Apps::None;
+  }
+
+  // Same policy as DisplayApp::LoadScreen() and DisplayApp::ReleaseCurrentScreen()
+  constexpr size_t warmScreenMinFreeMemory = 10 * 1024;
+  // Free FreeRTOS heap besides the LVGL allocations that fall back to it, once the system is booted
+  constexpr size_t heapFree = 4 * 1024;
+
+  size_t FreeScreenMemory() {
+    const auto stats = GetStats();
+    return stats.free + heapFree - std::min(heapFree, stats.fallbackUsed);
+  }
+
+  bool IsKeptWarm(Apps app) {
+    return app == Apps::Clock || app == Apps::Launcher;
+  }
+
+  /*
+   * 10000 screen switches, mostly between the watch face, the launcher and the notifications, with the watch face and the
+   * launcher kept warm. Each screen allocates between minPercent and maxPercent of its budget. Prints the fragmentation of
+   * the pool every 1000 switches: the pages freed by a screen go back to the free pages, so the fragmentation comes only
+   * from the partially used pages of the screens that are alive.
+   */
+  void TestWarmScreenSwitches(std::mt19937& random, size_t minPercent, size_t maxPercent) {
+    std::array<Screen, 2> warmScreens;
+    Screen current;
+    uint32_t drops = 0;
+    uint32_t resumes = 0;
+    uint32_t maxFragmentation = 0;
+    uint64_t totalFragmentation = 0;
+    std::printf("Screens using %zu-%zu%% of their budget\n", minPercent, maxPercent);
+    std::printf("%8s %8s %8s %8s %8s %10s\n", "switches", "used", "free", "pages", "frag %", "fallbacks");
+
+    constexpr uint32_t nbSwitches = 10000;
+    for (uint32_t i = 1; i <= nbSwitches; i++) {
+      Apps app;
+      do {
+        switch (random() % 10) {
+          case 0:
+          case 1:
+          case 2:
+          case 3:
+            app = Apps::Clock;
+            break;
+          case 4:
+          case 5:
+          case 6:
+            app = Apps::Launcher;
+            break;
+          case 7:
+            app = Apps::Notifications;
+            break;
+          default:
+            app = static_cast<Apps>(random() % (static_cast<uint8_t>(Apps::Weather) + 1));
+            break;
+        }
+      } while (app == current.app);
+
+      // ReleaseCurrentScreen()
+      if (current.app != Apps::None) {
+        if (IsKeptWarm(current.app) && FreeScreenMemory() >= warmScreenMinFreeMemory) {
+          auto* slot = std::find_if(warmScreens.begin(), warmScreens.end(), [&](const Screen& screen) {
+            return screen.app == Apps::None || screen.app == current.app;
+          });
+          FreeScreen(*slot);
+          *slot = std::move(current);
+          current = Screen {};
+        } else {
+          FreeScreen(current);
+        }
+      }
+
+      // LoadScreen()
+      auto* warm = std::find_if(warmScreens.begin(), warmScreens.end(), [&](const Screen& screen) {
+        return screen.app == app;
+      });
+      const bool resumed = warm != warmScreens.end();
+      const size_t budget = Applications::ScreenMemoryBudget(app);
+      if (!resumed && (GetStats().free < budget || FreeScreenMemory() < warmScreenMinFreeMemory)) {
+        for (auto& screen : warmScreens) {
+          drops += screen.app != Apps::None ? 1 : 0;
+          FreeScreen(screen);
+        }
+      }
+      Components::LvglPool::BeginScreen(budget);
+      if (resumed) {
+        current = std::move(*warm);
+        *warm = Screen {};
+        resumes++;
+      } else {
+        current.app = app;
+        const size_t size = budget * (minPercent + random() % (maxPercent - minPercent + 1)) / 100;
+        while (GetStats().screenUsed + 256 <= size) {
+          current.sizes.push_back(AllocationSize(random));
+          current.blocks.push_back(LvglPoolAlloc(current.sizes.back()));
+          CHECK(current.blocks.back() != nullptr);
+        }
+      }
+
+      // Label texts that are set again while the screen is displayed
+      for (int j = 0; j < 8 && !current.blocks.empty(); j++) {
+        const size_t index = random() % current.blocks.size();
+        LvglPoolFree(current.blocks[index]);
+        current.blocks[index] = LvglPoolAlloc(current.sizes[index]);
+        CHECK(current.blocks[index] != nullptr);
+      }
+
+      const uint8_t fragmentation = Components::LvglPool::Fragmentation();
+      maxFragmentation = std::max<uint32_t>(maxFragmentation, fragmentation);
+      totalFragmentation += fragmentation;
+      if (i % 1000 == 0) {
+        const auto stats = GetStats();
+        std::printf("%8u %8zu %8zu %8zu %8u %10u\n", i, stats.used, stats.free, stats.freeInPages, fragmentation, stats.fallbackCount);
+      }
+    }
+    std::printf("Fragmentation: average %u%%, max %u%%. Warm screens resumed %u times, dropped %u times.\n",
+                static_cast<unsigned>(totalFragmentation / nbSwitches),
+                maxFragmentation,
+                resumes,
+                drops);
+    CHECK(GetStats().failedCount == 0);
+
+    // Once every screen is deleted, the pool is back to free pages only
+    FreeScreen(current);
+    for (auto& screen : warmScreens) {
+      FreeScreen(screen);
+    }
+    CHECK(GetStats().used == 0);
+    CHECK(GetStats().fallbackUsed == 0);
+    CHECK(Components::LvglPool::Fragmentation() == 0);
+  }
+
+  void Benchmarks(std::mt19937& random) {
+    Components::LvglPool::BeginScreen(0);
+    std::vector<size_t> sizes(1024);
+    std::generate(sizes.begin(), sizes.end(), [&]() {
+      return AllocationSize(random);
+    });
+    std::vector<void*> blocks(64);
+    for (size_t i = 0; i < blocks.size(); i++) {
+      blocks[i] = LvglPoolAlloc(sizes[i]);
+    }
+    Tests::Benchmark("LvglPool: free and alloc, 64 blocks live", 1000000, [&](size_t i) {
+      void*& block = blocks[i % blocks.size()];
+      LvglPoolFree(block);
+      block = LvglPoolAlloc(sizes[i % sizes.size()]);
+      Tests::DoNotOptimize(block);
+    });
+    for (void* block : blocks) {
+      LvglPoolFree(block);
+    }
+  }
+}
+
+int main() {
+  std::mt19937 random {1};
+  TestEveryAppFitsInPool(random);
+  TestFallback();
+  TestWarmScreenSwitches(random, 25, 50);
+  TestWarmScreenSwitches(random, 50, 100);
+  Benchmarks(random);
+  return Tests::Result();
+}
@@ -0,0 +1,243 @@
+#include <bitset>
+#include <cstring>
+#include <vector>
+#include "Test.h"
+#include "components/fs/FS.h"
+#include "components/settings/Settings.h"
+
+using namespace Pinetime;
+using Controllers::Settings;
+using Levels = Controllers::BrightnessController::Levels;
+
+namespace {
+  constexpr const char* legacyPath = "/settings.dat";
+
+  // Layout of /settings.dat, written by the firmwares that stored the whole settings struct (version 7)
+  struct LegacySettings {
+    uint32_t version = 0x0007;
+    uint32_t stepsGoal = 10000;
+    uint32_t screenTimeOut = 15000;
+    Settings::ClockType clockType = Settings::ClockType::H24;
+    Settings::WeatherFormat weatherFormat = Settings::WeatherFormat::Metric;
+    Settings::Notification notificationStatus = Settings::Notification::On;
+    Applications::WatchFace watchFace = Applications::WatchFace::Digital;
+    Settings::ChimesOption chimesOption = Settings::ChimesOption::None;
+    Settings::PineTimeStyle PTS;
+    Settings::WatchFaceInfineat watchFaceInfineat;
+    std::bitset<5> wakeUpMode {0};
+    uint16_t shakeWakeThreshold = 150;
+    Levels brightLevel = Levels::Medium;
+  };
+
+  // The settings as seen through the getters
+  struct Values {
+    uint32_t stepsGoal;
+    uint32_t screenTimeOut;
+    Settings::ClockType clockType;
+    Settings::WeatherFormat weatherFormat;
+    Settings::Notification notificationStatus;
+    Applications::WatchFace watchFace;
+    Settings::ChimesOption chimesOption;
+    Settings::Colors colorTime;
+    Settings::Colors colorBar;
+    Settings::Colors colorBG;
+    Settings::PTSGaugeStyle gaugeStyle;
+    Settings::PTSWeather weather;
+    bool showSideCover;
+    int colorIndex;
+    std::bitset<5> wakeUpModes;
+    int16_t shakeThreshold;
+    Levels brightness;
+
+    bool operator==(const Values&) const = default;
+  };
+
+  Values Read(const Settings& settings) {
+    return {settings.GetStepsGoal(),
+            settings.GetScreenTimeOut(),
+            settings.GetClockType(),
+            settings.GetWeatherFormat(),
+            settings.GetNotificationStatus(),
+            settings.GetWatchFace(),
+            settings.GetChimeOption(),
+            settings.GetPTSColorTime(),
+            settings.GetPTSColorBar(),
+            settings.GetPTSColorBG(),
+            settings.GetPTSGaugeStyle(),
+            settings.GetPTSWeather(),
+            settings.GetInfineatShowSideCover(),
+            settings.GetInfineatColorIndex(),
+            settings.getWakeUpModes(),
+            settings.GetShakeThreshold(),
+            settings.GetBrightness()};
+  }
+
+  // Changes every setting
+  void Write(Settings& settings, uint32_t seed) {
+    settings.SetStepsGoal(5000 + seed);
+    settings.SetScreenTimeOut(20000 + seed);
+    settings.SetClockType(seed % 2 == 0 ? Settings::ClockType::H12 : Settings::ClockType::Fuzzy);
+    settings.SetWeatherFormat(seed % 2 == 0 ? Settings::WeatherFormat::Imperial : Settings::WeatherFormat::Metric);
+    settings.SetNotificationStatus(seed % 2 == 0 ? Settings::Notification::Sleep : Settings::Notification::Off);
+    settings.SetWatchFace(seed % 2 == 0 ? Applications::WatchFace::Infineat : Applications::WatchFace::Terminal);
+    settings.SetChimeOption(seed % 2 == 0 ? Settings::ChimesOption::HalfHours : Settings::ChimesOption::Hours);
+    settings.SetPTSColorTime(static_cast<Settings::Colors>(seed % 18));
+    settings.SetPTSColorBar(static_cast<Settings::Colors>((seed + 1) % 18));
+    settings.SetPTSColorBG(static_cast<Settings::Colors>((seed + 2) % 18));
+    settings.SetPTSGaugeStyle(seed % 2 == 0 ? Settings::PTSGaugeStyle::Numeric : Settings::PTSGaugeStyle::Half);
+    settings.SetPTSWeather(seed % 2 == 0 ? Settings::PTSWeather::On : Settings::PTSWeather::Off);
+    settings.SetInfineatShowSideCover(seed % 2 != 0);
+    settings.SetInfineatColorIndex(static_cast<int>(seed % 7) + 1);
+    settings.setWakeUpMode(seed % 2 == 0 ? Settings::WakeUpMode::RaiseWrist : Settings::WakeUpMode::Shake, true);
+    settings.SetShakeThreshold(static_cast<uint16_t>(200 + seed));
+    settings.SetBrightness(seed % 2 == 0 ? Levels::High : Levels::Low);
+  }
+
+  Values Boot(Controllers::FS& fs) {
+    Settings settings {fs};
+    settings.Init();
+    return Read(settings);
+  }
+
+  // Every field is either the old value or the new one, never anything else
+  bool IsOldOrNew(const Values& values, const Values& oldValues, const Values& newValues) {
+    bool ok = true;
+    auto check = [&ok](const auto& value, const auto& oldValue, const auto& newValue) {
+      ok = ok && (value == oldValue || value == newValue);
+    };
+    check(values.stepsGoal, oldValues.stepsGoal, newValues.stepsGoal);
+    check(values.screenTimeOut, oldValues.screenTimeOut, newValues.screenTimeOut);
+    check(values.clockType, oldValues.clockType, newValues.clockType);
+    check(values.weatherFormat, oldValues.weatherFormat, newValues.weatherFormat);
+    check(values.notificationStatus, oldValues.notificationStatus, newValues.notificationStatus);
+    check(values.watchFace, oldValues.watchFace, newValues.watchFace);
+    check(values.chimesOption, oldValues.chimesOption, newValues.chimesOption);
+    check(values.colorTime, oldValues.colorTime, newValues.colorTime);
+    check(values.colorBar, oldValues.colorBar, newValues.colorBar);
+    check(values.colorBG, oldValues.colorBG, newValues.colorBG);
+    check(values.gaugeStyle, oldValues.gaugeStyle, newValues.gaugeStyle);
+    check(values.weather, oldValues.weather, newValues.weather);
+    check(values.showSideCover, oldValues.showSideCover, newValues.showSideCover);
+    check(values.colorIndex, oldValues.colorIndex, newValues.colorIndex);
+    check(values.wakeUpModes, oldValues.wakeUpModes, newValues.wakeUpModes);
+    check(values.shakeThreshold, oldValues.shakeThreshold, newValues.shakeThreshold);
+    check(values.brightness, oldValues.brightness, newValues.brightness);
+    return ok;
+  }
+
+  // The power is lost after each change made by the import of the legacy file: the next boot imports it again, until it is
+  // deleted once all the settings are stored
+  void TestImportPowerLoss() {
+    LegacySettings legacy;
+    legacy.stepsGoal = 12345;
+    legacy.screenTimeOut = 30000;
+    legacy.clockType = Settings::ClockType::H12;
+    legacy.watchFace = Applications::WatchFace::PineTimeStyle;
+    legacy.chimesOption = Settings::ChimesOption::Hours;
+    legacy.PTS.ColorTime = Settings::Colors::Orange;
+    legacy.watchFaceInfineat.colorIndex = 3;
+    legacy.wakeUpMode.set(static_cast<size_t>(Settings::WakeUpMode::RaiseWrist));
+    legacy.shakeWakeThreshold = 300;
+    legacy.brightLevel = Levels::Low;
+
+    Controllers::FS reference;
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&legacy);
+    reference.files[legacyPath].assign(bytes, bytes + sizeof(legacy));
+    const Values imported = Boot(reference);
+    CHECK(imported.stepsGoal == 12345 && imported.watchFace == Applications::WatchFace::PineTimeStyle);
+    CHECK(imported.brightness == Levels::Low && imported.colorTime == Settings::Colors::Orange);
+    CHECK(reference.files.count(legacyPath) == 0);
+
+    Controllers::FS empty;
+    const Values defaults = Boot(empty);
+    for (int changes = 0;; changes++) {
+      Controllers::FS fs;
+      fs.files[legacyPath].assign(bytes, bytes + sizeof(legacy));
+      fs.powerLossAfter = changes;
+      const Values interrupted = Boot(fs);
+      const bool completed = fs.powerLossAfter > 0;
+      CHECK(interrupted == imported || IsOldOrNew(interrupted, defaults, imported));
+
+      fs.powerLossAfter = -1;
+      CHECK(Boot(fs) == imported);
+      CHECK(fs.files.count(legacyPath) == 0);
+      CHECK(Boot(fs) == imported);
+      if (completed) {
+        // The directory, the file, one commit per setting that differs from its default, a compaction of the metadata and the
+        // deletion of the legacy file
+        CHECK(changes >= 2 + 10 + 1 + 1);
+        break;
+      }
+    }
+  }
+
+  // The power is lost after each change made by a save, compactions of the metadata block included: after the next boot,
+  // each setting has either its old or its new value
+  void TestSavePowerLoss() {
+    Controllers::FS base;
+    Values oldValues;
+    {
+      Settings settings {base};
+      settings.Init();
+      Write(settings, 1);
+      settings.SaveSettings();
+      oldValues = Read(settings);
+    }
+    CHECK(Boot(base) == oldValues);
+
+    uint32_t compactions = 0;
+    for (int changes = 0;; changes++) {
+      Controllers::FS fs = base;
+      Values newValues;
+      {
+        Settings settings {fs};
+        settings.Init();
+        Write(settings, 2);
+        newValues = Read(settings);
+        fs.powerLossAfter = changes;
+        settings.SaveSettings();
+      }
+      const bool completed = fs.powerLossAfter > 0;
+      compactions += fs.compactions - base.compactions;
+      fs.powerLossAfter = -1;
+      const Values values = Boot(fs);
+      CHECK(IsOldOrNew(values, oldValues, newValues));
+      if (changes == 0) {
+        CHECK(values == oldValues);
+      }
+      if (completed) {
+        CHECK(values == newValues);
+        break;
+      }
+    }
+    CHECK(compactions > 0);
+  }
+
+  // A setting that couldn't be written is written again by the next save, even if nothing else changed
+  void TestSaveFailure() {
+    Controllers::FS fs;
+    Settings settings {fs};
+    settings.Init();
+    fs.failing = true;
+    settings.SetStepsGoal(4242);
+    settings.SaveSettings();
+    fs.failing = false;
+    CHECK(Boot(fs).stepsGoal == 10000);
+    settings.SaveSettings();
+    CHECK(Boot(fs).stepsGoal == 4242);
+
+    // Only the settings that changed are written
+    const size_t attributes = fs.attributes["/settings/values"].size();
+    settings.SetStepsGoal(4243);
+    settings.SaveSettings();
+    CHECK(fs.attributes["/settings/values"].size() == attributes);
+    CHECK(Boot(fs).stepsGoal == 4243);
+  }
+}
+
+int main() {
+  TestImportPowerLoss();
+  TestSavePowerLoss();
+  TestSaveFailure();
+  return Tests::Result();
+}
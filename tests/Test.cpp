@@ -0,0 +1,47 @@
+#include "Test.h"
+#include <cstdlib>
+#include <new>
+
+namespace {
+  size_t allocationCount = 0;
+  int failures = 0;
+}
+
+void* operator new(size_t size) {
+  allocationCount++;
+  if (void* ptr = std::malloc(size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void* ptr) noexcept {
+  std::free(ptr);
+}
+
+void operator delete(void* ptr, size_t /*size*/) noexcept {
+  std::free(ptr);
+}
+
+void Pinetime::Tests::Fail(const char* file, int line, const char* expression) {
+  // Only the first failures are printed, the properties are usually checked in loops
+  if (failures++ < 10) {
+    std::printf("%s:%d: CHECK(%s) failed\n", file, line, expression);
+  }
+}
+
+int Pinetime::Tests::Result() {
+  if (failures > 0) {
+    std::printf("%d checks failed\n", failures);
+    return 1;
+  }
+  return 0;
+}
+
+size_t Pinetime::Tests::AllocationCount() {
+  return allocationCount;
+}
+
+void vAssertCalled(const char* file, int line) {
+  Pinetime::Tests::Fail(file, line, "configASSERT");
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+
+/*
+ * Minimal test and benchmark helpers for the host tests (see tests/CMakeLists.txt).
+ *
+ * CHECK() reports the failed expression and makes the test executable return a failure. Benchmark() runs a function in a
+ * loop and prints the time and the number of heap allocations (operator new) per call.
+ */
+
+namespace Pinetime {
+  namespace Tests {
+    void Fail(const char* file, int line, const char* expression);
+
+    /** @return 0 if no CHECK() failed */
+    int Result();
+
+    /** Number of calls to operator new since the start of the program */
+    size_t AllocationCount();
+
+    /** Keeps the compiler from optimizing away the computation of value */
+    template <typename T>
+    inline void DoNotOptimize(const T& value) {
+      asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    template <typename F>
+    void Benchmark(const char* name, size_t iterations, F&& function) {
+      // Warm up the caches and the branch predictors
+      for (size_t i = 0; i < iterations / 10; i++) {
+        function(i);
+      }
+      const size_t allocations = AllocationCount();
+      const auto start = std::chrono::steady_clock::now();
+      for (size_t i = 0; i < iterations; i++) {
+        function(i);
+      }
+      const auto end = std::chrono::steady_clock::now();
+      const double ns = std::chrono::duration<double, std::nano>(end - start).count();
+      std::printf("%-48s %10.1f ns/op %8.2f allocs/op\n",
+                  name,
+                  ns / static_cast<double>(iterations),
+                  static_cast<double>(AllocationCount() - allocations) / static_cast<double>(iterations));
+    }
+  }
+}
+
+#define CHECK(expression) ((expression) ? static_cast<void>(0) : Pinetime::Tests::Fail(__FILE__, __LINE__, #expression))
@@ -0,0 +1,243 @@
+#include <vector>
+#include <hal/nrf_rtc.h>
+#include "Test.h"
+#include "components/datetime/DateTimeController.h"
+#include "components/fs/FS.h"
+#include "components/settings/Settings.h"
+#include "components/timer/TimerWheel.h"
+#include "systemtask/SystemTask.h"
+
+using namespace Pinetime;
+using Controllers::TimerWheel;
+using Events = TimerWheel::Events;
+
+namespace {
+  constexpr TimerWheel::Ticks ticksPerMinute = 60 * TimerWheel::ticksPerSecond;
+
+  // Calls the handler of RTC2 as the NVIC would, until the interrupt line goes low
+  void DispatchInterrupt(TimerWheel& wheel) {
+    while (nvicRtc2.enabled && nvicRtc2.pending) {
+      nvicRtc2.pending = false;
+      wheel.OnInterrupt();
+      NrfRtcUpdateIrq(NRF_RTC2);
+    }
+  }
+
+  void Advance(TimerWheel& wheel, TimerWheel::Ticks ticks) {
+    for (TimerWheel::Ticks i = 0; i < ticks; i++) {
+      NrfRtcTick(NRF_RTC2);
+      DispatchInterrupt(wheel);
+    }
+  }
+
+  struct Firing {
+    Events event;
+    TimerWheel::Ticks time;
+  };
+
+  struct Recorder {
+    TimerWheel* wheel;
+    std::vector<Firing> firings;
+  };
+
+  struct Context {
+    Recorder* recorder;
+    Events event;
+  };
+
+  void Record(void* context) {
+    auto* c = static_cast<Context*>(context);
+    c->recorder->firings.push_back({c->event, c->recorder->wheel->Now()});
+  }
+
+  struct Fixture {
+    Fixture() {
+      nrfRtc2 = {};
+      nvicRtc2 = {};
+      wheel.Init();
+    }
+
+    void Schedule(Events event, TimerWheel::Ticks deadline) {
+      wheel.Schedule(event, deadline, Record, &contexts[static_cast<uint8_t>(event)]);
+      DispatchInterrupt(wheel);
+    }
+
+    TimerWheel wheel;
+    Recorder recorder {&wheel, {}};
+    Context contexts[3] {{&recorder, Events::Alarm}, {&recorder, Events::Timer}, {&recorder, Events::Chime}};
+  };
+
+  // The deadline is past the end of the 24-bit counter: the compare value wraps around 0xFFFFFF
+  void TestCompareWrap() {
+    Fixture f;
+    CHECK(nrfRtc2.prescaler == 31);
+    nrfRtc2.counter = 0xffffff - 10;
+    const TimerWheel::Ticks start = f.wheel.Now();
+    f.Schedule(Events::Timer, start + 20);
+    CHECK(nrfRtc2.cc[0] == 9);
+    Advance(f.wheel, 19);
+    CHECK(f.recorder.firings.empty());
+    CHECK(f.wheel.Remaining(Events::Timer) == 1);
+    Advance(f.wheel, 1);
+    CHECK(f.recorder.firings.size() == 1);
+    CHECK(f.recorder.firings[0].time == start + 20);
+    // The overflow was counted: the time keeps increasing past 24 bits
+    CHECK(f.wheel.Now() == 0x1000000 + 9);
+    CHECK(!f.wheel.IsScheduled(Events::Timer));
+  }
+
+  // Deadlines further than half the period of the counter are reached in several steps
+  void TestLongDelay() {
+    Fixture f;
+    const TimerWheel::Ticks deadline = f.wheel.Now() + 3 * 60 * ticksPerMinute;
+    f.Schedule(Events::Alarm, deadline);
+    Advance(f.wheel, deadline - 1);
+    CHECK(f.recorder.firings.empty());
+    Advance(f.wheel, 1);
+    CHECK(f.recorder.firings.size() == 1 && f.recorder.firings[0].time == deadline);
+  }
+
+  // The events due in the same tick are all dispatched by the same interrupt, in the order of their deadlines
+  void TestSameTick() {
+    Fixture f;
+    const TimerWheel::Ticks now = f.wheel.Now();
+    f.Schedule(Events::Chime, now + 100);
+    f.Schedule(Events::Alarm, now + 100);
+    f.Schedule(Events::Timer, now + 100);
+    Advance(f.wheel, 100);
+    CHECK(f.recorder.firings.size() == 3);
+    for (const auto& firing : f.recorder.firings) {
+      CHECK(firing.time == now + 100);
+    }
+
+    // Deadlines that are already over are dispatched right away, the oldest first
+    f.recorder.firings.clear();
+    nrf_rtc_int_disable(NRF_RTC2, NRF_RTC_INT_COMPARE0_MASK);
+    Advance(f.wheel, 10);
+    const TimerWheel::Ticks late = f.wheel.Now();
+    f.wheel.Schedule(Events::Alarm, late - 2, Record, &f.contexts[0]);
+    f.wheel.Schedule(Events::Timer, late - 5, Record, &f.contexts[1]);
+    f.wheel.Schedule(Events::Chime, late - 1, Record, &f.contexts[2]);
+    DispatchInterrupt(f.wheel);
+    CHECK(f.recorder.firings.size() == 3);
+    CHECK(f.recorder.firings[0].event == Events::Timer);
+    CHECK(f.recorder.firings[1].event == Events::Alarm);
+    CHECK(f.recorder.firings[2].event == Events::Chime);
+  }
+
+  struct Rearming {
+    TimerWheel* wheel;
+    TimerWheel::Ticks period;
+    TimerWheel::Ticks deadline;
+    std::vector<TimerWheel::Ticks> firings;
+  };
+
+  void Rearm(void* context) {
+    auto* r = static_cast<Rearming*>(context);
+    r->firings.push_back(r->wheel->Now());
+    r->deadline += r->period;
+    r->wheel->Schedule(Events::Chime, r->deadline, Rearm, r);
+  }
+
+  void CancelTimer(void* context) {
+    static_cast<TimerWheel*>(context)->Cancel(Events::Timer);
+  }
+
+  void TestCancelAndRearm() {
+    Fixture f;
+    const TimerWheel::Ticks now = f.wheel.Now();
+    f.Schedule(Events::Timer, now + 100);
+    Advance(f.wheel, 50);
+    f.wheel.Cancel(Events::Timer);
+    CHECK(!f.wheel.IsScheduled(Events::Timer));
+    CHECK(f.wheel.Remaining(Events::Timer) == 0);
+    Advance(f.wheel, 100);
+    CHECK(f.recorder.firings.empty());
+
+    // Scheduling the event again replaces its deadline
+    f.Schedule(Events::Timer, f.wheel.Now() + 500);
+    f.Schedule(Events::Timer, f.wheel.Now() + 200);
+    const TimerWheel::Ticks rearmed = f.wheel.Now() + 200;
+    Advance(f.wheel, 600);
+    CHECK(f.recorder.firings.size() == 1 && f.recorder.firings[0].time == rearmed);
+
+    // An event rescheduled by its own callback fires again one period later, and an event cancelled by the callback of an
+    // event due in the same tick doesn't fire
+    f.recorder.firings.clear();
+    Rearming rearming {&f.wheel, 30, f.wheel.Now() + 30, {}};
+    f.wheel.Schedule(Events::Chime, rearming.deadline, Rearm, &rearming);
+    const TimerWheel::Ticks start = f.wheel.Now();
+    f.wheel.Schedule(Events::Alarm, start + 60, CancelTimer, &f.wheel);
+    f.Schedule(Events::Timer, start + 60);
+    Advance(f.wheel, 95);
+    CHECK(rearming.firings.size() == 3);
+    for (size_t i = 0; i < rearming.firings.size(); i++) {
+      CHECK(rearming.firings[i] == start + 30 * (i + 1));
+    }
+    CHECK(f.recorder.firings.empty());
+    CHECK(!f.wheel.IsScheduled(Events::Timer));
+    f.wheel.Cancel(Events::Chime);
+    Advance(f.wheel, 100);
+    CHECK(rearming.firings.size() == 3);
+  }
+
+  size_t Count(const std::vector<System::Messages>& messages, System::Messages message) {
+    size_t count = 0;
+    for (auto m : messages) {
+      count += m == message;
+    }
+    return count;
+  }
+
+  // When DST ends, the clock goes back from 03:00 to 02:00: the chime of 03:00 must not ring one hour early
+  void TestChimeAfterDstShift() {
+    Fixture f;
+    Controllers::FS fs;
+    Controllers::Settings settings {fs};
+    Controllers::DateTime dateTime {settings, f.wheel};
+    System::SystemTask systemTask;
+    dateTime.Register(&systemTask);
+    auto& messages = systemTask.messages;
+
+    dateTime.SetTimeZone(4, 4);
+    dateTime.SetTime(2024, 10, 27, 2, 59, 0);
+    CHECK(f.wheel.Remaining(Events::Chime) == ticksPerMinute);
+    Advance(f.wheel, 30 * TimerWheel::ticksPerSecond);
+
+    // The companion app sends the new local time, then the new time zone information. The system task has kept the clock up to date.
+    dateTime.UpdateTime(nrf_rtc_counter_get(NRF_RTC2));
+    dateTime.SetTime(2024, 10, 27, 2, 0, 30);
+    dateTime.SetTimeZone(4, 0);
+    CHECK(dateTime.DstOffset() == 0);
+    messages.clear();
+    const TimerWheel::Ticks toHalfHour = 29 * ticksPerMinute + 30 * TimerWheel::ticksPerSecond;
+    CHECK(f.wheel.Remaining(Events::Chime) == toHalfHour);
+    Advance(f.wheel, toHalfHour - 1);
+    CHECK(messages.empty());
+    Advance(f.wheel, 1);
+    CHECK(Count(messages, System::Messages::OnNewHalfHour) == 1);
+    CHECK(Count(messages, System::Messages::OnNewHour) == 0);
+
+    messages.clear();
+    Advance(f.wheel, 30 * ticksPerMinute);
+    CHECK(Count(messages, System::Messages::OnNewHalfHour) == 1);
+    CHECK(Count(messages, System::Messages::OnNewHour) == 1);
+
+    // A change of the time zone alone reschedules the chime from the local time. The clock and the timer wheel count the same
+    // ticks, from the same start.
+    Advance(f.wheel, 30 * TimerWheel::ticksPerSecond);
+    dateTime.UpdateTime(nrf_rtc_counter_get(NRF_RTC2));
+    CHECK(dateTime.Hours() == 3 && dateTime.Minutes() == 0 && dateTime.Seconds() == 30);
+    dateTime.SetTimeZone(23, 0);
+    CHECK(f.wheel.Remaining(Events::Chime) == toHalfHour);
+  }
+}
+
+int main() {
+  TestCompareWrap();
+  TestLongDelay();
+  TestSameTick();
+  TestCancelAndRearm();
+  TestChimeAfterDstShift();
+  return Tests::Result();
+}
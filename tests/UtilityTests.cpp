@@ -0,0 +1,202 @@
+#include <deque>
+#include <random>
+#include <string>
+#include <vector>
+#include <lvgl/src/lv_misc/lv_math.h>
+#include "Test.h"
+#include "utility/CircularBuffer.h"
+#include "utility/DirtyValue.h"
+#include "utility/FixedString.h"
+#include "utility/LinearApproximation.h"
+#include "utility/Math.h"
+#include "utility/StaticStack.h"
+
+using namespace Pinetime;
+
+namespace {
+  void TestCircularBuffer(std::mt19937& random) {
+    // The element n is always the one written n increments after the current one, whatever the rotations
+    Utility::CircularBuffer<int, 7> buffer {};
+    std::vector<int> model(7, 0);
+    size_t start = 0;
+    for (int i = 0; i < 10000; i++) {
+      switch (random() % 4) {
+        case 0:
+          buffer++;
+          start = (start + 1) % 7;
+          break;
+        case 1:
+          buffer--;
+          start = (start + 6) % 7;
+          break;
+        default: {
+          const size_t n = random() % 7;
+          buffer[n] = i;
+          model[(start + n) % 7] = i;
+        }
+      }
+      CHECK(buffer.Idx() == start);
+      for (size_t n = 0; n < buffer.Size(); n++) {
+        CHECK(buffer[n] == model[(start + n) % 7]);
+      }
+    }
+  }
+
+  void TestDirtyValue() {
+    Utility::DirtyValue<int> value;
+    CHECK(value.IsUpdated());
+    CHECK(!value.IsUpdated());
+    value = 0;
+    CHECK(!value.IsUpdated());
+    value = 3;
+    CHECK(value.Get() == 3);
+    CHECK(!value.IsUpdated());
+    value = 4;
+    value = 3;
+    CHECK(value.IsUpdated());
+    CHECK(!value.IsUpdated());
+
+    Utility::DirtyValue<int> initialized {5};
+    CHECK(initialized.IsUpdated());
+    CHECK(initialized.Get() == 5);
+  }
+
+  void TestFixedString() {
+    Utility::FixedString<8> empty;
+    CHECK(empty.View().empty());
+    CHECK(empty.View().data()[0] == '\0');
+
+    Utility::FixedString<8> string {"Artist"};
+    CHECK(string.View() == "Artist");
+    string.Assign("12345678", 8);
+    CHECK(string.View() == "12345678");
+    CHECK(string.View().data()[8] == '\0');
+    string.Assign("123456789", 9);
+    CHECK(string.View() == "12345678");
+    CHECK(Utility::FixedString<8>::Capacity() == 8);
+
+    // Truncated on a character boundary: "é" is 2 bytes, "€" 3 bytes and "😀" 4 bytes
+    string.Assign("1234567\xc3\xa9", 9);
+    CHECK(string.View() == "1234567");
+    string.Assign("123456\xc3\xa9", 8);
+    CHECK(string.View() == "123456\xc3\xa9");
+    string.Assign("123456\xe2\x82\xac", 9);
+    CHECK(string.View() == "123456");
+    string.Assign("12345\xe2\x82\xac!", 9);
+    CHECK(string.View() == "12345\xe2\x82\xac");
+    string.Assign("12345\xf0\x9f\x98\x80", 9);
+    CHECK(string.View() == "12345");
+    string.Assign("\xf0\x9f\x98\x80\xf0\x9f\x98\x80\xf0", 9);
+    CHECK(string.View() == "\xf0\x9f\x98\x80\xf0\x9f\x98\x80");
+
+    // Every truncation of a mixed string ends on a character boundary
+    const std::string text = "a\xc3\xa9\xe2\x82\xac\xf0\x9f\x98\x80" "b\xc3\xa9";
+    for (size_t length = 0; length <= text.size(); length++) {
+      const size_t prefix = Utility::Utf8Prefix(text.data(), length, 4);
+      CHECK(prefix <= 4 && prefix <= length);
+      CHECK(prefix == length || (static_cast<uint8_t>(text[prefix]) & 0xc0) != 0x80);
+    }
+  }
+
+  void TestStaticStack(std::mt19937& random) {
+    Utility::StaticStack<int, 5> stack;
+    std::vector<int> model;
+    CHECK(stack.Empty());
+    CHECK(stack.Pop() == 0);
+    CHECK(stack.Top() == 0);
+    for (int i = 1; i < 10000; i++) {
+      switch (random() % 5) {
+        case 0:
+        case 1:
+          stack.Push(i);
+          if (model.size() < 5) {
+            model.push_back(i);
+          }
+          break;
+        case 2:
+        case 3:
+          CHECK(stack.Pop() == (model.empty() ? 0 : model.back()));
+          if (!model.empty()) {
+            model.pop_back();
+          }
+          break;
+        default:
+          if (random() % 20 == 0) {
+            stack.Reset();
+            model.clear();
+          }
+      }
+      CHECK(stack.Empty() == model.empty());
+      CHECK(stack.Top() == (model.empty() ? 0 : model.back()));
+    }
+  }
+
+  void TestLinearApproximation() {
+    // Same shape as the discharge curve of the battery controller
+    const Utility::LinearApproximation<uint16_t, uint8_t, 6> curve {{{{3500, 0}, {3616, 3}, {3723, 22}, {3776, 48}, {3979, 79}, {4180, 100}}}};
+    CHECK(curve.GetValue(0) == 0);
+    CHECK(curve.GetValue(3500) == 0);
+    CHECK(curve.GetValue(3723) == 22);
+    CHECK(curve.GetValue(4180) == 100);
+    CHECK(curve.GetValue(5000) == 100);
+    uint8_t previous = 0;
+    for (uint16_t voltage = 3400; voltage < 4300; voltage++) {
+      const uint8_t value = curve.GetValue(voltage);
+      CHECK(value >= previous);
+      CHECK(value <= 100);
+      previous = value;
+    }
+  }
+
+  void TestAsin() {
+    // Exact on the sine of every integer angle
+    for (int16_t angle = -90; angle <= 90; angle++) {
+      CHECK(Utility::Asin(_lv_trigo_sin(angle)) == angle);
+    }
+    // Odd, monotonic and within [-90, 90] on the whole input range
+    int16_t previous = -90;
+    for (int32_t arg = -LV_TRIGO_SIN_MAX; arg <= LV_TRIGO_SIN_MAX; arg++) {
+      const int16_t angle = Utility::Asin(static_cast<int16_t>(arg));
+      CHECK(angle >= previous);
+      CHECK(angle >= -90 && angle <= 90);
+      CHECK(Utility::Asin(static_cast<int16_t>(-arg)) == -angle);
+      previous = angle;
+    }
+  }
+
+  void Benchmarks() {
+    Utility::CircularBuffer<int, 16> buffer {};
+    Tests::Benchmark("CircularBuffer: write and increment", 10000000, [&](size_t i) {
+      buffer[15] = static_cast<int>(i);
+      buffer++;
+      Tests::DoNotOptimize(buffer);
+    });
+
+    Utility::StaticStack<uint8_t, 10> stack;
+    Tests::Benchmark("StaticStack: push and pop", 10000000, [&](size_t i) {
+      stack.Push(static_cast<uint8_t>(i));
+      Tests::DoNotOptimize(stack.Pop());
+    });
+
+    const Utility::LinearApproximation<uint16_t, uint8_t, 6> curve {{{{3500, 0}, {3616, 3}, {3723, 22}, {3776, 48}, {3979, 79}, {4180, 100}}}};
+    Tests::Benchmark("LinearApproximation: 6 points", 10000000, [&](size_t i) {
+      Tests::DoNotOptimize(curve.GetValue(static_cast<uint16_t>(3400 + i % 900)));
+    });
+
+    Tests::Benchmark("Asin", 1000000, [](size_t i) {
+      Tests::DoNotOptimize(Utility::Asin(static_cast<int16_t>(i % 65535 - LV_TRIGO_SIN_MAX)));
+    });
+  }
+}
+
+int main() {
+  std::mt19937 random {1};
+  TestCircularBuffer(random);
+  TestDirtyValue();
+  TestFixedString();
+  TestStaticStack(random);
+  TestLinearApproximation();
+  TestAsin();
+  Benchmarks();
+  return Tests::Result();
+}
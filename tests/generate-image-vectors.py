@@ -0,0 +1,92 @@
+#!/usr/bin/env python3
+"""
+Writes the test vectors of ImageDecoderTests: data compressed and images converted by the encoders of
+src/resources/lv_img_conv.py, so that the decoder is checked against what the resource package actually contains.
+
+    generate-image-vectors.py <lv_img_conv.py> <output header>
+"""
+import importlib.util
+import sys
+
+
+class Image:
+    """The subset of a Pillow image that the converters of lv_img_conv.py use"""
+    def __init__(self, width, height, pixel):
+        self.width = width
+        self.height = height
+        self.pixel = pixel
+
+    def convert(self, mode):
+        assert mode == "RGBA"
+        return self
+
+    def getpixel(self, position):
+        return self.pixel(*position)
+
+
+def array(data):
+    return "{" + ", ".join(str(b) for b in data) + "}"
+
+
+def main():
+    spec = importlib.util.spec_from_file_location("lv_img_conv", sys.argv[1])
+    conv = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(conv)
+
+    samples = [
+        b"\x01",
+        bytes(240 * 3),
+        bytes(range(256)) * 3,
+        b"\x00\x00\xff" * 40 + bytes(range(60)) + b"\x12\x34\x56" * 200,
+        bytes((i * 7) & 0xF0 for i in range(720)),
+        bytes((i * i) & 0xFF for i in range(600)),
+        b"\xab" * 300 + bytes(range(200)) + b"\xab" * 20,
+    ]
+    compressed = []
+    for sample in samples:
+        compressed.append(("Rle", 1, sample, conv.rle_encode(sample, 1)))
+        if len(sample) % 3 == 0:
+            compressed.append(("Rle", 3, sample, conv.rle_encode(sample, 3)))
+        if len(sample) % 2 == 0:
+            compressed.append(("Rle", 2, sample, conv.rle_encode(sample, 2)))
+        compressed.append(("Lz4", 1, sample, conv.lz4_compress(sample)))
+
+    # A few colors in stripes and blocks, with enough rows for several entries of the index
+    palette = [(0, 0, 0, 0), (255, 255, 255, 255), (200, 30, 60, 255), (20, 120, 250, 128)]
+    indexed = Image(37, 40, lambda x, y: palette[(x // 5 + y // 3) % 4] if x % 11 else palette[1])
+    gradient = Image(30, 20, lambda x, y: (x * 8, y * 12, (x + y) * 5, 255 if y % 2 else x * 8))
+    images = []
+    for name, img, color_format in [("Indexed2Bit", indexed, "CF_INDEXED_2_BIT"), ("TrueColorAlpha", gradient, "CF_TRUE_COLOR_ALPHA")]:
+        (color_format, pal, rows), = conv.color_format_candidates(img, color_format)
+        lv_cf = conv.LV_CF[color_format]
+        for compression in ["none", "rle", "lz4"]:
+            data = conv.encode_compressed(lv_cf, img.width, img.height, pal, rows, compression)
+            images.append((f"{name}, {compression}", lv_cf, img.width, img.height, pal, b"".join(rows), data, True))
+        data = conv.encode_plain(lv_cf, img.width, img.height, pal, rows)
+        images.append((f"{name}, plain", lv_cf, img.width, img.height, pal, b"".join(rows), data, False))
+
+    with open(sys.argv[2], "w") as out:
+        out.write("#pragma once\n\n")
+        out.write("// Generated by tests/generate-image-vectors.py from the encoders of src/resources/lv_img_conv.py\n\n")
+        out.write("#include <cstdint>\n#include <vector>\n\n")
+        out.write("namespace ImageVectors {\n")
+        out.write("  struct Compressed {\n    const char* compression;\n    uint8_t unitSize;\n")
+        out.write("    std::vector<uint8_t> data;\n    std::vector<uint8_t> encoded;\n  };\n\n")
+        out.write("  inline const std::vector<Compressed> compressed = {\n")
+        for compression, unit, data, encoded in compressed:
+            out.write(f'    {{"{compression}", {unit}, {array(data)}, {array(encoded)}}},\n')
+        out.write("  };\n\n")
+        out.write("  // The rows are the uncompressed rows in the color format of the image, the palette is in BGRA\n")
+        out.write("  struct Image {\n    const char* name;\n    uint8_t format;\n    uint16_t width;\n    uint16_t height;\n")
+        out.write("    std::vector<uint8_t> palette;\n    std::vector<uint8_t> rows;\n    std::vector<uint8_t> file;\n")
+        out.write("    bool compressed;\n  };\n\n")
+        out.write("  inline const std::vector<Image> images = {\n")
+        for name, lv_cf, width, height, pal, rows, data, is_compressed in images:
+            out.write(f'    {{"{name}", {lv_cf}, {width}, {height}, {array(pal)}, {array(rows)}, {array(data)}, '
+                      f'{"true" if is_compressed else "false"}}},\n')
+        out.write("  };\n}\n")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,36 @@
+#pragma once
+
+// Host stub of the FreeRTOS types used by the components under test: the tests run on a single thread
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+
+using TickType_t = uint32_t;
+using BaseType_t = long;
+using UBaseType_t = unsigned long;
+
+#define pdTRUE        1
+#define pdPASS        pdTRUE
+#define portMAX_DELAY 0xffffffffUL
+
+// configASSERT() reports a failure of the test instead of halting (see Test.cpp)
+void vAssertCalled(const char* file, int line);
+#define configASSERT(x)                                                                                                                    \
+  do {                                                                                                                                     \
+    if ((x) == 0) {                                                                                                                        \
+      vAssertCalled(__FILE__, __LINE__);                                                                                                   \
+    }                                                                                                                                      \
+  } while (0)
+
+// There are no interrupts on the host: the tests call the interrupt handlers themselves
+#define portSET_INTERRUPT_MASK_FROM_ISR()      0UL
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(mask) static_cast<void>(mask)
+
+inline void* pvPortMalloc(size_t size) {
+  return std::malloc(size);
+}
+
+inline void vPortFree(void* ptr) {
+  std::free(ptr);
+}
@@ -0,0 +1,190 @@
+#pragma once
+
+// Host stub of Controllers::FS: the files are kept in memory
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "littlefs/lfs.h"
+
+namespace Pinetime {
+  namespace Controllers {
+    class FS {
+    public:
+      int FileOpen(lfs_file_t* file, const char* fileName, const int flags) {
+        if (failing) {
+          return LFS_ERR_IO;
+        }
+        if (files.count(fileName) == 0 && (flags & LFS_O_CREAT) == 0) {
+          return LFS_ERR_NOENT;
+        }
+        if ((files.count(fileName) == 0 || (flags & LFS_O_TRUNC) != 0) && !Commit()) {
+          return LFS_ERR_IO;
+        }
+        auto& content = files[fileName];
+        if ((flags & LFS_O_TRUNC) != 0) {
+          content.clear();
+        }
+        file->name = fileName;
+        file->position = 0;
+        return LFS_ERR_OK;
+      }
+
+      int FileClose(lfs_file_t* /*file*/) {
+        return LFS_ERR_OK;
+      }
+
+      int FileRead(lfs_file_t* file, uint8_t* buffer, uint32_t size) {
+        const auto& content = files[file->name];
+        if (file->position >= content.size()) {
+          return 0;
+        }
+        const uint32_t count = std::min<uint32_t>(size, content.size() - file->position);
+        std::memcpy(buffer, content.data() + file->position, count);
+        file->position += count;
+        bytesRead += count;
+        return static_cast<int>(count);
+      }
+
+      int FileWrite(lfs_file_t* file, const uint8_t* buffer, uint32_t size) {
+        if (!Commit()) {
+          return LFS_ERR_IO;
+        }
+        auto& content = files[file->name];
+        if (file->position < content.size()) {
+          overwrites++;
+        }
+        if (content.size() < file->position + size) {
+          content.resize(file->position + size);
+        }
+        std::memcpy(content.data() + file->position, buffer, size);
+        file->position += size;
+        return static_cast<int>(size);
+      }
+
+      int FileSeek(lfs_file_t* file, uint32_t position) {
+        file->position = position;
+        return static_cast<int>(position);
+      }
+
+      int FileDelete(const char* fileName) {
+        if (!Commit()) {
+          return LFS_ERR_IO;
+        }
+        return files.erase(fileName) == 1 ? LFS_ERR_OK : LFS_ERR_NOENT;
+      }
+
+      int Rename(const char* oldPath, const char* newPath) {
+        if (failing || failingRename || !Commit()) {
+          return LFS_ERR_IO;
+        }
+        renames++;
+        auto it = files.find(oldPath);
+        if (it == files.end()) {
+          return LFS_ERR_NOENT;
+        }
+        files[newPath] = std::move(it->second);
+        files.erase(oldPath);
+        return LFS_ERR_OK;
+      }
+
+      int DirCreate(const char* path) {
+        if (failing || !Commit()) {
+          return LFS_ERR_IO;
+        }
+        return directories.insert(path).second ? LFS_ERR_OK : LFS_ERR_EXIST;
+      }
+
+      int Stat(const char* path, lfs_info* info) {
+        if (failing) {
+          return LFS_ERR_IO;
+        }
+        if (directories.count(path) != 0) {
+          info->type = LFS_TYPE_DIR;
+          info->size = 0;
+        } else if (files.count(path) != 0) {
+          info->type = LFS_TYPE_REG;
+          info->size = files[path].size();
+        } else {
+          return LFS_ERR_NOENT;
+        }
+        std::strncpy(info->name, path, sizeof(info->name) - 1);
+        info->name[sizeof(info->name) - 1] = '\0';
+        return LFS_ERR_OK;
+      }
+
+      int GetAttribute(const char* path, uint8_t type, void* buffer, uint32_t size) {
+        if (failing) {
+          return LFS_ERR_IO;
+        }
+        if (files.count(path) == 0 && directories.count(path) == 0) {
+          return LFS_ERR_NOENT;
+        }
+        auto it = attributes[path].find(type);
+        if (it == attributes[path].end()) {
+          return LFS_ERR_NOATTR;
+        }
+        std::memcpy(buffer, it->second.data(), std::min<size_t>(size, it->second.size()));
+        return static_cast<int>(it->second.size());
+      }
+
+      int SetAttribute(const char* path, uint8_t type, const void* buffer, uint32_t size) {
+        if (failing) {
+          return LFS_ERR_IO;
+        }
+        if (files.count(path) == 0 && directories.count(path) == 0) {
+          return LFS_ERR_NOENT;
+        }
+        // The commit is appended to the metadata block of the file, which is compacted first when it is full
+        if (++attributeCommits[path] % commitsPerCompaction == 0) {
+          if (!Commit()) {
+            return LFS_ERR_IO;
+          }
+          compactions++;
+        }
+        if (!Commit()) {
+          return LFS_ERR_IO;
+        }
+        const auto* bytes = static_cast<const uint8_t*>(buffer);
+        attributes[path][type].assign(bytes, bytes + size);
+        return LFS_ERR_OK;
+      }
+
+      // Changes that reach the flash before the power is lost, negative for no power loss. As in littlefs, each change is
+      // atomic: the change interrupted by the power loss is discarded, and the following ones fail. Set it back to a negative
+      // value to simulate the next boot.
+      int powerLossAfter = -1;
+      static constexpr uint32_t commitsPerCompaction = 8;
+      uint32_t compactions = 0;
+
+      // Every call that opens a file or changes the metadata fails while set, as when the file system is full or corrupted
+      bool failing = false;
+      bool failingRename = false;
+      uint32_t renames = 0;
+      // Bytes read from all the files, to measure the traffic on the SPI flash
+      uint32_t bytesRead = 0;
+      // Writes that start before the end of the file, which make littlefs copy the rest of the file
+      uint32_t overwrites = 0;
+      std::map<std::string, std::vector<uint8_t>> files;
+      std::set<std::string> directories;
+      std::map<std::string, std::map<uint8_t, std::vector<uint8_t>>> attributes;
+
+    private:
+      bool Commit() {
+        if (powerLossAfter == 0) {
+          return false;
+        }
+        if (powerLossAfter > 0) {
+          powerLossAfter--;
+        }
+        return true;
+      }
+
+      std::map<std::string, uint32_t> attributeCommits;
+    };
+  }
+}
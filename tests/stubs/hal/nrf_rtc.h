@@ -0,0 +1,124 @@
+#pragma once
+
+// Host stub of the registers of the RTC and of the NVIC used by Controllers::TimerWheel.
+// The counter only advances when the test calls NrfRtcTick(), which raises the events and the interrupt as the hardware does.
+
+#include <cstdint>
+
+enum IRQn_Type { RTC2_IRQn = 36 };
+
+enum nrf_rtc_task_t { NRF_RTC_TASK_START, NRF_RTC_TASK_STOP, NRF_RTC_TASK_CLEAR };
+enum nrf_rtc_event_t { NRF_RTC_EVENT_COMPARE_0, NRF_RTC_EVENT_OVERFLOW };
+
+#define NRF_RTC_INT_OVERFLOW_MASK 0x00000002UL
+#define NRF_RTC_INT_COMPARE0_MASK 0x00010000UL
+
+struct NRF_RTC_Type {
+  bool running = false;
+  uint32_t prescaler = 0;
+  uint32_t counter = 0;
+  uint32_t cc[4] {};
+  bool compareEvent = false;
+  bool overflowEvent = false;
+  uint32_t interrupts = 0;
+};
+
+struct NvicIrq {
+  bool enabled = false;
+  bool pending = false;
+  uint32_t priority = 0;
+};
+
+inline NRF_RTC_Type nrfRtc2;
+inline NvicIrq nvicRtc2;
+#define NRF_RTC2 (&nrfRtc2)
+
+inline void NVIC_SetPriority(IRQn_Type /*irq*/, uint32_t priority) {
+  nvicRtc2.priority = priority;
+}
+
+inline void NVIC_EnableIRQ(IRQn_Type /*irq*/) {
+  nvicRtc2.enabled = true;
+}
+
+inline void NVIC_ClearPendingIRQ(IRQn_Type /*irq*/) {
+  nvicRtc2.pending = false;
+}
+
+inline void NVIC_SetPendingIRQ(IRQn_Type /*irq*/) {
+  nvicRtc2.pending = true;
+}
+
+// The interrupt line of the RTC stays high as long as an enabled event is set
+inline bool NrfRtcInterruptLine(const NRF_RTC_Type* rtc) {
+  return (rtc->compareEvent && (rtc->interrupts & NRF_RTC_INT_COMPARE0_MASK) != 0) ||
+         (rtc->overflowEvent && (rtc->interrupts & NRF_RTC_INT_OVERFLOW_MASK) != 0);
+}
+
+inline void NrfRtcUpdateIrq(const NRF_RTC_Type* rtc) {
+  if (NrfRtcInterruptLine(rtc)) {
+    nvicRtc2.pending = true;
+  }
+}
+
+inline void nrf_rtc_task_trigger(NRF_RTC_Type* rtc, nrf_rtc_task_t task) {
+  switch (task) {
+    case NRF_RTC_TASK_START:
+      rtc->running = true;
+      break;
+    case NRF_RTC_TASK_STOP:
+      rtc->running = false;
+      break;
+    case NRF_RTC_TASK_CLEAR:
+      rtc->counter = 0;
+      break;
+  }
+}
+
+inline void nrf_rtc_prescaler_set(NRF_RTC_Type* rtc, uint32_t prescaler) {
+  rtc->prescaler = prescaler;
+}
+
+inline uint32_t nrf_rtc_counter_get(const NRF_RTC_Type* rtc) {
+  return rtc->counter;
+}
+
+inline void nrf_rtc_cc_set(NRF_RTC_Type* rtc, uint32_t channel, uint32_t value) {
+  rtc->cc[channel] = value;
+}
+
+inline bool nrf_rtc_event_pending(const NRF_RTC_Type* rtc, nrf_rtc_event_t event) {
+  return event == NRF_RTC_EVENT_COMPARE_0 ? rtc->compareEvent : rtc->overflowEvent;
+}
+
+inline void nrf_rtc_event_clear(NRF_RTC_Type* rtc, nrf_rtc_event_t event) {
+  if (event == NRF_RTC_EVENT_COMPARE_0) {
+    rtc->compareEvent = false;
+  } else {
+    rtc->overflowEvent = false;
+  }
+}
+
+inline void nrf_rtc_int_enable(NRF_RTC_Type* rtc, uint32_t mask) {
+  rtc->interrupts |= mask;
+  NrfRtcUpdateIrq(rtc);
+}
+
+inline void nrf_rtc_int_disable(NRF_RTC_Type* rtc, uint32_t mask) {
+  rtc->interrupts &= ~mask;
+}
+
+// One period of the prescaled clock: the 24-bit counter is incremented, and the events are raised
+inline void NrfRtcTick(NRF_RTC_Type* rtc) {
+  if (!rtc->running) {
+    return;
+  }
+  rtc->counter = (rtc->counter + 1) & 0xffffff;
+  if (rtc->counter == 0) {
+    rtc->overflowEvent = true;
+  }
+  if (rtc->counter == rtc->cc[0]) {
+    rtc->compareEvent = true;
+  }
+  NrfRtcUpdateIrq(rtc);
+}
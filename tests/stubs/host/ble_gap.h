@@ -0,0 +1,68 @@
+#pragma once
+
+// Host stub of the NimBLE GATT server API used by the BLE services: the tests call OnCommand() with a context that holds
+// the written value.
+// The services include the NimBLE headers with min and max defined as empty macros: no standard header can be included here.
+
+#include <cstdint>
+#include "host/ble_uuid.h"
+
+#define ASSERT(x) static_cast<void>(x)
+
+#define BLE_GATT_ACCESS_OP_READ_CHR  0
+#define BLE_GATT_ACCESS_OP_WRITE_CHR 1
+#define BLE_GATT_CHR_F_READ          0x0002
+#define BLE_GATT_CHR_F_WRITE         0x0008
+#define BLE_GATT_CHR_F_NOTIFY        0x0010
+#define BLE_GATT_SVC_TYPE_PRIMARY    1
+
+struct os_mbuf {
+  uint8_t data[512];
+  uint16_t length;
+};
+
+#define OS_MBUF_PKTLEN(om) ((om)->length)
+
+inline int os_mbuf_copydata(const os_mbuf* om, int offset, int length, void* destination) {
+  if (offset + length > om->length) {
+    return -1;
+  }
+  for (int i = 0; i < length; i++) {
+    static_cast<uint8_t*>(destination)[i] = om->data[offset + i];
+  }
+  return 0;
+}
+
+struct ble_gatt_access_ctxt;
+using ble_gatt_access_fn = int(uint16_t conn_handle, uint16_t attr_handle, ble_gatt_access_ctxt* ctxt, void* arg);
+
+struct ble_gatt_chr_def {
+  const ble_uuid_t* uuid;
+  ble_gatt_access_fn* access_cb;
+  void* arg;
+  void* descriptors;
+  uint16_t flags;
+  uint8_t min_key_size;
+  uint16_t* val_handle;
+};
+
+struct ble_gatt_svc_def {
+  uint8_t type;
+  const ble_uuid_t* uuid;
+  const ble_gatt_svc_def** includes;
+  const ble_gatt_chr_def* characteristics;
+};
+
+struct ble_gatt_access_ctxt {
+  uint8_t op;
+  os_mbuf* om;
+  const ble_gatt_chr_def* chr;
+};
+
+inline int ble_gatts_count_cfg(const ble_gatt_svc_def* /*services*/) {
+  return 0;
+}
+
+inline int ble_gatts_add_svcs(const ble_gatt_svc_def* /*services*/) {
+  return 0;
+}
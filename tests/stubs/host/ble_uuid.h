@@ -0,0 +1,29 @@
+#pragma once
+
+// Host stub of the NimBLE UUID types, see host/ble_gap.h
+
+#include <cstdint>
+
+#define BLE_UUID_TYPE_16  16
+#define BLE_UUID_TYPE_128 128
+
+struct ble_uuid_t {
+  uint8_t type;
+};
+
+struct ble_uuid128_t {
+  ble_uuid_t u;
+  uint8_t value[16];
+};
+
+inline int ble_uuid_cmp(const ble_uuid_t* uuid1, const ble_uuid_t* uuid2) {
+  // The services under test only use 128-bit UUIDs
+  const auto* value1 = reinterpret_cast<const ble_uuid128_t*>(uuid1)->value;
+  const auto* value2 = reinterpret_cast<const ble_uuid128_t*>(uuid2)->value;
+  for (int i = 0; i < 16; i++) {
+    if (value1[i] != value2[i]) {
+      return value1[i] - value2[i];
+    }
+  }
+  return 0;
+}
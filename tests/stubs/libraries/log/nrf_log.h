@@ -0,0 +1,5 @@
+#pragma once
+
+#define NRF_LOG_INFO(...)
+#define NRF_LOG_WARNING(...)
+#define NRF_LOG_ERROR(...)
@@ -0,0 +1,33 @@
+#pragma once
+
+// Host stub of the littlefs types used by Controllers::FS, see components/fs/FS.h
+
+#include <cstdint>
+#include <string>
+
+#define LFS_ERR_OK     0
+#define LFS_ERR_IO     -5
+#define LFS_ERR_NOENT  -2
+#define LFS_ERR_EXIST  -17
+#define LFS_ERR_NOATTR -61
+#define LFS_O_RDONLY   1
+#define LFS_O_WRONLY   2
+#define LFS_O_RDWR     3
+#define LFS_O_CREAT    0x0100
+#define LFS_O_TRUNC    0x0400
+
+struct lfs_file_t {
+  std::string name;
+  uint32_t position = 0;
+};
+
+enum lfs_type {
+  LFS_TYPE_REG = 0x001,
+  LFS_TYPE_DIR = 0x002,
+};
+
+struct lfs_info {
+  uint8_t type;
+  uint32_t size;
+  char name[256];
+};
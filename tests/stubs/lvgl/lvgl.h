@@ -0,0 +1,43 @@
+#pragma once
+
+// Host stub of the parts of LVGL 7 used by the code under test: the font types (lv_font.h), the image decoders and their
+// file system, the geometry and the colors, see lvgl/src
+
+#include <cstdint>
+#include "lvgl/src/lv_draw/lv_img_decoder.h"
+#include "lvgl/src/lv_misc/lv_area.h"
+#include "lvgl/src/lv_misc/lv_color.h"
+#include "lvgl/src/lv_misc/lv_fs.h"
+#include "lvgl/src/lv_misc/lv_mem.h"
+#include "lvgl/src/lv_misc/lv_types.h"
+
+// Resolution of the display, as in lv_conf.h
+#define LV_HOR_RES_MAX 240
+#define LV_VER_RES_MAX 240
+
+enum {
+  LV_FONT_SUBPX_NONE,
+  LV_FONT_SUBPX_HOR,
+  LV_FONT_SUBPX_VER,
+  LV_FONT_SUBPX_BOTH,
+};
+
+typedef struct {
+  uint16_t adv_w;
+  uint16_t box_w;
+  uint16_t box_h;
+  int16_t ofs_x;
+  int16_t ofs_y;
+  uint8_t bpp;
+} lv_font_glyph_dsc_t;
+
+typedef struct _lv_font_struct {
+  bool (*get_glyph_dsc)(const struct _lv_font_struct*, lv_font_glyph_dsc_t*, uint32_t letter, uint32_t letter_next);
+  const uint8_t* (*get_glyph_bitmap)(const struct _lv_font_struct*, uint32_t);
+  lv_coord_t line_height;
+  lv_coord_t base_line;
+  uint8_t subpx : 2;
+  int8_t underline_position;
+  int8_t underline_thickness;
+  void* dsc;
+} lv_font_t;
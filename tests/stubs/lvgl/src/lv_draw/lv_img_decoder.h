@@ -0,0 +1,204 @@
+#pragma once
+
+// Host stub of the image decoders of LVGL 7 (lv_img_buf.h, lv_img_decoder.h). The decoders are called in the order of
+// lv_img_decoder_get_info() and lv_img_decoder_open(), the built-in decoder last. The built-in decoder only counts its calls,
+// and reads the header of the image files as LVGL does.
+
+#include <cstdint>
+#include <vector>
+#include "lvgl/src/lv_misc/lv_color.h"
+#include "lvgl/src/lv_misc/lv_fs.h"
+#include "lvgl/src/lv_misc/lv_types.h"
+
+enum {
+  LV_IMG_CF_UNKNOWN = 0,
+  LV_IMG_CF_RAW,
+  LV_IMG_CF_RAW_ALPHA,
+  LV_IMG_CF_RAW_CHROMA_KEYED,
+  LV_IMG_CF_TRUE_COLOR,
+  LV_IMG_CF_TRUE_COLOR_ALPHA,
+  LV_IMG_CF_TRUE_COLOR_CHROMA_KEYED,
+  LV_IMG_CF_INDEXED_1BIT,
+  LV_IMG_CF_INDEXED_2BIT,
+  LV_IMG_CF_INDEXED_4BIT,
+  LV_IMG_CF_INDEXED_8BIT,
+  LV_IMG_CF_ALPHA_1BIT,
+  LV_IMG_CF_ALPHA_2BIT,
+  LV_IMG_CF_ALPHA_4BIT,
+  LV_IMG_CF_ALPHA_8BIT,
+  LV_IMG_CF_USER_ENCODED_0 = 24,
+};
+typedef uint8_t lv_img_cf_t;
+
+#define LV_IMG_PX_SIZE_ALPHA_BYTE 3
+
+typedef struct {
+  uint32_t cf : 5;
+  uint32_t always_zero : 3;
+  uint32_t reserved : 2;
+  uint32_t w : 11;
+  uint32_t h : 11;
+} lv_img_header_t;
+
+typedef struct {
+  lv_img_header_t header;
+  uint32_t data_size;
+  const uint8_t* data;
+} lv_img_dsc_t;
+
+enum {
+  LV_IMG_SRC_VARIABLE,
+  LV_IMG_SRC_FILE,
+  LV_IMG_SRC_SYMBOL,
+  LV_IMG_SRC_UNKNOWN,
+};
+typedef uint8_t lv_img_src_t;
+
+inline lv_img_src_t lv_img_src_get_type(const void* src) {
+  const uint8_t first = *static_cast<const uint8_t*>(src);
+  if (first >= 0x20 && first <= 0x7F) {
+    return LV_IMG_SRC_FILE;
+  }
+  if (first >= 0x80) {
+    return LV_IMG_SRC_SYMBOL;
+  }
+  return LV_IMG_SRC_VARIABLE;
+}
+
+struct _lv_img_decoder;
+struct _lv_img_decoder_dsc;
+
+typedef lv_res_t (*lv_img_decoder_info_f_t)(struct _lv_img_decoder* decoder, const void* src, lv_img_header_t* header);
+typedef lv_res_t (*lv_img_decoder_open_f_t)(struct _lv_img_decoder* decoder, struct _lv_img_decoder_dsc* dsc);
+typedef lv_res_t (*lv_img_decoder_read_line_f_t)(
+  struct _lv_img_decoder* decoder, struct _lv_img_decoder_dsc* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf);
+typedef void (*lv_img_decoder_close_f_t)(struct _lv_img_decoder* decoder, struct _lv_img_decoder_dsc* dsc);
+
+typedef struct _lv_img_decoder {
+  lv_img_decoder_info_f_t info_cb;
+  lv_img_decoder_open_f_t open_cb;
+  lv_img_decoder_read_line_f_t read_line_cb;
+  lv_img_decoder_close_f_t close_cb;
+} lv_img_decoder_t;
+
+typedef struct _lv_img_decoder_dsc {
+  lv_img_decoder_t* decoder;
+  const void* src;
+  lv_img_src_t src_type;
+  lv_img_header_t header;
+  const uint8_t* img_data;
+  void* user_data;
+} lv_img_decoder_dsc_t;
+
+struct LvImgBuiltInCalls {
+  uint32_t info = 0;
+  uint32_t open = 0;
+  uint32_t readLine = 0;
+  uint32_t close = 0;
+};
+inline LvImgBuiltInCalls lvImgBuiltInCalls;
+// The decoders registered with lv_img_decoder_create(), the last one first as in LVGL
+inline std::vector<lv_img_decoder_t*> lvImgDecoders;
+
+inline lv_res_t lv_img_decoder_built_in_info(lv_img_decoder_t* /*decoder*/, const void* src, lv_img_header_t* header) {
+  lvImgBuiltInCalls.info++;
+  switch (lv_img_src_get_type(src)) {
+    case LV_IMG_SRC_VARIABLE:
+      *header = static_cast<const lv_img_dsc_t*>(src)->header;
+      return header->cf >= LV_IMG_CF_TRUE_COLOR && header->cf <= LV_IMG_CF_ALPHA_8BIT ? LV_RES_OK : LV_RES_INV;
+    case LV_IMG_SRC_FILE: {
+      lv_fs_file_t file;
+      if (lv_fs_open(&file, static_cast<const char*>(src), LV_FS_MODE_RD) != LV_FS_RES_OK) {
+        return LV_RES_INV;
+      }
+      uint32_t read = 0;
+      lv_fs_read(&file, header, sizeof(*header), &read);
+      lv_fs_close(&file);
+      return read == sizeof(*header) ? LV_RES_OK : LV_RES_INV;
+    }
+    default:
+      return LV_RES_INV;
+  }
+}
+
+inline lv_res_t lv_img_decoder_built_in_open(lv_img_decoder_t* /*decoder*/, lv_img_decoder_dsc_t* /*dsc*/) {
+  lvImgBuiltInCalls.open++;
+  return LV_RES_OK;
+}
+
+inline lv_res_t lv_img_decoder_built_in_read_line(
+  lv_img_decoder_t* /*decoder*/, lv_img_decoder_dsc_t* /*dsc*/, lv_coord_t /*x*/, lv_coord_t /*y*/, lv_coord_t /*len*/, uint8_t* /*buf*/) {
+  lvImgBuiltInCalls.readLine++;
+  return LV_RES_OK;
+}
+
+inline void lv_img_decoder_built_in_close(lv_img_decoder_t* /*decoder*/, lv_img_decoder_dsc_t* /*dsc*/) {
+  lvImgBuiltInCalls.close++;
+}
+
+inline lv_img_decoder_t* lv_img_decoder_create() {
+  auto* decoder = new lv_img_decoder_t {};
+  lvImgDecoders.insert(lvImgDecoders.begin(), decoder);
+  return decoder;
+}
+
+inline void lv_img_decoder_set_info_cb(lv_img_decoder_t* decoder, lv_img_decoder_info_f_t info_cb) {
+  decoder->info_cb = info_cb;
+}
+
+inline void lv_img_decoder_set_open_cb(lv_img_decoder_t* decoder, lv_img_decoder_open_f_t open_cb) {
+  decoder->open_cb = open_cb;
+}
+
+inline void lv_img_decoder_set_read_line_cb(lv_img_decoder_t* decoder, lv_img_decoder_read_line_f_t read_line_cb) {
+  decoder->read_line_cb = read_line_cb;
+}
+
+inline void lv_img_decoder_set_close_cb(lv_img_decoder_t* decoder, lv_img_decoder_close_f_t close_cb) {
+  decoder->close_cb = close_cb;
+}
+
+// The built-in decoder, as the last decoder of the list
+inline lv_img_decoder_t lvImgBuiltInDecoder {lv_img_decoder_built_in_info,
+                                             lv_img_decoder_built_in_open,
+                                             lv_img_decoder_built_in_read_line,
+                                             lv_img_decoder_built_in_close};
+
+inline lv_res_t lv_img_decoder_get_info(const void* src, lv_img_header_t* header) {
+  for (lv_img_decoder_t* decoder : lvImgDecoders) {
+    if (decoder->info_cb(decoder, src, header) == LV_RES_OK) {
+      return LV_RES_OK;
+    }
+  }
+  return lv_img_decoder_built_in_info(&lvImgBuiltInDecoder, src, header);
+}
+
+inline lv_res_t lv_img_decoder_open(lv_img_decoder_dsc_t* dsc, const void* src) {
+  *dsc = {};
+  dsc->src = src;
+  dsc->src_type = lv_img_src_get_type(src);
+  std::vector<lv_img_decoder_t*> decoders = lvImgDecoders;
+  decoders.push_back(&lvImgBuiltInDecoder);
+  for (lv_img_decoder_t* decoder : decoders) {
+    if (decoder->info_cb(decoder, src, &dsc->header) != LV_RES_OK) {
+      continue;
+    }
+    dsc->decoder = decoder;
+    if (decoder->open_cb(decoder, dsc) == LV_RES_OK) {
+      return LV_RES_OK;
+    }
+    dsc->header = {};
+  }
+  dsc->decoder = nullptr;
+  return LV_RES_INV;
+}
+
+inline lv_res_t lv_img_decoder_read_line(lv_img_decoder_dsc_t* dsc, lv_coord_t x, lv_coord_t y, lv_coord_t len, uint8_t* buf) {
+  return dsc->decoder->read_line_cb(dsc->decoder, dsc, x, y, len, buf);
+}
+
+inline void lv_img_decoder_close(lv_img_decoder_dsc_t* dsc) {
+  if (dsc->decoder != nullptr) {
+    dsc->decoder->close_cb(dsc->decoder, dsc);
+  }
+}
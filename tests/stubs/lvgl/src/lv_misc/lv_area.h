@@ -0,0 +1,17 @@
+#pragma once
+
+// Host stub of the geometry of LVGL 7 (lv_area.h)
+
+#include "lvgl/src/lv_misc/lv_types.h"
+
+typedef struct {
+  lv_coord_t x;
+  lv_coord_t y;
+} lv_point_t;
+
+typedef struct {
+  lv_coord_t x1;
+  lv_coord_t y1;
+  lv_coord_t x2;
+  lv_coord_t y2;
+} lv_area_t;
@@ -0,0 +1,36 @@
+#pragma once
+
+// Host stub of the colors of LVGL 7 (lv_color.h), with LV_COLOR_DEPTH 16 and LV_COLOR_16_SWAP as in lv_conf.h
+
+#include <cstdint>
+
+typedef uint8_t lv_opa_t;
+
+typedef union {
+  struct {
+    uint16_t green_h : 3;
+    uint16_t red : 5;
+    uint16_t blue : 5;
+    uint16_t green_l : 3;
+  } ch;
+  uint16_t full;
+} lv_color_t;
+
+typedef union {
+  struct {
+    uint8_t blue;
+    uint8_t green;
+    uint8_t red;
+    uint8_t alpha;
+  } ch;
+  uint32_t full;
+} lv_color32_t;
+
+inline lv_color_t lv_color_make(uint8_t r, uint8_t g, uint8_t b) {
+  lv_color_t color;
+  color.ch.red = r >> 3;
+  color.ch.green_h = g >> 5;
+  color.ch.green_l = (g >> 2) & 0x7;
+  color.ch.blue = b >> 3;
+  return color;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+// Host stub of the file system interface of LVGL 7 (lv_fs.h): the files are kept in memory, under their full path ("F:/...")
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <map>
+#include <string>
+#include <vector>
+
+enum {
+  LV_FS_RES_OK = 0,
+  LV_FS_RES_HW_ERR,
+  LV_FS_RES_FS_ERR,
+  LV_FS_RES_NOT_EX,
+};
+typedef uint8_t lv_fs_res_t;
+
+enum {
+  LV_FS_MODE_WR = 0x01,
+  LV_FS_MODE_RD = 0x02,
+};
+typedef uint8_t lv_fs_mode_t;
+
+typedef struct {
+  const std::vector<uint8_t>* content;
+  uint32_t position;
+} lv_fs_file_t;
+
+inline std::map<std::string, std::vector<uint8_t>> lvFsFiles;
+// Calls to lv_fs_open(), and files currently open
+inline uint32_t lvFsOpens = 0;
+inline uint32_t lvFsOpenFiles = 0;
+
+inline lv_fs_res_t lv_fs_open(lv_fs_file_t* file, const char* path, lv_fs_mode_t /*mode*/) {
+  lvFsOpens++;
+  auto it = lvFsFiles.find(path);
+  if (it == lvFsFiles.end()) {
+    return LV_FS_RES_NOT_EX;
+  }
+  file->content = &it->second;
+  file->position = 0;
+  lvFsOpenFiles++;
+  return LV_FS_RES_OK;
+}
+
+inline lv_fs_res_t lv_fs_close(lv_fs_file_t* /*file*/) {
+  lvFsOpenFiles--;
+  return LV_FS_RES_OK;
+}
+
+inline lv_fs_res_t lv_fs_read(lv_fs_file_t* file, void* buffer, uint32_t count, uint32_t* read) {
+  const uint32_t size = static_cast<uint32_t>(file->content->size());
+  *read = (file->position < size) ? std::min(count, size - file->position) : 0;
+  std::memcpy(buffer, file->content->data() + file->position, *read);
+  file->position += *read;
+  return LV_FS_RES_OK;
+}
+
+inline lv_fs_res_t lv_fs_seek(lv_fs_file_t* file, uint32_t position) {
+  file->position = position;
+  return LV_FS_RES_OK;
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+// Host stub of the memory allocator of LVGL 7 (lv_mem.h): the heap of the host, with a count of the blocks in use
+
+#include <cstdint>
+#include <cstdlib>
+
+inline uint32_t lvMemBlocks = 0;
+
+inline void* lv_mem_alloc(size_t size) {
+  void* data = std::malloc(size);
+  if (data != nullptr) {
+    lvMemBlocks++;
+  }
+  return data;
+}
+
+inline void lv_mem_free(const void* data) {
+  if (data != nullptr) {
+    lvMemBlocks--;
+    std::free(const_cast<void*>(data));
+  }
+}
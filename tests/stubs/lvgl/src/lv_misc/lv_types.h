@@ -0,0 +1,13 @@
+#pragma once
+
+// Host stub of the common types of LVGL 7 (lv_types.h)
+
+#include <cstdint>
+
+enum {
+  LV_RES_INV = 0,
+  LV_RES_OK,
+};
+typedef uint8_t lv_res_t;
+
+typedef int16_t lv_coord_t;
@@ -0,0 +1,19 @@
+#pragma once
+
+// Host stub of System::SystemTask: the messages are recorded instead of being sent to the task
+
+#include <vector>
+#include "systemtask/Messages.h"
+
+namespace Pinetime {
+  namespace System {
+    class SystemTask {
+    public:
+      void PushMessage(Messages message) {
+        messages.push_back(message);
+      }
+
+      std::vector<Messages> messages;
+    };
+  }
+}
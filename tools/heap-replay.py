@@ -0,0 +1,163 @@
+#!/usr/bin/env python3
+
+# Replays an allocation trace of the FreeRTOS heap against a model of
+# heap_4_infinitime.c, to find out whether a sequence of allocations that
+# failed on the watch would fit with another heap size, and how fragmented
+# the heap is at the end of the trace.
+#
+# The trace is printed to the log by the debug builds made with
+# -DENABLE_HEAP_PROFILER=ON (lines "heap+ <address> <size> <tag>" and
+# "heap- <address> <size>", see FreeRTOS/heap_infinitime.h). The log can be
+# captured with JLinkRTTLogger or any RTT client; the other lines are ignored.
+# The logger drops messages when its buffer is full: the events that don't
+# match the replayed heap are counted as lost.
+
+import argparse
+import importlib.util
+import os
+import re
+import sys
+
+# Constants of heap_4_infinitime.c on the nRF52 (32-bit BlockLink_t)
+HEAP_STRUCT_SIZE = 8
+ALIGNMENT = 8
+MINIMUM_BLOCK_SIZE = HEAP_STRUCT_SIZE * 2
+
+EVENT = re.compile(r'heap([+-]) 0x([0-9a-fA-F]+) (\d+)(?: (\d+))?')
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..')
+
+
+def load_snapshot_module():
+    spec = importlib.util.spec_from_file_location(
+        'heap_snapshot', os.path.join(os.path.dirname(os.path.abspath(__file__)), 'heap-snapshot.py'))
+    module = importlib.util.module_from_spec(spec)
+    spec.loader.exec_module(module)
+    return module
+
+
+def default_heap_size():
+    with open(os.path.join(ROOT, 'src', 'FreeRTOSConfig.h')) as f:
+        match = re.search(r'#define\s+configTOTAL_HEAP_SIZE\s+\((\d+)\s*\*\s*(\d+)\)', f.read())
+    return int(match.group(1)) * int(match.group(2))
+
+
+class Heap:
+    """First fit over a free list ordered by address, as pvPortMalloc() and vPortFree()"""
+
+    def __init__(self, size):
+        end = (size - HEAP_STRUCT_SIZE) & ~(ALIGNMENT - 1)
+        # [address, size] of the free blocks, by address
+        self.free = [[0, end]]
+        self.free_bytes = end
+        self.minimum_free = end
+
+    def malloc(self, block_size):
+        if block_size == 0 or block_size > self.free_bytes:
+            return None
+        for i, (address, size) in enumerate(self.free):
+            if size >= block_size:
+                if size - block_size > MINIMUM_BLOCK_SIZE:
+                    self.free[i] = [address + block_size, size - block_size]
+                else:
+                    block_size = size
+                    del self.free[i]
+                self.free_bytes -= block_size
+                self.minimum_free = min(self.minimum_free, self.free_bytes)
+                return address, block_size
+        return None
+
+    def release(self, address, size):
+        self.free_bytes += size
+        i = 0
+        while i < len(self.free) and self.free[i][0] < address:
+            i += 1
+        self.free.insert(i, [address, size])
+        if i + 1 < len(self.free) and address + size == self.free[i + 1][0]:
+            self.free[i][1] += self.free[i + 1][1]
+            del self.free[i + 1]
+        if i > 0 and self.free[i - 1][0] + self.free[i - 1][1] == address:
+            self.free[i - 1][1] += self.free[i][1]
+            del self.free[i]
+
+    def free_block_histogram(self, buckets):
+        histogram = [0] * buckets
+        for _, size in self.free:
+            bucket = 0
+            while bucket < buckets - 1 and size >= 32 << bucket:
+                bucket += 1
+            histogram[bucket] += 1
+        return histogram
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Replay an allocation trace of the InfiniTime heap')
+    parser.add_argument('trace', help='log captured from a -DENABLE_HEAP_PROFILER=ON debug build')
+    parser.add_argument('--heap-size', type=int, help='configTOTAL_HEAP_SIZE (default: value of src/FreeRTOSConfig.h)')
+    parser.add_argument('--apps', help='src/displayapp/apps/Apps.h, to print the names of the apps')
+    args = parser.parse_args()
+
+    snapshot_module = load_snapshot_module()
+    apps = snapshot_module.read_apps(args.apps) if args.apps else []
+    heap = Heap(args.heap_size or default_heap_size())
+
+    # Blocks of the trace still allocated: address on the watch -> (address, size, tag) in the replayed heap
+    live = {}
+    tags = {}
+    events = lost = 0
+    with open(args.trace, errors='replace') as f:
+        for number, line in enumerate(f, 1):
+            match = EVENT.search(line)
+            if not match:
+                continue
+            events += 1
+            address = int(match.group(2), 16)
+            size = int(match.group(3))
+            if match.group(1) == '-':
+                if address not in live:
+                    lost += 1
+                    continue
+                block, block_size, tag = live.pop(address)
+                heap.release(block, block_size)
+                tags[tag][1] -= 1
+                tags[tag][2] -= block_size
+                continue
+
+            tag = int(match.group(4) or 0)
+            result = heap.malloc(size)
+            if address == 0:
+                # Failed on the watch: nothing will free it
+                print('line %d: %d bytes for %s failed on the watch, %s in the replay'
+                      % (number, size, snapshot_module.tag_name(tag, apps), 'fails' if result is None else 'fits'))
+                if result is not None:
+                    heap.release(*result)
+                continue
+            if address in live:
+                # The event that freed this block was lost
+                lost += 1
+                heap.release(*live.pop(address)[:2])
+            if result is None:
+                print('line %d: %d bytes for %s fail in the replay (%d bytes free, largest free block %d bytes)'
+                      % (number, size, snapshot_module.tag_name(tag, apps), heap.free_bytes,
+                         max((s for _, s in heap.free), default=0)))
+                continue
+            live[address] = (result[0], result[1], tag)
+            stats = tags.setdefault(tag, [tag, 0, 0, 0])
+            stats[1] += 1
+            stats[2] += result[1]
+            stats[3] = max(stats[3], stats[2])
+
+    print('%d events replayed, %d lost' % (events, lost))
+    print()
+    snapshot_module.print_snapshot({
+        'free': heap.free_bytes,
+        'minimum_free': heap.minimum_free,
+        'largest_free_block': max((s for _, s in heap.free), default=0),
+        'free_blocks': heap.free_block_histogram(snapshot_module.BUCKETS),
+        'tags': [tuple(t) for t in tags.values()],
+    }, apps)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,107 @@
+#!/usr/bin/env python3
+
+# Decodes the heap snapshot and the last heap failure read from the system
+# stats service (see doc/SystemStatsService.md), or the /heapfail.bin file
+# saved by the firmware when it is built with -DENABLE_HEAP_PROFILER=ON.
+
+import argparse
+import struct
+import sys
+
+BUCKETS = 12
+SNAPSHOT_HEADER = struct.Struct('<III%dHI' % BUCKETS)
+FAILURE_HEADER = struct.Struct('<III')
+TAG = struct.Struct('<BBHII')
+
+APP_BASE = 64
+OTHERS = 0xff
+
+
+def tag_name(tag, apps):
+    if tag == 0:
+        return 'startup'
+    if tag == OTHERS:
+        return 'others'
+    if tag >= APP_BASE:
+        app = tag - APP_BASE
+        return 'app %s' % (apps[app] if app < len(apps) else app)
+    return 'task %d' % tag
+
+
+def read_apps(path):
+    with open(path) as f:
+        text = f.read()
+    body = text[text.index('enum class Apps'):]
+    body = body[body.index('{') + 1:body.index('}')]
+    return [a.split('=')[0].strip() for a in body.split(',') if a.strip()]
+
+
+def decode_snapshot(data):
+    if len(data) < SNAPSHOT_HEADER.size:
+        raise ValueError('snapshot too short (%d bytes)' % len(data))
+    fields = SNAPSHOT_HEADER.unpack_from(data)
+    snapshot = {
+        'free': fields[0],
+        'minimum_free': fields[1],
+        'largest_free_block': fields[2],
+        'free_blocks': fields[3:3 + BUCKETS],
+        'tags': [],
+    }
+    nb_tags = fields[3 + BUCKETS]
+    offset = SNAPSHOT_HEADER.size
+    if len(data) < offset + nb_tags * TAG.size:
+        raise ValueError('snapshot truncated: %d tags expected' % nb_tags)
+    for i in range(nb_tags):
+        tag, _, blocks, live, peak = TAG.unpack_from(data, offset + i * TAG.size)
+        snapshot['tags'].append((tag, blocks, live, peak))
+    return snapshot
+
+
+def print_snapshot(snapshot, apps):
+    print('Free: %d bytes (minimum ever: %d), largest free block: %d bytes'
+          % (snapshot['free'], snapshot['minimum_free'], snapshot['largest_free_block']))
+    print()
+    print('Free blocks:')
+    for i, count in enumerate(snapshot['free_blocks']):
+        low = 16 << i
+        high = '' if i == BUCKETS - 1 else '%d' % ((16 << (i + 1)) - 1)
+        print('  %6d - %-6s %4d %s' % (low, high, count, '#' * min(count, 60)))
+    if snapshot['tags']:
+        print()
+        print('%-24s %8s %10s %10s' % ('Tag', 'Blocks', 'Live', 'Peak'))
+        for tag, blocks, live, peak in sorted(snapshot['tags'], key=lambda t: -t[3]):
+            print('%-24s %8d %10d %10d' % (tag_name(tag, apps), blocks, live, peak))
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Decode the heap statistics of InfiniTime')
+    parser.add_argument('file', help='raw value of the characteristic, or /heapfail.bin')
+    parser.add_argument('--failure', action='store_true',
+                        help='the file holds the last heap failure (00060004 or /heapfail.bin)')
+    parser.add_argument('--apps', help='src/displayapp/apps/Apps.h, to print the names of the apps')
+    args = parser.parse_args()
+
+    apps = read_apps(args.apps) if args.apps else []
+
+    with open(args.file, 'rb') as f:
+        data = f.read()
+
+    try:
+        if args.failure:
+            failures, size, tag = FAILURE_HEADER.unpack_from(data)
+            if failures == 0:
+                print('No failed allocation')
+                return 0
+            print('%d failed allocations, last one: %d bytes requested by %s'
+                  % (failures, size, tag_name(tag, apps)))
+            print()
+            data = data[FAILURE_HEADER.size:]
+        print_snapshot(decode_snapshot(data), apps)
+    except (ValueError, struct.error) as e:
+        print('Invalid data: %s' % e, file=sys.stderr)
+        return 1
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())